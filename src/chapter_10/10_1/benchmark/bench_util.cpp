@@ -0,0 +1,225 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 10:12:31
+# Desc   :
+########################################################################
+*/
+
+#include "bench_util.h"
+
+#include <malloc.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <new>
+#include <string_view>
+
+namespace {
+std::atomic<size_t> g_allocation_count{0};
+std::atomic<size_t> g_allocation_bytes{0};
+std::atomic<size_t> g_live_bytes{0};
+std::atomic<size_t> g_peak_bytes{0};
+
+void* countedAlloc(size_t size, size_t align) {
+  g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+  g_allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+  if (size == 0) {
+    size = 1;
+  }
+  void* p = align <= alignof(std::max_align_t)
+      ? std::malloc(size)
+      : std::aligned_alloc(align, (size + align - 1) / align * align);
+  if (p == nullptr) {
+    throw std::bad_alloc{};
+  }
+  size_t live = g_live_bytes.fetch_add(malloc_usable_size(p), std::memory_order_relaxed)
+      + malloc_usable_size(p);
+  size_t peak = g_peak_bytes.load(std::memory_order_relaxed);
+  while (live > peak && !g_peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+  }
+  return p;
+}
+
+void countedFree(void* p) {
+  if (p != nullptr) {
+    g_live_bytes.fetch_sub(malloc_usable_size(p), std::memory_order_relaxed);
+    std::free(p);
+  }
+}
+}  // namespace
+
+void* operator new(size_t size) {
+  return countedAlloc(size, alignof(std::max_align_t));
+}
+void* operator new(size_t size, std::align_val_t align) {
+  return countedAlloc(size, static_cast<size_t>(align));
+}
+void operator delete(void* p) noexcept {
+  countedFree(p);
+}
+void operator delete(void* p, size_t) noexcept {
+  countedFree(p);
+}
+void operator delete(void* p, std::align_val_t) noexcept {
+  countedFree(p);
+}
+void operator delete(void* p, size_t, std::align_val_t) noexcept {
+  countedFree(p);
+}
+
+namespace bench {
+
+size_t allocationCount() {
+  return g_allocation_count.load(std::memory_order_relaxed);
+}
+size_t allocationBytes() {
+  return g_allocation_bytes.load(std::memory_order_relaxed);
+}
+size_t liveBytes() {
+  return g_live_bytes.load(std::memory_order_relaxed);
+}
+size_t resetPeakBytes() {
+  size_t live = liveBytes();
+  g_peak_bytes.store(live, std::memory_order_relaxed);
+  return live;
+}
+size_t peakBytes() {
+  return g_peak_bytes.load(std::memory_order_relaxed);
+}
+
+size_t peakRssBytes() {
+  std::ifstream status{"/proc/self/status"};
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.starts_with("VmHWM:")) {
+      return std::stoull(line.substr(6)) * 1024;  // 单位为 kB
+    }
+  }
+  return 0;
+}
+bool resetPeakRss() {
+  std::ofstream clear_refs{"/proc/self/clear_refs"};
+  clear_refs << "5";
+  return static_cast<bool>(clear_refs.flush());
+}
+
+namespace {
+void appendTestTree(std::string& out, size_t depth, size_t fanout, size_t& id) {
+  out += R"({"name": "node_)";
+  out += std::to_string(id++);
+  out += '"';
+  if (depth > 1) {
+    out += R"(, "children": [)";
+    for (size_t i = 0; i < fanout; ++i) {
+      if (i != 0) {
+        out += ", ";
+      }
+      appendTestTree(out, depth - 1, fanout, id);
+    }
+    out += ']';
+  }
+  out += '}';
+}
+}  // namespace
+
+std::string makeTestTreeJSON(size_t depth, size_t fanout) {
+  std::string out;
+  size_t id{0};
+  appendTestTree(out, depth, fanout, id);
+  return out;
+}
+
+std::string makePointsJSON(size_t n) {
+  std::string out{"["};
+  for (size_t i = 0; i < n; ++i) {
+    if (i != 0) {
+      out += ",\n";
+    }
+    out += R"({"x": )";
+    out += std::to_string(i);
+    out += R"(, "y": ")";
+    out += std::to_string(i * 2);
+    out += R"(", "other": )";
+    out += std::to_string(static_cast<double>(i) + 0.5);
+    out += '}';
+  }
+  out += ']';
+  return out;
+}
+
+std::string makePointsYAML(size_t n) {
+  std::string out;
+  for (size_t i = 0; i < n; ++i) {
+    out += "- x: ";
+    out += std::to_string(i);
+    out += "\n  y: \"";
+    out += std::to_string(i * 2);
+    out += "\"\n  other: ";
+    out += std::to_string(static_cast<double>(i) + 0.5);
+    out += '\n';
+  }
+  return out;
+}
+
+std::string makePointsXML(size_t n) {
+  std::string out = "<points>\n";
+  for (size_t i = 0; i < n; ++i) {
+    out += "  <point x=\"";
+    out += std::to_string(i);
+    out += "\" y=\"";
+    out += std::to_string(i * 2);
+    out += "\"><other>";
+    out += std::to_string(static_cast<double>(i) + 0.5);
+    out += "</other></point>\n";
+  }
+  out += "</points>\n";
+  return out;
+}
+
+
+std::string makeInstancesJSON(size_t n) {
+  static constexpr std::string_view kRegions[] = {
+    "ap-southeast-1", "eu-central-1", "us-east-1", "us-west-2", "cn-north-1", "sa-east-1"};
+  static constexpr std::string_view kEnvs[] = {"production", "staging", "canary"};
+  static constexpr size_t kServices = 40;
+  static constexpr size_t kTeams = 12;
+  static constexpr size_t kTags = 16;
+  std::string out{"["};
+  for (size_t i = 0; i < n; ++i) {
+    if (i != 0) {
+      out += ",\n";
+    }
+    out += R"({"name": "instance-)";
+    out += std::to_string(i);
+    out += R"(", "service": "recommendation-service-)";
+    out += std::to_string(i % kServices);
+    out += R"(", "region": ")";
+    out += kRegions[i % std::size(kRegions)];
+    out += R"(", "env": ")";
+    out += kEnvs[i % std::size(kEnvs)];
+    out += R"(", "owner": "team-platform-infrastructure-)";
+    out += std::to_string(i % kTeams);
+    out += R"(", "tags": [)";
+    for (size_t t = 0; t < 3; ++t) {
+      if (t != 0) {
+        out += ", ";
+      }
+      out += R"("feature-flag-enabled-)";
+      out += std::to_string((i + t * 5) % kTags);
+      out += '"';
+    }
+    out += "]}";
+  }
+  out += ']';
+  return out;
+}
+
+}  // namespace bench
@@ -0,0 +1,73 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 10:12:31
+# Desc   : config_loader benchmark 公用工具: 内存分配计数、RSS 峰值、测试数据生成
+########################################################################
+*/
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace bench {
+
+// 进程启动以来 operator new 的调用次数和字节数(bench_util.cpp 中替换了全局 operator new)
+size_t allocationCount();
+size_t allocationBytes();
+
+// 当前仍未释放的堆内存字节数
+size_t liveBytes();
+// 把峰值重置为当前值, 返回重置后的峰值
+size_t resetPeakBytes();
+size_t peakBytes();
+
+// 统计一段代码内的内存分配
+class AllocationScope {
+public:
+  AllocationScope() : count_(allocationCount()), bytes_(allocationBytes()) {}
+  size_t count() const { return allocationCount() - count_; }
+  size_t bytes() const { return allocationBytes() - bytes_; }
+private:
+  size_t count_;
+  size_t bytes_;
+};  // class AllocationScope
+
+// 统计一段代码内堆内存的峰值(相对进入时的增量), 不是线程安全的
+class PeakMemoryScope {
+public:
+  PeakMemoryScope() : base_(resetPeakBytes()) {}
+  size_t peak() const { return peakBytes() - base_; }
+private:
+  size_t base_;
+};  // class PeakMemoryScope
+
+// 进程常驻内存(RSS)的峰值, 单位字节, 读取 /proc/self/status 的 VmHWM, 非 linux 返回 0
+size_t peakRssBytes();
+// 把 RSS 峰值重置为当前 RSS(写 /proc/self/clear_refs), 返回是否成功
+bool resetPeakRss();
+
+// 生成 TestTree 格式的 json: 每个节点有 fanout 个子节点, 共 depth 层
+// 深树: makeTestTreeJSON(n, 1), 宽树: makeTestTreeJSON(2, n)
+std::string makeTestTreeJSON(size_t depth, size_t fanout);
+
+// 生成 n 个 Point 组成的 json 数组, 每个元素的格式同 conf/point.json
+std::string makePointsJSON(size_t n);
+
+// 与 makePointsJSON(n) 内容相同的 YAML 块序列
+std::string makePointsYAML(size_t n);
+
+// 与 makePointsJSON(n) 内容相同的 XML: <points><point x=".." y=".."><other>..</other></point>...</points>
+std::string makePointsXML(size_t n);
+
+// 生成 n 个服务实例组成的 json 数组, 除 name 外的字符串(服务名、地域、环境、负责团队、标签)都取自很少的几种值:
+// {"name": "instance-0", "service": "recommendation-service-0", "region": "ap-southeast-1", "env": "production",
+//  "owner": "team-platform-infrastructure-0", "tags": ["feature-flag-enabled-0", ...]}
+std::string makeInstancesJSON(size_t n);
+
+}  // namespace bench
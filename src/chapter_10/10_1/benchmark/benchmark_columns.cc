@@ -0,0 +1,117 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/16 00:47:11
+# Desc   : std::vector<Point>(AoS) 与 Columns<Point>(SoA) 的加载时间, 以及对单个字段求和的耗时
+########################################################################
+*/
+
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "bench_util.h"
+#include "config_loader/columns.h"
+#include "config_loader/loader.h"
+#include "schema.h"
+
+namespace {
+
+constexpr size_t kPointCount = 1'000'000;
+
+const std::string& pointsJSON() {
+  static const std::string json = bench::makePointsJSON(kPointCount);
+  return json;
+}
+
+// 目标对象在迭代之间复用, 与重新加载配置的场景相同
+template <typename P, typename T>
+void runLoad(benchmark::State& state) {
+  const auto& json = pointsJSON();
+  T points;
+  for (auto _ : state) {
+    if (loadJSON2Obj<P>(points, [&json] { return std::string_view(json); }) != Result::SUCCESS) {
+      state.SkipWithError("load failed");
+      return;
+    }
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kPointCount));
+}
+
+template <typename T>
+T loadPoints() {
+  T points;
+  loadJSON2Obj<detail::JsonTapeParser>(points, [] { return std::string_view(pointsJSON()); });
+  return points;
+}
+
+}  // namespace
+
+static void BM_load_aos_tape(benchmark::State& state) {
+  runLoad<detail::JsonTapeParser, std::vector<Point>>(state);
+}
+BENCHMARK(BM_load_aos_tape)->Unit(benchmark::kMillisecond);
+
+static void BM_load_soa_tape(benchmark::State& state) {
+  runLoad<detail::JsonTapeParser, Columns<Point>>(state);
+}
+BENCHMARK(BM_load_soa_tape)->Unit(benchmark::kMillisecond);
+
+static void BM_load_aos_pull(benchmark::State& state) {
+  runLoad<detail::JsonPullParser, std::vector<Point>>(state);
+}
+BENCHMARK(BM_load_aos_pull)->Unit(benchmark::kMillisecond);
+
+static void BM_load_soa_pull(benchmark::State& state) {
+  runLoad<detail::JsonPullParser, Columns<Point>>(state);
+}
+BENCHMARK(BM_load_soa_pull)->Unit(benchmark::kMillisecond);
+
+// 每读一个 x 都要跨过整个 Point(包括 optional 和 variant), 缓存行中大部分字节用不上
+static void BM_sum_x_aos(benchmark::State& state) {
+  const auto points = loadPoints<std::vector<Point>>();
+  for (auto _ : state) {
+    double sum{0};
+    for (const auto& point : points) {
+      sum += point.x;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * points.size() * sizeof(Point)));
+}
+BENCHMARK(BM_sum_x_aos)->Unit(benchmark::kMicrosecond);
+
+// 连续的 double 数组, 编译器可以向量化
+static void BM_sum_x_soa(benchmark::State& state) {
+  const auto points = loadPoints<Columns<Point>>();
+  for (auto _ : state) {
+    auto xs = points.column<"x">();
+    benchmark::DoNotOptimize(std::reduce(xs.begin(), xs.end()));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * points.size() * sizeof(double)));
+}
+BENCHMARK(BM_sum_x_soa)->Unit(benchmark::kMicrosecond);
+
+// 按行访问: 与 AoS 的写法相同, 每次经过行代理
+static void BM_sum_x_soa_rows(benchmark::State& state) {
+  const auto points = loadPoints<Columns<Point>>();
+  for (auto _ : state) {
+    double sum{0};
+    for (auto row : points) {
+      sum += row.get<"x">();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * points.size() * sizeof(double)));
+}
+BENCHMARK(BM_sum_x_soa_rows)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
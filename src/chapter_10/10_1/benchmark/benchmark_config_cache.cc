@@ -0,0 +1,86 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/16 00:35:33
+# Desc   : 重复加载同一个文件: 每次解析与命中进程内缓存的对比
+########################################################################
+*/
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+#include "bench_util.h"
+#include "config_loader/config_cache.h"
+#include "schema.h"
+
+namespace {
+
+// 每个节点 8 个子节点, 共 5 层; 进程退出时删除
+struct TempFile {
+  std::filesystem::path path = std::filesystem::temp_directory_path() / "config_loader_cache_tree.json";
+  TempFile() {
+    std::ofstream{path} << bench::makeTestTreeJSON(5, 8);
+  }
+  ~TempFile() {
+    std::filesystem::remove(path);
+  }
+};  // struct TempFile
+
+const std::string& treePath() {
+  static TempFile file;
+  static const std::string path = file.path.string();
+  return path;
+}
+
+void setCounters(benchmark::State& state) {
+  const auto stats = configCacheStats();
+  state.counters["hits"] = static_cast<double>(stats.hits);
+  state.counters["misses"] = static_cast<double>(stats.misses);
+}
+
+}  // namespace
+
+// 各个子系统各自调用 loadJSON2Obj, 每次都重新解析
+template <typename P>
+static void BM_repeated_load(benchmark::State& state) {
+  const auto& path = treePath();
+  for (auto _ : state) {
+    auto tree = std::make_shared<TestTree>();
+    if (loadJSON2Obj<P>(*tree, path) != Result::SUCCESS) {
+      state.SkipWithError("load failed");
+      return;
+    }
+    benchmark::DoNotOptimize(tree);
+  }
+}
+BENCHMARK(BM_repeated_load<detail::JsonCppParser>)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_repeated_load<detail::JsonPullParser>)->Unit(benchmark::kMicrosecond);
+
+// 第一次未命中时解析, 之后每次只有一次 stat() 和一次哈希表查找
+template <typename P>
+static void BM_repeated_load_cached(benchmark::State& state) {
+  const auto& path = treePath();
+  clearConfigCache();
+  for (auto _ : state) {
+    std::shared_ptr<const TestTree> tree;
+    if (loadJSON2ObjCached<P>(tree, path) != Result::SUCCESS) {
+      state.SkipWithError("load failed");
+      return;
+    }
+    benchmark::DoNotOptimize(tree);
+  }
+  setCounters(state);
+}
+BENCHMARK(BM_repeated_load_cached<detail::JsonCppParser>)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_repeated_load_cached<detail::JsonPullParser>)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
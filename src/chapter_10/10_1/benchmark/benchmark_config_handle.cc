@@ -0,0 +1,119 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:37:34
+# Desc   : ConfigHandle 读取吞吐: 32+ 个读线程, 同时有一个线程不停地重新加载配置
+########################################################################
+*/
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "bench_util.h"
+#include "config_loader/config_handle.h"
+#include "schema.h"
+
+namespace {
+
+using Points = std::vector<Point>;
+
+const std::string& configPath() {
+  static const std::string path = [] {
+    auto path = (std::filesystem::temp_directory_path() / "config_loader_handle_points.json").string();
+    std::ofstream{path} << bench::makePointsJSON(1000);
+    return path;
+  }();
+  return path;
+}
+
+ConfigHandle<Points, detail::JsonPullParser>& handle() {
+  static ConfigHandle<Points, detail::JsonPullParser> h{configPath()};
+  return h;
+}
+
+// 对照组: 用互斥锁保护的 shared_ptr, 与 reload 线程共用
+std::mutex g_mutex;
+std::shared_ptr<const Points> g_locked_config;
+
+std::optional<std::jthread> g_reloader;
+std::atomic<size_t> g_reload_count{0};
+
+// 每个 benchmark 运行期间在后台不停地重新加载
+void startReloader(const benchmark::State&) {
+  handle().reload();
+  g_locked_config = handle().get();
+  g_reload_count = 0;
+  g_reloader.emplace([](std::stop_token stop) {
+    while (!stop.stop_requested()) {
+      handle().reload();
+      {
+        std::lock_guard lock{g_mutex};
+        g_locked_config = handle().get();
+      }
+      g_reload_count.fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+}
+
+void stopReloader(const benchmark::State&) {
+  g_reloader.reset();
+}
+
+void setCounters(benchmark::State& state) {
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0) {
+    state.counters["reloads"] = static_cast<double>(g_reload_count.load());
+  }
+}
+
+}  // namespace
+
+// 每个线程一个 Reader, 配置没有变化时只读一次 version
+static void BM_reader_get(benchmark::State& state) {
+  auto reader = handle().reader();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(reader.get().size());
+  }
+  setCounters(state);
+}
+BENCHMARK(BM_reader_get)->Setup(startReloader)->Teardown(stopReloader)
+    ->Threads(1)->Threads(8)->Threads(32)->Threads(64)->UseRealTime();
+
+// 每次都从 std::atomic<std::shared_ptr> 取快照, 需要修改共享的引用计数
+static void BM_handle_get(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(handle().get()->size());
+  }
+  setCounters(state);
+}
+BENCHMARK(BM_handle_get)->Setup(startReloader)->Teardown(stopReloader)
+    ->Threads(1)->Threads(8)->Threads(32)->Threads(64)->UseRealTime();
+
+static void BM_mutex_get(benchmark::State& state) {
+  for (auto _ : state) {
+    std::shared_ptr<const Points> config;
+    {
+      std::lock_guard lock{g_mutex};
+      config = g_locked_config;
+    }
+    benchmark::DoNotOptimize(config->size());
+  }
+  setCounters(state);
+}
+BENCHMARK(BM_mutex_get)->Setup(startReloader)->Teardown(stopReloader)
+    ->Threads(1)->Threads(8)->Threads(32)->Threads(64)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,194 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:53:02
+# Desc   : 按元素个数预留 vector 的空间 vs 逐个追加; 加载得到的 flat_map、unordered_map、map 的查找
+########################################################################
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <version>
+
+#if __cpp_lib_flat_map
+#include <flat_map>
+#endif
+
+#include "benchmark/benchmark.h"
+
+#include "bench_util.h"
+#include "config_loader/loader.h"
+#include "schema.h"
+
+namespace {
+
+// 不提供 getElementCount() 的 JsonTapeParser, vector 只能逐个追加
+class NoCountTapeElementType {
+public:
+  NoCountTapeElementType() = default;
+  explicit NoCountTapeElementType(parser::JsonTapeElementType elem) : elem_(elem) {}
+  bool isValid() const {
+    return elem_.isValid();
+  }
+  std::optional<std::string> getValueText() const {
+    return elem_.getValueText();
+  }
+  ValueKind getValueKind() const {
+    return elem_.getValueKind();
+  }
+  std::optional<int64_t> getInt64Value() const {
+    return elem_.getInt64Value();
+  }
+  std::optional<uint64_t> getUint64Value() const {
+    return elem_.getUint64Value();
+  }
+  std::optional<double> getDoubleValue() const {
+    return elem_.getDoubleValue();
+  }
+  std::optional<bool> getBoolValue() const {
+    return elem_.getBoolValue();
+  }
+  std::optional<std::string_view> getStringValue() const {
+    return elem_.getStringValue();
+  }
+  const char* getKeyName() const {
+    return elem_.getKeyName();
+  }
+  std::string_view getKeyView() const {
+    return elem_.getKeyView();
+  }
+  NoCountTapeElementType toChildElem(std::string_view key) const {
+    return NoCountTapeElementType{elem_.toChildElem(key)};
+  }
+  template <typename F>
+  Result forEachElement(F&& f) const {
+    return elem_.forEachElement([&f](parser::JsonTapeElementType item) {
+      return f(NoCountTapeElementType{item});
+    });
+  }
+  std::string serializeToString() const {
+    return elem_.serializeToString();
+  }
+private:
+  parser::JsonTapeElementType elem_;
+};  // class NoCountTapeElementType
+
+class NoCountTapeParser {
+public:
+  using ElemType = NoCountTapeElementType;
+  Result parse(std::string_view content) {
+    return parser_.parse(content);
+  }
+  ElemType toRootElemType() const {
+    return ElemType{parser_.toRootElemType()};
+  }
+private:
+  parser::JsonTapeParser parser_;
+};  // class NoCountTapeParser
+
+template <typename P>
+void runLoadPoints(benchmark::State& state) {
+  static const std::string json = bench::makePointsJSON(1'000'000);
+  size_t allocations{0};
+  size_t bytes{0};
+  for (auto _ : state) {
+    std::vector<Point> points;
+    bench::AllocationScope scope;
+    benchmark::DoNotOptimize(loadJSON2Obj<P>(points, [] { return std::string_view(json); }));
+    allocations += scope.count();
+    bytes += scope.bytes();
+  }
+  state.counters["allocs"] = static_cast<double>(allocations) / static_cast<double>(state.iterations());
+  state.counters["alloc_bytes"] = static_cast<double>(bytes) / static_cast<double>(state.iterations());
+}
+
+// {"route_0": 0, "route_1": 1, ...}, 以及打乱顺序的待查找的 key
+constexpr size_t kRouteCount = 1000;
+
+const std::string& routesJSON() {
+  static const std::string json = [] {
+    std::string out{"{"};
+    for (size_t i = 0; i < kRouteCount; ++i) {
+      if (i != 0) {
+        out += ", ";
+      }
+      out += "\"route_" + std::to_string(i) + "\": " + std::to_string(i);
+    }
+    out += '}';
+    return out;
+  }();
+  return json;
+}
+
+const std::vector<std::string>& lookupKeys() {
+  static const std::vector<std::string> keys = [] {
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < kRouteCount; ++i) {
+      keys.push_back("route_" + std::to_string(i));
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937{42});
+    return keys;
+  }();
+  return keys;
+}
+
+template <typename Map>
+void runLookup(benchmark::State& state) {
+  Map routes;
+  if (loadJSON2Obj<detail::JsonTapeParser>(routes, [] { return std::string_view(routesJSON()); })
+      != Result::SUCCESS) {
+    state.SkipWithError("load failed");
+    return;
+  }
+  const auto& keys = lookupKeys();
+  for (auto _ : state) {
+    int64_t sum{0};
+    for (const auto& key : keys) {
+      sum += routes.find(key)->second;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * keys.size()));
+}
+
+}  // namespace
+
+static void BM_points_reserve_tape(benchmark::State& state) {
+  runLoadPoints<detail::JsonTapeParser>(state);
+}
+BENCHMARK(BM_points_reserve_tape)->Unit(benchmark::kMillisecond);
+
+static void BM_points_no_reserve_tape(benchmark::State& state) {
+  runLoadPoints<NoCountTapeParser>(state);
+}
+BENCHMARK(BM_points_no_reserve_tape)->Unit(benchmark::kMillisecond);
+
+#if __cpp_lib_flat_map
+static void BM_lookup_flat_map(benchmark::State& state) {
+  runLookup<std::flat_map<std::string, int64_t>>(state);
+}
+BENCHMARK(BM_lookup_flat_map);
+#endif
+
+static void BM_lookup_unordered_map(benchmark::State& state) {
+  runLookup<std::unordered_map<std::string, int64_t>>(state);
+}
+BENCHMARK(BM_lookup_unordered_map);
+
+static void BM_lookup_map(benchmark::State& state) {
+  runLookup<std::map<std::string, int64_t>>(state);
+}
+BENCHMARK(BM_lookup_map);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,137 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:26:32
+# Desc   : read() / mmap 读取文件 vs ifstream + stringstream 读取文件, 统计耗时和 RSS 峰值增量
+########################################################################
+*/
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "bench_util.h"
+#include "config_loader/loader.h"
+#include "schema.h"
+
+// 原来的实现: ifstream -> stringstream -> std::string
+static std::string streamFileContent(const std::string& path) {
+  std::ifstream file{path};
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  return buffer.str();
+}
+
+// 生成不小于 mb MB 的 points 文件, 同一规模只生成一次, 进程退出时删除
+static const std::string& pointsFile(size_t mb) {
+  struct Files {
+    std::vector<std::pair<size_t, std::string>> paths;
+    ~Files() {
+      for (const auto& [_, path] : paths) {
+        std::filesystem::remove(path);
+      }
+    }
+  };
+  static Files files;
+  for (const auto& [size, path] : files.paths) {
+    if (size == mb) {
+      return path;
+    }
+  }
+  const size_t point_bytes = bench::makePointsJSON(1000).size() / 1000;
+  auto path = (std::filesystem::temp_directory_path()
+      / ("config_loader_points_" + std::to_string(mb) + "mb.json")).string();
+  std::ofstream{path} << bench::makePointsJSON((mb << 20) / point_bytes + 1);
+  return files.paths.emplace_back(mb, path).second;
+}
+
+// 每次迭代前重置 RSS 峰值, 报告各次迭代中最大的增量
+template <typename F>
+static void runWithPeakRss(benchmark::State& state, const std::string& path, F&& f) {
+  size_t peak_rss{0};
+  for (auto _ : state) {
+    state.PauseTiming();
+    bench::resetPeakRss();
+    const size_t base = bench::peakRssBytes();
+    state.ResumeTiming();
+    f();
+    peak_rss = std::max(peak_rss, bench::peakRssBytes() - base);
+  }
+  const auto file_size = std::filesystem::file_size(path);
+  state.counters["peak_rss_mb"] = static_cast<double>(peak_rss) / (1 << 20);
+  state.counters["file_mb"] = static_cast<double>(file_size) / (1 << 20);
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * file_size));
+}
+
+// 只读取内容并逐字节访问一遍
+static void BM_read_stream(benchmark::State& state) {
+  const auto& path = pointsFile(state.range(0));
+  runWithPeakRss(state, path, [&path] {
+    auto content = streamFileContent(path);
+    benchmark::DoNotOptimize(std::count(content.begin(), content.end(), '{'));
+  });
+}
+BENCHMARK(BM_read_stream)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMillisecond);
+
+// 默认的读取方式
+static void BM_read_file(benchmark::State& state) {
+  const auto& path = pointsFile(state.range(0));
+  runWithPeakRss(state, path, [&path] {
+    auto content = detail::get_file_content(path);
+    auto view = content.view();
+    benchmark::DoNotOptimize(std::count(view.begin(), view.end(), '{'));
+  });
+}
+BENCHMARK(BM_read_file)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMillisecond);
+
+static void BM_read_mmap(benchmark::State& state) {
+  const auto& path = pointsFile(state.range(0));
+  runWithPeakRss(state, path, [&path] {
+    auto content = detail::get_file_content(path, 0);
+    auto view = content.view();
+    benchmark::DoNotOptimize(std::count(view.begin(), view.end(), '{'));
+  });
+}
+BENCHMARK(BM_read_mmap)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMillisecond);
+
+// 完整加载, 解析器使用不构建 DOM 的 JsonPullParser, 内存主要花在文件内容和结果上
+static void BM_load_stream(benchmark::State& state) {
+  const auto& path = pointsFile(state.range(0));
+  runWithPeakRss(state, path, [&path] {
+    std::vector<Point> points;
+    benchmark::DoNotOptimize(loadJSON2Obj<detail::JsonPullParser>(points, [&path] {
+      return streamFileContent(path);
+    }));
+  });
+}
+BENCHMARK(BM_load_stream)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMillisecond);
+
+static void BM_load_file(benchmark::State& state) {
+  const auto& path = pointsFile(state.range(0));
+  runWithPeakRss(state, path, [&path] {
+    std::vector<Point> points;
+    benchmark::DoNotOptimize(loadJSON2Obj<detail::JsonPullParser>(points, path));
+  });
+}
+BENCHMARK(BM_load_file)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMillisecond);
+
+static void BM_load_mmap(benchmark::State& state) {
+  const auto& path = pointsFile(state.range(0));
+  runWithPeakRss(state, path, [&path] {
+    std::vector<Point> points;
+    benchmark::DoNotOptimize(loadJSON2Obj<detail::JsonPullParser>(points, path, FileReadOptions{.mmap_min_size = 0}));
+  });
+}
+BENCHMARK(BM_load_mmap)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,156 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:48:48
+# Desc   : std::variant 按节点类型选择备选类型并原地构造 vs 逐个尝试; shared_ptr 一次分配 vs 两次
+########################################################################
+*/
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "bench_util.h"
+#include "config_loader/loader.h"
+#include "schema.h"
+
+namespace {
+
+// 原来的实现: 每个备选类型先构造一个局部对象, 反序列化成功后再移动到 variant 中
+template <typename... Ts>
+struct TryEachVariant {
+  std::variant<Ts...> value;
+};  // struct TryEachVariant
+
+// 原来的实现: 先 make_unique, 再转换为 shared_ptr(控制块单独分配)
+template <typename T>
+struct TwoStepShared {
+  std::shared_ptr<T> value;
+};  // struct TwoStepShared
+
+}  // namespace
+
+namespace detail {
+
+template <typename... Ts>
+struct CompoundDeserializeTraits<TryEachVariant<Ts...>> {
+  static Result deserialize(TryEachVariant<Ts...>& obj, concepts::ParserElem auto node) {
+    if (!node.isValid()) {
+      return Result::ERR_MISSING_FIELD;
+    }
+    auto build_variant = [&obj, &node]<typename T>(std::type_identity<T>) {
+      T value{};
+      auto res = CompoundDeserializeTraits<T>::deserialize(value, node);
+      if (res == Result::SUCCESS) {
+        obj.value.template emplace<T>(std::move(value));
+      }
+      return res;
+    };
+    bool success{false};
+    ((success = (build_variant(std::type_identity<Ts>{}) == Result::SUCCESS)) || ...);
+    return success ? Result::SUCCESS : Result::ERR_TYPE;
+  }
+};  // struct CompoundDeserializeTraits<TryEachVariant<Ts...>>
+
+template <typename T>
+struct CompoundDeserializeTraits<TwoStepShared<T>> {
+  static Result deserialize(TwoStepShared<T>& obj, concepts::ParserElem auto node) {
+    auto value = std::make_unique<T>();
+    CHECK_SUCCESS_OR_RETURN(CompoundDeserializeTraits<T>::deserialize(*value, node));
+    obj.value = std::move(value);
+    return Result::SUCCESS;
+  }
+};  // struct CompoundDeserializeTraits<TwoStepShared<T>>
+
+}  // namespace detail
+
+namespace {
+
+constexpr size_t kItemCount = 100'000;
+
+// 整数、浮点数、字符串、对象依次出现; 放在最后的 Point 需要逐个尝试 4 次
+const std::string& mixedJSON() {
+  static const std::string json = [] {
+    std::string out{"["};
+    for (size_t i = 0; i < kItemCount; ++i) {
+      if (i != 0) {
+        out += ", ";
+      }
+      switch (i % 4) {
+        case 0: out += std::to_string(i); break;
+        case 1: out += std::to_string(i) + ".5"; break;
+        case 2: out += "\"value_" + std::to_string(i) + "_with_a_long_suffix\""; break;
+        default: out += R"({"x": 1, "y": 2, "other": "point"})"; break;
+      }
+    }
+    out += ']';
+    return out;
+  }();
+  return json;
+}
+
+const std::string& pointsJSON() {
+  static const std::string json = bench::makePointsJSON(kItemCount);
+  return json;
+}
+
+template <typename P, typename T>
+void runLoad(benchmark::State& state, const std::string& json) {
+  size_t allocations{0};
+  for (auto _ : state) {
+    T items;
+    bench::AllocationScope scope;
+    benchmark::DoNotOptimize(loadJSON2Obj<P>(items, [&json] { return std::string_view(json); }));
+    allocations += scope.count();
+  }
+  state.counters["allocs_per_item"] =
+      static_cast<double>(allocations) / static_cast<double>(state.iterations() * kItemCount);
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kItemCount));
+}
+
+using MixedVariant = std::variant<int64_t, double, std::string, Point>;
+
+}  // namespace
+
+static void BM_variant_by_kind_pull(benchmark::State& state) {
+  runLoad<detail::JsonPullParser, std::vector<MixedVariant>>(state, mixedJSON());
+}
+BENCHMARK(BM_variant_by_kind_pull)->Unit(benchmark::kMillisecond);
+
+static void BM_variant_try_each_pull(benchmark::State& state) {
+  runLoad<detail::JsonPullParser, std::vector<TryEachVariant<int64_t, double, std::string, Point>>>(
+      state, mixedJSON());
+}
+BENCHMARK(BM_variant_try_each_pull)->Unit(benchmark::kMillisecond);
+
+static void BM_variant_by_kind_jsoncpp(benchmark::State& state) {
+  runLoad<detail::JsonCppParser, std::vector<MixedVariant>>(state, mixedJSON());
+}
+BENCHMARK(BM_variant_by_kind_jsoncpp)->Unit(benchmark::kMillisecond);
+
+static void BM_variant_try_each_jsoncpp(benchmark::State& state) {
+  runLoad<detail::JsonCppParser, std::vector<TryEachVariant<int64_t, double, std::string, Point>>>(
+      state, mixedJSON());
+}
+BENCHMARK(BM_variant_try_each_jsoncpp)->Unit(benchmark::kMillisecond);
+
+static void BM_shared_ptr_allocate_shared_pull(benchmark::State& state) {
+  runLoad<detail::JsonPullParser, std::vector<std::shared_ptr<Point>>>(state, pointsJSON());
+}
+BENCHMARK(BM_shared_ptr_allocate_shared_pull)->Unit(benchmark::kMillisecond);
+
+static void BM_shared_ptr_two_step_pull(benchmark::State& state) {
+  runLoad<detail::JsonPullParser, std::vector<TwoStepShared<Point>>>(state, pointsJSON());
+}
+BENCHMARK(BM_shared_ptr_two_step_pull)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
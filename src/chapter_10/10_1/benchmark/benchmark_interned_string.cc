@@ -0,0 +1,142 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/16 00:41:39
+# Desc   : 大量重复的字符串值: std::string 与 InternedString 字段的加载时间和常驻内存
+########################################################################
+*/
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "bench_util.h"
+#include "config_loader/interned_string.h"
+#include "config_loader/loader.h"
+
+DEFINE_SCHEMA(Instance,
+  (std::string)name,
+  (std::string)service,
+  (std::string)region,
+  (std::string)env,
+  (std::string)owner,
+  (std::vector<std::string>)tags);
+
+// name 各不相同, 仍然用 std::string
+DEFINE_SCHEMA(InternedInstance,
+  (std::string)name,
+  (InternedString)service,
+  (InternedString)region,
+  (InternedString)env,
+  (InternedString)owner,
+  (std::vector<InternedString>)tags);
+
+namespace {
+
+constexpr size_t kInstanceCount = 100'000;
+
+const std::string& instancesJSON() {
+  static const std::string json = bench::makeInstancesJSON(kInstanceCount);
+  return json;
+}
+
+// retained_bytes: 加载完成后对象(以及驻留表)仍然占用的堆内存
+void setCounters(benchmark::State& state, size_t retained) {
+  state.counters["retained_bytes"] = static_cast<double>(retained);
+  state.counters["bytes_per_instance"] = static_cast<double>(retained) / kInstanceCount;
+}
+
+// kScopedTable 为 false 时驻留到全局的表(第一次加载后不再增长, 不计入 retained_bytes);
+// 否则每次加载使用新的表, 表占用的内存计入 retained_bytes
+template <typename T, typename P, bool kScopedTable>
+void runLoad(benchmark::State& state) {
+  const auto& json = instancesJSON();
+  size_t retained{0};
+  for (auto _ : state) {
+    const size_t base = bench::liveBytes();
+    std::optional<InternTable> table;
+    std::vector<T> instances;
+    {
+      std::optional<ScopedInternTable> scope;
+      if constexpr (kScopedTable) {
+        scope.emplace(&table.emplace());
+      }
+      if (loadJSON2Obj<P>(instances, [&json] { return std::string_view(json); }) != Result::SUCCESS) {
+        state.SkipWithError("load failed");
+        return;
+      }
+    }
+    state.PauseTiming();
+    retained = bench::liveBytes() - base;
+    instances = {};
+    table.reset();
+    state.ResumeTiming();
+  }
+  setCounters(state, retained);
+}
+
+}  // namespace
+
+static void BM_string_fields(benchmark::State& state) {
+  runLoad<Instance, detail::JsonPullParser, false>(state);
+}
+BENCHMARK(BM_string_fields)->Unit(benchmark::kMillisecond);
+
+static void BM_interned_fields_global_table(benchmark::State& state) {
+  runLoad<InternedInstance, detail::JsonPullParser, false>(state);
+}
+BENCHMARK(BM_interned_fields_global_table)->Unit(benchmark::kMillisecond);
+
+static void BM_interned_fields_scoped_table(benchmark::State& state) {
+  runLoad<InternedInstance, detail::JsonPullParser, true>(state);
+}
+BENCHMARK(BM_interned_fields_scoped_table)->Unit(benchmark::kMillisecond);
+
+static void BM_string_fields_jsoncpp(benchmark::State& state) {
+  runLoad<Instance, detail::JsonCppParser, false>(state);
+}
+BENCHMARK(BM_string_fields_jsoncpp)->Unit(benchmark::kMillisecond);
+
+static void BM_interned_fields_jsoncpp(benchmark::State& state) {
+  runLoad<InternedInstance, detail::JsonCppParser, true>(state);
+}
+BENCHMARK(BM_interned_fields_jsoncpp)->Unit(benchmark::kMillisecond);
+
+// 相等比较: 内容比较与指针比较
+static void BM_compare_string(benchmark::State& state) {
+  std::vector<Instance> instances;
+  loadJSON2Obj<detail::JsonPullParser>(instances, [] { return std::string_view(instancesJSON()); });
+  const std::string target = instances[kInstanceCount / 2].owner;
+  for (auto _ : state) {
+    size_t matches{0};
+    for (const auto& instance : instances) {
+      matches += instance.owner == target;
+    }
+    benchmark::DoNotOptimize(matches);
+  }
+}
+BENCHMARK(BM_compare_string)->Unit(benchmark::kMicrosecond);
+
+static void BM_compare_interned(benchmark::State& state) {
+  std::vector<InternedInstance> instances;
+  loadJSON2Obj<detail::JsonPullParser>(instances, [] { return std::string_view(instancesJSON()); });
+  const InternedString target = instances[kInstanceCount / 2].owner;
+  for (auto _ : state) {
+    size_t matches{0};
+    for (const auto& instance : instances) {
+      matches += instance.owner == target;
+    }
+    benchmark::DoNotOptimize(matches);
+  }
+}
+BENCHMARK(BM_compare_interned)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
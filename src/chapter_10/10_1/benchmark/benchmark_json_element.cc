@@ -0,0 +1,135 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 10:40:05
+# Desc   : JsonElementType 持有 DOM 指针 vs 按值拷贝子树
+########################################################################
+*/
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "json/json.h"
+
+#include "bench_util.h"
+#include "config_loader/loader.h"
+#include "schema.h"
+
+namespace {
+
+// 修改前的实现: elem_ 按值保存, toChildElem/forEachElement 每次都会深拷贝子树
+class CopyingJsonElementType {
+public:
+  CopyingJsonElementType() = default;
+  explicit CopyingJsonElementType(const Json::Value& elem, const char* key_name = nullptr)
+      : key_name_(key_name), elem_(elem) {}
+  bool isValid() const {
+    return !elem_.isNull();
+  }
+  std::optional<std::string> getValueText() const {
+    if (elem_.isObject() || elem_.isArray()) {
+      return std::nullopt;
+    }
+    return elem_.asString();
+  }
+  const char* getKeyName() const {
+    return key_name_;
+  }
+  CopyingJsonElementType toChildElem(std::string_view key) const {
+    if (!elem_.isObject()) {
+      return CopyingJsonElementType{Json::Value::nullSingleton()};
+    }
+    return CopyingJsonElementType{elem_[key.data()], key.data()};
+  }
+  template <typename F>
+  Result forEachElement(F&& f) const {
+    switch (elem_.type()) {
+      case Json::ValueType::nullValue:
+        return Result::SUCCESS;
+      case Json::ValueType::arrayValue:
+        for (auto&& e: elem_) {
+          CHECK_SUCCESS_OR_RETURN(f(CopyingJsonElementType{e}));
+        }
+        return Result::SUCCESS;
+      case Json::ValueType::objectValue: {
+        auto keys = elem_.getMemberNames();
+        for (auto &&key: keys) {
+          CHECK_SUCCESS_OR_RETURN(f(CopyingJsonElementType{elem_[key], key.c_str()}));
+        }
+        return Result::SUCCESS;
+      }
+      default:
+        return Result::ERR_TYPE;
+    }
+  }
+  std::string serializeToString() const {
+    Json::FastWriter fastWriter;
+    return fastWriter.write(elem_);
+  }
+private:
+  const char* key_name_{nullptr};
+  const Json::Value elem_;
+};  // class CopyingJsonElementType
+
+class CopyingJsonCppParser {
+public:
+  using ElemType = CopyingJsonElementType;
+  Result parse(std::string_view content) {
+    Json::CharReaderBuilder builder;
+    std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+    return reader->parse(content.data(), content.data() + content.size(), &root_, nullptr)
+        ? Result::SUCCESS : Result::ERR_ILL_FORMED;
+  }
+  ElemType toRootElemType() const {
+    return ElemType{root_};
+  }
+private:
+  Json::Value root_;
+};  // class CopyingJsonCppParser
+
+}  // namespace
+
+template <typename P>
+static void runLoad(benchmark::State& state, const std::string& json) {
+  size_t allocations{0};
+  for (auto _ : state) {
+    bench::AllocationScope scope;
+    TestTree tree;
+    auto res = detail::load_to_obj<P>(tree, [&json] { return json; });
+    benchmark::DoNotOptimize(res);
+    allocations += scope.count();
+  }
+  state.counters["allocs"] = benchmark::Counter(
+      static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * json.size()));
+}
+
+static void BM_deep_by_pointer(benchmark::State& state) {
+  runLoad<parser::JsonCppParser>(state, bench::makeTestTreeJSON(state.range(0), 1));
+}
+// jsoncpp 默认的嵌套深度上限是 1000, 每层 TestTree 占两层(object + array)
+BENCHMARK(BM_deep_by_pointer)->RangeMultiplier(4)->Range(8, 256);
+
+static void BM_deep_by_value(benchmark::State& state) {
+  runLoad<CopyingJsonCppParser>(state, bench::makeTestTreeJSON(state.range(0), 1));
+}
+BENCHMARK(BM_deep_by_value)->RangeMultiplier(4)->Range(8, 256);
+
+static void BM_wide_by_pointer(benchmark::State& state) {
+  runLoad<parser::JsonCppParser>(state, bench::makeTestTreeJSON(3, state.range(0)));
+}
+BENCHMARK(BM_wide_by_pointer)->RangeMultiplier(4)->Range(8, 256);
+
+static void BM_wide_by_value(benchmark::State& state) {
+  runLoad<CopyingJsonCppParser>(state, bench::makeTestTreeJSON(3, state.range(0)));
+}
+BENCHMARK(BM_wide_by_value)->RangeMultiplier(4)->Range(8, 256);
+
+BENCHMARK_MAIN();
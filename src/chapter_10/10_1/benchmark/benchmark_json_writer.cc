@@ -0,0 +1,178 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:35:23
+# Desc   : dumpObj2JSON vs Json::FastWriter 的输出吞吐
+########################################################################
+*/
+
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "json/json.h"
+
+#include "bench_util.h"
+#include "config_loader/dumper.h"
+#include "config_loader/loader.h"
+#include "schema.h"
+
+namespace {
+
+// 通过 SerializeTraits 把对象转换为 Json::Value, 即原来"先构建 DOM 再用 FastWriter 输出"的方式
+class JsonValueWriter {
+public:
+  explicit JsonValueWriter(Json::Value& root) {
+    stack_.push_back(&root);
+  }
+  void beginObject(size_t) {
+    push(Json::objectValue);
+  }
+  void key(std::string_view name) {
+    key_.assign(name);
+  }
+  void endObject() {
+    stack_.pop_back();
+  }
+  void beginArray(size_t) {
+    push(Json::arrayValue);
+  }
+  void endArray() {
+    stack_.pop_back();
+  }
+  void writeNull() {
+    slot() = Json::Value{};
+  }
+  void writeBool(bool value) {
+    slot() = value;
+  }
+  void writeInt64(int64_t value) {
+    slot() = Json::Int64{value};
+  }
+  void writeUint64(uint64_t value) {
+    slot() = Json::UInt64{value};
+  }
+  void writeDouble(double value) {
+    slot() = value;
+  }
+  void writeString(std::string_view value) {
+    slot() = Json::Value(value.data(), value.data() + value.size());
+  }
+
+private:
+  // 根节点只写一次, 之后按当前容器的类型追加元素或设置成员
+  Json::Value& slot() {
+    Json::Value& top = *stack_.back();
+    if (top.isArray()) {
+      return top.append(Json::Value{});
+    }
+    if (top.isObject()) {
+      return top[key_];
+    }
+    return top;
+  }
+  void push(Json::ValueType type) {
+    Json::Value& value = slot();
+    value = Json::Value{type};
+    stack_.push_back(&value);
+  }
+
+  std::vector<Json::Value*> stack_;
+  std::string key_;
+};  // class JsonValueWriter
+static_assert(concepts::Writer<JsonValueWriter>);
+
+std::vector<Point> makePoints(size_t n) {
+  std::vector<Point> points;
+  loadJSON2Obj<detail::JsonPullParser>(points, [n] { return bench::makePointsJSON(n); });
+  return points;
+}
+
+TestTree makeTestTree(size_t depth) {
+  TestTree tree;
+  loadJSON2Obj<detail::JsonPullParser>(tree, [depth] { return bench::makeTestTreeJSON(depth, 8); });
+  return tree;
+}
+
+template <typename T>
+void runDump(benchmark::State& state, const T& obj) {
+  std::string out;
+  size_t bytes{0};
+  for (auto _ : state) {
+    dumpObj2JSON(obj, out);
+    bytes += out.size();
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+
+// DOM 已经存在, 只统计 FastWriter 输出的部分
+template <typename T>
+void runFastWriter(benchmark::State& state, const T& obj) {
+  Json::Value root;
+  JsonValueWriter value_writer{root};
+  detail::SerializeTraits<T>::serialize(obj, value_writer);
+  Json::FastWriter writer;
+  size_t bytes{0};
+  for (auto _ : state) {
+    auto out = writer.write(root);
+    bytes += out.size();
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+
+// 每次都先构建 DOM 再输出
+template <typename T>
+void runBuildDomAndFastWriter(benchmark::State& state, const T& obj) {
+  Json::FastWriter writer;
+  size_t bytes{0};
+  for (auto _ : state) {
+    Json::Value root;
+    JsonValueWriter value_writer{root};
+    detail::SerializeTraits<T>::serialize(obj, value_writer);
+    auto out = writer.write(root);
+    bytes += out.size();
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+
+}  // namespace
+
+static void BM_points_dump(benchmark::State& state) {
+  runDump(state, makePoints(state.range(0)));
+}
+BENCHMARK(BM_points_dump)->Arg(100'000)->Unit(benchmark::kMillisecond);
+
+static void BM_points_fast_writer(benchmark::State& state) {
+  runFastWriter(state, makePoints(state.range(0)));
+}
+BENCHMARK(BM_points_fast_writer)->Arg(100'000)->Unit(benchmark::kMillisecond);
+
+static void BM_points_build_dom_and_fast_writer(benchmark::State& state) {
+  runBuildDomAndFastWriter(state, makePoints(state.range(0)));
+}
+BENCHMARK(BM_points_build_dom_and_fast_writer)->Arg(100'000)->Unit(benchmark::kMillisecond);
+
+static void BM_test_tree_dump(benchmark::State& state) {
+  runDump(state, makeTestTree(state.range(0)));
+}
+BENCHMARK(BM_test_tree_dump)->Arg(6)->Unit(benchmark::kMillisecond);
+
+static void BM_test_tree_fast_writer(benchmark::State& state) {
+  runFastWriter(state, makeTestTree(state.range(0)));
+}
+BENCHMARK(BM_test_tree_fast_writer)->Arg(6)->Unit(benchmark::kMillisecond);
+
+static void BM_test_tree_build_dom_and_fast_writer(benchmark::State& state) {
+  runBuildDomAndFastWriter(state, makeTestTree(state.range(0)));
+}
+BENCHMARK(BM_test_tree_build_dom_and_fast_writer)->Arg(6)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,123 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:56:35
+# Desc   : 只访问 5% 字段的配置: Lazy<T> 延迟解析 vs 加载时全部反序列化
+########################################################################
+*/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "bench_util.h"
+#include "config_loader/lazy.h"
+#include "config_loader/loader.h"
+#include "schema.h"
+
+namespace {
+
+// 20 个字段, 每个字段是 kPointsPerField 个 Point 组成的数组, 只访问其中 1 个
+#define ROUTE_FIELDS(T) \
+  (T)route_0, (T)route_1, (T)route_2, (T)route_3, (T)route_4, \
+  (T)route_5, (T)route_6, (T)route_7, (T)route_8, (T)route_9, \
+  (T)route_10, (T)route_11, (T)route_12, (T)route_13, (T)route_14, \
+  (T)route_15, (T)route_16, (T)route_17, (T)route_18, (T)route_19
+
+using Points = std::vector<Point>;
+using LazyPoints = Lazy<Points>;
+DEFINE_SCHEMA(EagerRoutes, ROUTE_FIELDS(Points));
+DEFINE_SCHEMA(LazyRoutes, ROUTE_FIELDS(LazyPoints));
+
+#undef ROUTE_FIELDS
+
+constexpr size_t kFieldCount = 20;
+constexpr size_t kPointsPerField = 5000;
+
+const std::string& routesJSON() {
+  static const std::string json = [] {
+    const std::string points = bench::makePointsJSON(kPointsPerField);
+    std::string out{"{"};
+    for (size_t i = 0; i < kFieldCount; ++i) {
+      if (i != 0) {
+        out += ",\n";
+      }
+      out += "\"route_" + std::to_string(i) + "\": " + points;
+    }
+    out += '}';
+    return out;
+  }();
+  return json;
+}
+
+const Points& touched(const EagerRoutes& routes) {
+  return routes.route_7;
+}
+const Points& touched(const LazyRoutes& routes) {
+  return routes.route_7.get();
+}
+
+// 每次迭代: 加载整个配置, 然后读取一个字段的全部元素
+template <typename P, typename Routes>
+void runLoadAndTouch(benchmark::State& state) {
+  const std::string& json = routesJSON();
+  size_t allocations{0};
+  for (auto _ : state) {
+    Routes routes;
+    bench::AllocationScope scope;
+    if (loadJSON2Obj<P>(routes, [&json] { return std::string_view(json); }) != Result::SUCCESS) {
+      state.SkipWithError("load failed");
+      return;
+    }
+    int64_t sum{0};
+    for (const auto& point : touched(routes)) {
+      sum += point.x;
+    }
+    benchmark::DoNotOptimize(sum);
+    allocations += scope.count();
+  }
+  state.counters["allocs"] = static_cast<double>(allocations) / static_cast<double>(state.iterations());
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * json.size()));
+}
+
+}  // namespace
+
+static void BM_eager_pull(benchmark::State& state) {
+  runLoadAndTouch<detail::JsonPullParser, EagerRoutes>(state);
+}
+BENCHMARK(BM_eager_pull)->Unit(benchmark::kMillisecond);
+
+static void BM_lazy_pull(benchmark::State& state) {
+  runLoadAndTouch<detail::JsonPullParser, LazyRoutes>(state);
+}
+BENCHMARK(BM_lazy_pull)->Unit(benchmark::kMillisecond);
+
+static void BM_eager_tape(benchmark::State& state) {
+  runLoadAndTouch<detail::JsonTapeParser, EagerRoutes>(state);
+}
+BENCHMARK(BM_eager_tape)->Unit(benchmark::kMillisecond);
+
+static void BM_lazy_tape(benchmark::State& state) {
+  runLoadAndTouch<detail::JsonTapeParser, LazyRoutes>(state);
+}
+BENCHMARK(BM_lazy_tape)->Unit(benchmark::kMillisecond);
+
+// JsonCppParser 不能给出原始文本, 每个 Lazy 字段都要从 DOM 重新生成一遍 json, 加载比直接反序列化还慢
+static void BM_eager_jsoncpp(benchmark::State& state) {
+  runLoadAndTouch<detail::JsonCppParser, EagerRoutes>(state);
+}
+BENCHMARK(BM_eager_jsoncpp)->Unit(benchmark::kMillisecond);
+
+static void BM_lazy_jsoncpp(benchmark::State& state) {
+  runLoadAndTouch<detail::JsonCppParser, LazyRoutes>(state);
+}
+BENCHMARK(BM_lazy_jsoncpp)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,82 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/16 00:08:02
+# Desc   : 启动时加载 1000 个小配置文件: loadMany 并发加载 vs 逐个 loadJSON2Obj
+########################################################################
+*/
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "bench_util.h"
+#include "config_loader/load_many.h"
+#include "config_loader/loader.h"
+#include "schema.h"
+
+namespace {
+
+constexpr size_t kFileCount = 1000;
+constexpr size_t kPointsPerFile = 50;
+
+// 生成 kFileCount 个 points 文件, 进程退出时删除
+const std::vector<std::string>& configFiles() {
+  struct Files {
+    std::filesystem::path dir{std::filesystem::temp_directory_path() / "config_loader_load_many"};
+    std::vector<std::string> paths;
+    Files() {
+      std::filesystem::create_directories(dir);
+      const std::string json = bench::makePointsJSON(kPointsPerFile);
+      for (size_t i = 0; i < kFileCount; ++i) {
+        auto path = (dir / ("points_" + std::to_string(i) + ".json")).string();
+        std::ofstream{path} << json;
+        paths.push_back(std::move(path));
+      }
+    }
+    ~Files() {
+      std::filesystem::remove_all(dir);
+    }
+  };
+  static Files files;
+  return files.paths;
+}
+
+}  // namespace
+
+static void BM_sequential(benchmark::State& state) {
+  const auto& paths = configFiles();
+  for (auto _ : state) {
+    std::vector<std::vector<Point>> configs(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+      benchmark::DoNotOptimize(loadJSON2Obj(configs[i], paths[i]));
+    }
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kFileCount));
+}
+BENCHMARK(BM_sequential)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_load_many(benchmark::State& state) {
+  const auto& paths = configFiles();
+  for (auto _ : state) {
+    std::vector<std::vector<Point>> configs(paths.size());
+    std::vector<LoadRequest<>> requests;
+    requests.reserve(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+      requests.emplace_back(configs[i], paths[i]);
+    }
+    benchmark::DoNotOptimize(loadMany(requests, static_cast<size_t>(state.range(0))));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kFileCount));
+}
+BENCHMARK(BM_load_many)->RangeMultiplier(4)->Range(1, 64)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
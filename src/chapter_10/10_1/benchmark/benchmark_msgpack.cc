@@ -0,0 +1,102 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/16 00:31:28
+# Desc   : 同样的 TestTree 和 Point 数据, MessagePack 与 json 的加载时间和编码大小
+########################################################################
+*/
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "bench_util.h"
+#include "config_loader/dumper.h"
+#include "config_loader/loader.h"
+#include "schema.h"
+
+namespace {
+
+constexpr size_t kPointCount = 100'000;
+
+// 两种编码都由同一个对象 dump 得到, 内容完全相同
+struct Encoded {
+  std::string json;
+  std::string msgpack;
+};  // struct Encoded
+
+template <typename T>
+Encoded encode(const std::string& source) {
+  T obj;
+  loadJSON2Obj<detail::JsonTapeParser>(obj, [&source] { return std::string_view(source); });
+  Encoded encoded;
+  dumpObj2JSON(obj, encoded.json);
+  dumpObj2MsgPack(obj, encoded.msgpack);
+  return encoded;
+}
+
+// 每个节点 8 个子节点, 共 6 层, 37449 个节点
+const Encoded& tree() {
+  static const Encoded encoded = encode<TestTree>(bench::makeTestTreeJSON(6, 8));
+  return encoded;
+}
+
+const Encoded& points() {
+  static const Encoded encoded = encode<std::vector<Point>>(bench::makePointsJSON(kPointCount));
+  return encoded;
+}
+
+// 目标对象在迭代之间复用; encoded_bytes 为输入的大小
+template <typename P, typename T>
+void runLoad(benchmark::State& state, const std::string& content) {
+  T obj;
+  for (auto _ : state) {
+    if (detail::load_to_obj<P>(obj, [&content] { return std::string_view(content); }) != Result::SUCCESS) {
+      state.SkipWithError("load failed");
+      return;
+    }
+  }
+  state.counters["encoded_bytes"] = static_cast<double>(content.size());
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * content.size()));
+}
+
+}  // namespace
+
+static void BM_tree_msgpack(benchmark::State& state) {
+  runLoad<detail::MsgPackParser, TestTree>(state, tree().msgpack);
+}
+BENCHMARK(BM_tree_msgpack)->Unit(benchmark::kMillisecond);
+
+static void BM_tree_json_pull(benchmark::State& state) {
+  runLoad<detail::JsonPullParser, TestTree>(state, tree().json);
+}
+BENCHMARK(BM_tree_json_pull)->Unit(benchmark::kMillisecond);
+
+static void BM_tree_json_tape(benchmark::State& state) {
+  runLoad<detail::JsonTapeParser, TestTree>(state, tree().json);
+}
+BENCHMARK(BM_tree_json_tape)->Unit(benchmark::kMillisecond);
+
+static void BM_points_msgpack(benchmark::State& state) {
+  runLoad<detail::MsgPackParser, std::vector<Point>>(state, points().msgpack);
+}
+BENCHMARK(BM_points_msgpack)->Unit(benchmark::kMillisecond);
+
+static void BM_points_json_pull(benchmark::State& state) {
+  runLoad<detail::JsonPullParser, std::vector<Point>>(state, points().json);
+}
+BENCHMARK(BM_points_json_pull)->Unit(benchmark::kMillisecond);
+
+static void BM_points_json_tape(benchmark::State& state) {
+  runLoad<detail::JsonTapeParser, std::vector<Point>>(state, points().json);
+}
+BENCHMARK(BM_points_json_tape)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
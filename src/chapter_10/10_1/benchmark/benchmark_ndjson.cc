@@ -0,0 +1,103 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/16 00:09:47
+# Desc   : NdjsonReader 的吞吐量与按块读文件(磁盘读取速度的上限)对比, 以及堆内存峰值
+########################################################################
+*/
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "bench_util.h"
+#include "config_loader/ndjson_reader.h"
+#include "schema.h"
+
+namespace {
+
+constexpr size_t kFileMB = 256;
+
+// 每行一个 Point, 文件不小于 kFileMB MB, 进程退出时删除
+const std::string& ndjsonFile() {
+  struct File {
+    std::string path{(std::filesystem::temp_directory_path() / "config_loader_points.ndjson").string()};
+    File() {
+      std::ofstream out{path};
+      std::string line;
+      for (size_t i = 0, written = 0; written < (kFileMB << 20); ++i) {
+        line = R"({"x": )" + std::to_string(i) + R"(, "y": )" + std::to_string(i * 2)
+            + R"(, "other": "record_)" + std::to_string(i) + "\"}\n";
+        out << line;
+        written += line.size();
+      }
+    }
+    ~File() {
+      std::filesystem::remove(path);
+    }
+  };
+  static File file;
+  return file.path;
+}
+
+}  // namespace
+
+// 只按 1MB 的块读文件, 不解析
+static void BM_read_chunks(benchmark::State& state) {
+  const auto& path = ndjsonFile();
+  std::vector<char> buffer(NdjsonReader<Point>::kDefaultChunkSize);
+  for (auto _ : state) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    while (::read(fd, buffer.data(), buffer.size()) > 0) {
+      benchmark::ClobberMemory();
+    }
+    ::close(fd);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * std::filesystem::file_size(path)));
+}
+BENCHMARK(BM_read_chunks)->Unit(benchmark::kMillisecond);
+
+template <typename P>
+static void runReader(benchmark::State& state) {
+  const auto& path = ndjsonFile();
+  size_t peak{0};
+  for (auto _ : state) {
+    bench::PeakMemoryScope scope;
+    NdjsonReader<Point, P> reader{path};
+    double sum{0};
+    for (const Point& point : reader) {
+      sum += point.x;
+    }
+    benchmark::DoNotOptimize(sum);
+    if (reader.status() != Result::SUCCESS) {
+      state.SkipWithError("load failed");
+      return;
+    }
+    peak = std::max(peak, scope.peak());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * std::filesystem::file_size(path)));
+  state.counters["peak_heap_kb"] = static_cast<double>(peak) / 1024;
+}
+
+static void BM_ndjson_pull(benchmark::State& state) {
+  runReader<detail::JsonPullParser>(state);
+}
+BENCHMARK(BM_ndjson_pull)->Unit(benchmark::kMillisecond);
+
+static void BM_ndjson_tape(benchmark::State& state) {
+  runReader<detail::JsonTapeParser>(state);
+}
+BENCHMARK(BM_ndjson_tape)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,89 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/16 00:06:44
+# Desc   : 5M 个 Point 组成的数组在 1 ~ 32 个线程上并行反序列化
+########################################################################
+*/
+
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "bench_util.h"
+#include "config_loader/loader.h"
+#include "schema.h"
+
+namespace {
+
+constexpr size_t kPointCount = 5'000'000;
+
+const std::string& pointsJSON() {
+  static const std::string json = bench::makePointsJSON(kPointCount);
+  return json;
+}
+
+void applyThreads(const benchmark::State& state) {
+  setParallelDeserializeOptions({.min_elements = 100'000, .max_threads = static_cast<size_t>(state.range(0))});
+}
+
+// 只计反序列化: 解析一次, 每次迭代反序列化到新的 vector
+template <typename P>
+void runDeserialize(benchmark::State& state) {
+  applyThreads(state);
+  P parser;
+  if (parser.parse(pointsJSON()) != Result::SUCCESS) {
+    state.SkipWithError("parse failed");
+    return;
+  }
+  for (auto _ : state) {
+    std::vector<Point> points;
+    benchmark::DoNotOptimize(detail::CompoundDeserializeTraits<std::vector<Point>>::deserialize(
+        points, parser.toRootElemType()));
+    state.PauseTiming();
+    points = {};  // 释放不计入
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kPointCount));
+  setParallelDeserializeOptions({});
+}
+
+// 解析 + 反序列化
+template <typename P>
+void runLoad(benchmark::State& state) {
+  applyThreads(state);
+  for (auto _ : state) {
+    std::vector<Point> points;
+    benchmark::DoNotOptimize(loadJSON2Obj<P>(points, [] { return std::string_view(pointsJSON()); }));
+    state.PauseTiming();
+    points = {};
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kPointCount));
+  setParallelDeserializeOptions({});
+}
+
+}  // namespace
+
+static void BM_deserialize_tape(benchmark::State& state) {
+  runDeserialize<detail::JsonTapeParser>(state);
+}
+BENCHMARK(BM_deserialize_tape)->RangeMultiplier(2)->Range(1, 32)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_deserialize_jsoncpp(benchmark::State& state) {
+  runDeserialize<detail::JsonCppParser>(state);
+}
+BENCHMARK(BM_deserialize_jsoncpp)->RangeMultiplier(2)->Range(1, 32)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_load_tape(benchmark::State& state) {
+  runLoad<detail::JsonTapeParser>(state);
+}
+BENCHMARK(BM_load_tape)->RangeMultiplier(2)->Range(1, 32)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,108 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:44:24
+# Desc   : 加载并销毁约 100 万个节点的树: 每个节点单独分配(TestTree) vs 整棵树在一块 arena 中(ArenaObject)
+########################################################################
+*/
+
+#include <chrono>
+#include <memory_resource>
+#include <optional>
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+#include "bench_util.h"
+#include "config_loader/arena_object.h"
+#include "config_loader/loader.h"
+#include "schema.h"
+
+DEFINE_SCHEMA(ArenaTestTree,
+  (std::pmr::string)name,
+  (std::pmr::vector<ArenaTestTree>)children);
+
+namespace {
+
+// 每个节点 10 个子节点, 共 7 层, 1111111 个节点
+const std::string& treeJSON() {
+  static const std::string json = bench::makeTestTreeJSON(7, 10);
+  return json;
+}
+
+using Clock = std::chrono::steady_clock;
+
+void setCounters(benchmark::State& state, size_t allocations, Clock::duration destroy) {
+  const auto iterations = static_cast<double>(state.iterations());
+  state.counters["allocs_per_load"] = static_cast<double>(allocations) / iterations;
+  state.counters["destroy_ms"] = std::chrono::duration<double, std::milli>(destroy).count() / iterations;
+}
+
+// 原来的方式: 节点和 children 各自从堆上分配, 析构时逐个释放
+template <typename P>
+void runHeap(benchmark::State& state) {
+  const auto& json = treeJSON();
+  size_t allocations{0};
+  Clock::duration destroy{};
+  for (auto _ : state) {
+    std::optional<TestTree> tree{std::in_place};
+    {
+      bench::AllocationScope scope;
+      benchmark::DoNotOptimize(loadJSON2Obj<P>(*tree, [&json] { return std::string_view(json); }));
+      allocations += scope.count();
+    }
+    const auto start = Clock::now();
+    tree.reset();
+    destroy += Clock::now() - start;
+  }
+  setCounters(state, allocations, destroy);
+}
+
+// 整棵树分配在 ArenaObject 的 arena 中, 销毁时只释放 arena 的几个大块
+template <typename P>
+void runArena(benchmark::State& state) {
+  const auto& json = treeJSON();
+  size_t allocations{0};
+  Clock::duration destroy{};
+  for (auto _ : state) {
+    std::optional<ArenaObject<ArenaTestTree>> tree{std::in_place};
+    {
+      bench::AllocationScope scope;
+      benchmark::DoNotOptimize(tree->template loadJSON<P>([&json] { return std::string_view(json); }));
+      allocations += scope.count();
+    }
+    const auto start = Clock::now();
+    tree.reset();
+    destroy += Clock::now() - start;
+  }
+  setCounters(state, allocations, destroy);
+}
+
+}  // namespace
+
+static void BM_tree_heap_pull(benchmark::State& state) {
+  runHeap<detail::JsonPullParser>(state);
+}
+BENCHMARK(BM_tree_heap_pull)->Unit(benchmark::kMillisecond);
+
+static void BM_tree_arena_pull(benchmark::State& state) {
+  runArena<detail::JsonPullParser>(state);
+}
+BENCHMARK(BM_tree_arena_pull)->Unit(benchmark::kMillisecond);
+
+static void BM_tree_heap_jsoncpp(benchmark::State& state) {
+  runHeap<detail::JsonCppParser>(state);
+}
+BENCHMARK(BM_tree_heap_jsoncpp)->Unit(benchmark::kMillisecond);
+
+static void BM_tree_arena_jsoncpp(benchmark::State& state) {
+  runArena<detail::JsonCppParser>(state);
+}
+BENCHMARK(BM_tree_arena_jsoncpp)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,141 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 14:05:47
+# Desc   : PrimitiveDeserializeTraits 文本路径: std::from_chars vs std::stringstream
+########################################################################
+*/
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "config_loader/loader.h"
+
+namespace {
+
+constexpr size_t kFieldCount{1'000'000};
+
+std::vector<std::string> makeDoubleTexts() {
+  std::vector<std::string> texts;
+  texts.reserve(kFieldCount);
+  for (size_t i = 0; i < kFieldCount; ++i) {
+    texts.emplace_back(std::to_string(static_cast<double>(i) * 1.25 - 1000.5));
+  }
+  return texts;
+}
+
+std::vector<std::string> makeIntTexts() {
+  std::vector<std::string> texts;
+  texts.reserve(kFieldCount);
+  for (size_t i = 0; i < kFieldCount; ++i) {
+    texts.emplace_back(std::to_string(static_cast<int64_t>(i * 7919) - 500'000));
+  }
+  return texts;
+}
+
+// 修改前的实现
+template <typename Number>
+Result deserializeByStringStream(Number& num, const std::string& text) {
+  std::stringstream ss;
+  ss << text;
+  if (detail::is_hex(text)) {
+    ss << std::hex;
+  }
+  ss >> num;
+  return ss.fail() ? Result::ERR_EXTRACTING_FIELD : Result::SUCCESS;
+}
+
+// ["1.5", "2.5", ...], 数字用字符串表示, 加载时走 getValueText() 的文本路径
+std::string makeQuotedArrayJSON(const std::vector<std::string>& texts) {
+  std::string json{"["};
+  for (size_t i = 0; i < texts.size(); ++i) {
+    if (i != 0) {
+      json += ',';
+    }
+    json += '"';
+    json += texts[i];
+    json += '"';
+  }
+  json += ']';
+  return json;
+}
+
+}  // namespace
+
+template <typename Number>
+static void runFromChars(benchmark::State& state, const std::vector<std::string>& texts) {
+  for (auto _ : state) {
+    Number num{};
+    for (const auto& text : texts) {
+      auto res = detail::PrimitiveDeserializeTraits<Number>::deserialize(num, std::string_view(text));
+      benchmark::DoNotOptimize(res);
+      benchmark::DoNotOptimize(num);
+    }
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * texts.size()));
+}
+
+template <typename Number>
+static void runStringStream(benchmark::State& state, const std::vector<std::string>& texts) {
+  for (auto _ : state) {
+    Number num{};
+    for (const auto& text : texts) {
+      auto res = deserializeByStringStream(num, text);
+      benchmark::DoNotOptimize(res);
+      benchmark::DoNotOptimize(num);
+    }
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * texts.size()));
+}
+
+static void BM_double_from_chars(benchmark::State& state) {
+  runFromChars<double>(state, makeDoubleTexts());
+}
+BENCHMARK(BM_double_from_chars)->Unit(benchmark::kMillisecond);
+
+static void BM_double_stringstream(benchmark::State& state) {
+  runStringStream<double>(state, makeDoubleTexts());
+}
+BENCHMARK(BM_double_stringstream)->Unit(benchmark::kMillisecond);
+
+static void BM_int_from_chars(benchmark::State& state) {
+  runFromChars<int64_t>(state, makeIntTexts());
+}
+BENCHMARK(BM_int_from_chars)->Unit(benchmark::kMillisecond);
+
+static void BM_int_stringstream(benchmark::State& state) {
+  runStringStream<int64_t>(state, makeIntTexts());
+}
+BENCHMARK(BM_int_stringstream)->Unit(benchmark::kMillisecond);
+
+// 完整加载一百万个以字符串表示的数字
+template <typename Number>
+static void runLoadQuotedArray(benchmark::State& state, const std::string& json) {
+  for (auto _ : state) {
+    std::vector<Number> nums;
+    auto res = loadJSON2Obj(nums, [&json] { return json; });
+    benchmark::DoNotOptimize(res);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kFieldCount));
+}
+
+static void BM_load_quoted_doubles(benchmark::State& state) {
+  runLoadQuotedArray<double>(state, makeQuotedArrayJSON(makeDoubleTexts()));
+}
+BENCHMARK(BM_load_quoted_doubles)->Unit(benchmark::kMillisecond);
+
+static void BM_load_quoted_ints(benchmark::State& state) {
+  runLoadQuotedArray<int64_t>(state, makeQuotedArrayJSON(makeIntTexts()));
+}
+BENCHMARK(BM_load_quoted_ints)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,60 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 17:02:44
+# Desc   : JsonPullParser vs JsonCppParser, 数据为放大后的 conf/point.json 和 conf/test_tree.json
+########################################################################
+*/
+
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "bench_util.h"
+#include "config_loader/loader.h"
+#include "schema.h"
+
+template <typename P, typename T>
+static void runLoad(benchmark::State& state, const std::string& json) {
+  size_t peak{0};
+  for (auto _ : state) {
+    bench::PeakMemoryScope scope;
+    T obj;
+    // 峰值中包含 LoadToObj 持有的一份输入内容
+    auto res = detail::load_to_obj<P>(obj, [&json] { return json; });
+    benchmark::DoNotOptimize(res);
+    peak = std::max(peak, scope.peak());
+  }
+  state.counters["peak_bytes"] = static_cast<double>(peak);
+  state.counters["input_bytes"] = static_cast<double>(json.size());
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * json.size()));
+}
+
+static void BM_points_jsoncpp(benchmark::State& state) {
+  runLoad<detail::JsonCppParser, std::vector<Point>>(state, bench::makePointsJSON(state.range(0)));
+}
+BENCHMARK(BM_points_jsoncpp)->RangeMultiplier(10)->Range(1000, 1'000'000)->Unit(benchmark::kMillisecond);
+
+static void BM_points_pull(benchmark::State& state) {
+  runLoad<detail::JsonPullParser, std::vector<Point>>(state, bench::makePointsJSON(state.range(0)));
+}
+BENCHMARK(BM_points_pull)->RangeMultiplier(10)->Range(1000, 1'000'000)->Unit(benchmark::kMillisecond);
+
+// 每个节点 8 个子节点, depth 层
+static void BM_test_tree_jsoncpp(benchmark::State& state) {
+  runLoad<detail::JsonCppParser, TestTree>(state, bench::makeTestTreeJSON(state.range(0), 8));
+}
+BENCHMARK(BM_test_tree_jsoncpp)->DenseRange(4, 7)->Unit(benchmark::kMillisecond);
+
+static void BM_test_tree_pull(benchmark::State& state) {
+  runLoad<detail::JsonPullParser, TestTree>(state, bench::makeTestTreeJSON(state.range(0), 8));
+}
+BENCHMARK(BM_test_tree_pull)->DenseRange(4, 7)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
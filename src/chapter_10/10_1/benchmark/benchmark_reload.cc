@@ -0,0 +1,113 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:39:27
+# Desc   : 重新加载 TestTree 时的内存分配次数: 每次新建对象 vs 原地覆盖已有对象
+########################################################################
+*/
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+#include "bench_util.h"
+#include "config_loader/config_handle.h"
+#include "config_loader/loader.h"
+#include "schema.h"
+
+namespace {
+
+// 每个节点 8 个子节点, 共 5 层
+const std::string& treeJSON() {
+  static const std::string json = bench::makeTestTreeJSON(5, 8);
+  return json;
+}
+
+void setCounters(benchmark::State& state, size_t allocations, size_t bytes) {
+  state.counters["allocs_per_reload"] = static_cast<double>(allocations) / static_cast<double>(state.iterations());
+  state.counters["alloc_bytes_per_reload"] = static_cast<double>(bytes) / static_cast<double>(state.iterations());
+}
+
+// 原来的方式: 每次加载到新建的对象
+template <typename P>
+void runFresh(benchmark::State& state) {
+  const auto& json = treeJSON();
+  size_t allocations{0};
+  size_t bytes{0};
+  for (auto _ : state) {
+    bench::AllocationScope scope;
+    TestTree tree;
+    benchmark::DoNotOptimize(loadJSON2Obj<P>(tree, [&json] { return std::string_view(json); }));
+    allocations += scope.count();
+    bytes += scope.bytes();
+  }
+  setCounters(state, allocations, bytes);
+}
+
+// 反复加载到同一个对象, 节点、name 和 children 的空间都被复用
+template <typename P>
+void runInPlace(benchmark::State& state) {
+  const auto& json = treeJSON();
+  TestTree tree;
+  loadJSON2Obj<P>(tree, [&json] { return std::string_view(json); });
+  size_t allocations{0};
+  size_t bytes{0};
+  for (auto _ : state) {
+    bench::AllocationScope scope;
+    benchmark::DoNotOptimize(loadJSON2Obj<P>(tree, [&json] { return std::string_view(json); }));
+    allocations += scope.count();
+    bytes += scope.bytes();
+  }
+  setCounters(state, allocations, bytes);
+}
+
+}  // namespace
+
+static void BM_reload_fresh_pull(benchmark::State& state) {
+  runFresh<detail::JsonPullParser>(state);
+}
+BENCHMARK(BM_reload_fresh_pull)->Unit(benchmark::kMicrosecond);
+
+static void BM_reload_in_place_pull(benchmark::State& state) {
+  runInPlace<detail::JsonPullParser>(state);
+}
+BENCHMARK(BM_reload_in_place_pull)->Unit(benchmark::kMicrosecond);
+
+static void BM_reload_fresh_jsoncpp(benchmark::State& state) {
+  runFresh<detail::JsonCppParser>(state);
+}
+BENCHMARK(BM_reload_fresh_jsoncpp)->Unit(benchmark::kMicrosecond);
+
+static void BM_reload_in_place_jsoncpp(benchmark::State& state) {
+  runInPlace<detail::JsonCppParser>(state);
+}
+BENCHMARK(BM_reload_in_place_jsoncpp)->Unit(benchmark::kMicrosecond);
+
+// ConfigHandle 在旧配置没有读者时复用它; 包含读取文件的分配
+static void BM_config_handle_reload_pull(benchmark::State& state) {
+  const auto path = (std::filesystem::temp_directory_path() / "config_loader_reload_tree.json").string();
+  std::ofstream{path} << treeJSON();
+  ConfigHandle<TestTree, detail::JsonPullParser> handle{path};
+  handle.reload();
+  handle.reload();
+  size_t allocations{0};
+  size_t bytes{0};
+  for (auto _ : state) {
+    bench::AllocationScope scope;
+    benchmark::DoNotOptimize(handle.reload());
+    allocations += scope.count();
+    bytes += scope.bytes();
+  }
+  setCounters(state, allocations, bytes);
+  std::filesystem::remove(path);
+}
+BENCHMARK(BM_config_handle_reload_pull)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,195 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:28:51
+# Desc   : 按 FieldIndex 完美哈希分发字段的反序列化 vs 针对 Point/TestTree 手写的解析器
+########################################################################
+*/
+
+#include <charconv>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "bench_util.h"
+#include "config_loader/loader.h"
+#include "config_loader/parser/json_lexer.h"
+#include "schema.h"
+
+namespace {
+
+// 只支持 Point 和 TestTree 的手写解析器, 不处理转义字符
+class HandWrittenParser {
+public:
+  explicit HandWrittenParser(std::string_view json) : p_(json.data()), end_(json.data() + json.size()) {}
+
+  bool parsePoints(std::vector<Point>& points) {
+    points.clear();
+    return parseArray([&] {
+      return parsePoint(points.emplace_back());
+    });
+  }
+  bool parseTestTree(TestTree& tree) {
+    return parseObject([&](std::string_view key) {
+      if (key == "name") {
+        auto value = parseString();
+        tree.name.assign(value.data(), value.size());
+        return value.data() != nullptr;
+      }
+      if (key == "children") {
+        return parseArray([&] {
+          return parseTestTree(*tree.children.emplace_back(std::make_unique<TestTree>()));
+        });
+      }
+      return false;
+    });
+  }
+
+private:
+  bool parsePoint(Point& point) {
+    return parseObject([&](std::string_view key) {
+      switch (key.size()) {
+        case 1:
+          if (key[0] == 'x') return parseNumber(point.x);
+          if (key[0] == 'y') return parseNumber(point.y);
+          if (key[0] == 'z') return parseNumber(point.z.emplace());
+          return false;
+        case 5: {
+          if (key != "other") return false;
+          auto text = *p_ == '"' ? parseString() : parseScalar();
+          point.other = std::string(text);
+          return text.data() != nullptr;
+        }
+        default:
+          return false;
+      }
+    });
+  }
+  template <typename F>
+  bool parseObject(F&& on_member) {
+    if (!consume('{')) return false;
+    if (consume('}')) return true;
+    do {
+      auto key = parseString();
+      if (key.data() == nullptr || !consume(':')) return false;
+      skipWhitespace();
+      if (!on_member(key)) return false;
+    } while (consume(','));
+    return consume('}');
+  }
+  template <typename F>
+  bool parseArray(F&& on_element) {
+    if (!consume('[')) return false;
+    if (consume(']')) return true;
+    do {
+      skipWhitespace();
+      if (!on_element()) return false;
+    } while (consume(','));
+    return consume(']');
+  }
+  // 数字可能带引号, 与 config_loader 的行为一致
+  bool parseNumber(double& num) {
+    auto text = *p_ == '"' ? parseString() : parseScalar();
+    return std::from_chars(text.data(), text.data() + text.size(), num).ec == std::errc{};
+  }
+  std::string_view parseString() {
+    if (!consume('"')) return {};
+    const char* begin = p_;
+    while (p_ < end_ && *p_ != '"') ++p_;
+    if (p_ == end_) return {};
+    return std::string_view(begin, p_++ - begin);
+  }
+  std::string_view parseScalar() {
+    const char* begin = p_;
+    const char* end = parser::json::scanScalar(p_, end_);
+    if (end == nullptr) return {};
+    p_ = end;
+    return std::string_view(begin, end - begin);
+  }
+  void skipWhitespace() {
+    while (p_ < end_ && parser::json::isWhitespace(*p_)) ++p_;
+  }
+  bool consume(char c) {
+    skipWhitespace();
+    if (p_ < end_ && *p_ == c) {
+      ++p_;
+      return true;
+    }
+    return false;
+  }
+
+  const char* p_;
+  const char* end_;
+};  // class HandWrittenParser
+
+template <typename P, typename T>
+void runLoad(benchmark::State& state, const std::string& json) {
+  for (auto _ : state) {
+    T obj;
+    benchmark::DoNotOptimize(detail::load_to_obj<P>(obj, [&json] { return std::string_view(json); }));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * json.size()));
+}
+
+}  // namespace
+
+static void BM_points_hand_written(benchmark::State& state) {
+  const auto json = bench::makePointsJSON(state.range(0));
+  for (auto _ : state) {
+    std::vector<Point> points;
+    benchmark::DoNotOptimize(HandWrittenParser{json}.parsePoints(points));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * json.size()));
+}
+BENCHMARK(BM_points_hand_written)->Arg(100'000)->Unit(benchmark::kMillisecond);
+
+static void BM_points_pull(benchmark::State& state) {
+  runLoad<detail::JsonPullParser, std::vector<Point>>(state, bench::makePointsJSON(state.range(0)));
+}
+BENCHMARK(BM_points_pull)->Arg(100'000)->Unit(benchmark::kMillisecond);
+
+static void BM_points_tape(benchmark::State& state) {
+  runLoad<detail::JsonTapeParser, std::vector<Point>>(state, bench::makePointsJSON(state.range(0)));
+}
+BENCHMARK(BM_points_tape)->Arg(100'000)->Unit(benchmark::kMillisecond);
+
+static void BM_points_jsoncpp(benchmark::State& state) {
+  runLoad<detail::JsonCppParser, std::vector<Point>>(state, bench::makePointsJSON(state.range(0)));
+}
+BENCHMARK(BM_points_jsoncpp)->Arg(100'000)->Unit(benchmark::kMillisecond);
+
+// 每个节点 8 个子节点, 共 6 层
+static void BM_test_tree_hand_written(benchmark::State& state) {
+  const auto json = bench::makeTestTreeJSON(state.range(0), 8);
+  for (auto _ : state) {
+    TestTree tree;
+    benchmark::DoNotOptimize(HandWrittenParser{json}.parseTestTree(tree));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * json.size()));
+}
+BENCHMARK(BM_test_tree_hand_written)->Arg(6)->Unit(benchmark::kMillisecond);
+
+static void BM_test_tree_pull(benchmark::State& state) {
+  runLoad<detail::JsonPullParser, TestTree>(state, bench::makeTestTreeJSON(state.range(0), 8));
+}
+BENCHMARK(BM_test_tree_pull)->Arg(6)->Unit(benchmark::kMillisecond);
+
+static void BM_test_tree_tape(benchmark::State& state) {
+  runLoad<detail::JsonTapeParser, TestTree>(state, bench::makeTestTreeJSON(state.range(0), 8));
+}
+BENCHMARK(BM_test_tree_tape)->Arg(6)->Unit(benchmark::kMillisecond);
+
+static void BM_test_tree_jsoncpp(benchmark::State& state) {
+  runLoad<detail::JsonCppParser, TestTree>(state, bench::makeTestTreeJSON(state.range(0), 8));
+}
+BENCHMARK(BM_test_tree_jsoncpp)->Arg(6)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,94 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:34:07
+# Desc   : 约 100MB 的配置文件, 每次迭代模拟一次进程重启后的加载: 解析 json vs 读取二进制快照
+########################################################################
+*/
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "bench_util.h"
+#include "config_loader/loader.h"
+#include "schema.h"
+
+namespace {
+
+// 进程退出时删除生成的文件
+struct TempFiles {
+  std::filesystem::path json_path = std::filesystem::temp_directory_path() / "config_loader_snapshot_points.json";
+  std::filesystem::path snapshot_path = std::filesystem::temp_directory_path() / "config_loader_snapshot_points.snap";
+  TempFiles() {
+    const size_t point_bytes = bench::makePointsJSON(100'000).size() / 100'000;
+    std::ofstream{json_path} << bench::makePointsJSON((100 << 20) / point_bytes);
+  }
+  ~TempFiles() {
+    std::filesystem::remove(json_path);
+    std::filesystem::remove(snapshot_path);
+  }
+};  // struct TempFiles
+
+const TempFiles& tempFiles() {
+  static TempFiles files;
+  return files;
+}
+
+void setCounters(benchmark::State& state) {
+  const auto& files = tempFiles();
+  state.counters["json_mb"] = static_cast<double>(std::filesystem::file_size(files.json_path)) / (1 << 20);
+  if (std::filesystem::exists(files.snapshot_path)) {
+    state.counters["snapshot_mb"] =
+        static_cast<double>(std::filesystem::file_size(files.snapshot_path)) / (1 << 20);
+  }
+}
+
+template <typename P>
+void runLoad(benchmark::State& state) {
+  const auto& files = tempFiles();
+  for (auto _ : state) {
+    std::vector<Point> points;
+    benchmark::DoNotOptimize(loadJSON2Obj<P>(points, files.json_path.string()));
+  }
+  setCounters(state);
+}
+
+}  // namespace
+
+static void BM_cold_start_jsoncpp(benchmark::State& state) {
+  runLoad<detail::JsonCppParser>(state);
+}
+BENCHMARK(BM_cold_start_jsoncpp)->Iterations(3)->Unit(benchmark::kMillisecond);
+
+static void BM_cold_start_pull(benchmark::State& state) {
+  runLoad<detail::JsonPullParser>(state);
+}
+BENCHMARK(BM_cold_start_pull)->Iterations(3)->Unit(benchmark::kMillisecond);
+
+// 第一次加载时解析并生成快照, 不计入耗时
+static void BM_cold_start_snapshot(benchmark::State& state) {
+  const auto& files = tempFiles();
+  std::filesystem::remove(files.snapshot_path);
+  {
+    std::vector<Point> points;
+    loadJSON2ObjWithSnapshot(points, files.json_path.string(), files.snapshot_path.string());
+  }
+  for (auto _ : state) {
+    std::vector<Point> points;
+    benchmark::DoNotOptimize(
+        loadJSON2ObjWithSnapshot(points, files.json_path.string(), files.snapshot_path.string()));
+  }
+  setCounters(state);
+}
+BENCHMARK(BM_cold_start_snapshot)->Iterations(3)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,78 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:24:10
+# Desc   : JsonTapeParser 各 SIMD 级别 vs JsonCppParser 的解析吞吐, 输入为 1MB ~ 1GB 的 points 数组
+########################################################################
+*/
+
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+#include "bench_util.h"
+#include "config_loader/parser.h"
+
+// 生成不小于 bytes 字节的输入, 同一规模只生成一次
+static const std::string& pointsJSON(size_t bytes) {
+  static size_t cached_bytes{0};
+  static std::string json;
+  if (cached_bytes != bytes) {
+    const size_t point_bytes = bench::makePointsJSON(1000).size() / 1000;
+    json = bench::makePointsJSON(bytes / point_bytes + 1);
+    cached_bytes = bytes;
+  }
+  return json;
+}
+
+static void setThroughput(benchmark::State& state, const std::string& json) {
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * json.size()));
+}
+
+// 只包含第一阶段
+static void BM_structural_indexes(benchmark::State& state, parser::SimdLevel level) {
+  const auto& json = pointsJSON(state.range(0));
+  parser::StructuralIndexes indexes;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(parser::findStructuralIndexes(json, indexes, level));
+  }
+  setThroughput(state, json);
+}
+
+static void BM_tape(benchmark::State& state, parser::SimdLevel level) {
+  const auto& json = pointsJSON(state.range(0));
+  // 复用 parser, 与长期运行的服务中重复加载的场景一致
+  parser::JsonTapeParser p{level};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(p.parse(json));
+  }
+  setThroughput(state, json);
+}
+
+static void BM_jsoncpp(benchmark::State& state) {
+  const auto& json = pointsJSON(state.range(0));
+  for (auto _ : state) {
+    parser::JsonCppParser p;
+    benchmark::DoNotOptimize(p.parse(json));
+  }
+  setThroughput(state, json);
+}
+
+#define TAPE_BENCHMARK(func, level)                                 \
+  BENCHMARK_CAPTURE(func, level, parser::SimdLevel::level)          \
+      ->RangeMultiplier(8)->Range(1 << 20, 1 << 30)->Unit(benchmark::kMillisecond)
+
+TAPE_BENCHMARK(BM_structural_indexes, kScalar);
+TAPE_BENCHMARK(BM_structural_indexes, kSse);
+TAPE_BENCHMARK(BM_structural_indexes, kAvx2);
+TAPE_BENCHMARK(BM_tape, kScalar);
+TAPE_BENCHMARK(BM_tape, kSse);
+TAPE_BENCHMARK(BM_tape, kAvx2);
+BENCHMARK(BM_jsoncpp)->RangeMultiplier(8)->Range(1 << 20, 1 << 30)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,170 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:31:30
+# Desc   : 128 个字段的宽对象: 逐个字段 toChildElem() vs 遍历一遍成员再分发到字段
+########################################################################
+*/
+
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "config_loader/loader.h"
+
+// 两个类型的字段完全相同, WideByLookup 关闭遍历成员的分发方式, 用于对比
+DEFINE_SCHEMA(WideByLookup,
+  (int)field_0, (double)field_1, (std::string)field_2, (bool)field_3,
+  (int)field_4, (double)field_5, (std::string)field_6, (bool)field_7,
+  (int)field_8, (double)field_9, (std::string)field_10, (bool)field_11,
+  (int)field_12, (double)field_13, (std::string)field_14, (bool)field_15,
+  (int)field_16, (double)field_17, (std::string)field_18, (bool)field_19,
+  (int)field_20, (double)field_21, (std::string)field_22, (bool)field_23,
+  (int)field_24, (double)field_25, (std::string)field_26, (bool)field_27,
+  (int)field_28, (double)field_29, (std::string)field_30, (bool)field_31,
+  (int)field_32, (double)field_33, (std::string)field_34, (bool)field_35,
+  (int)field_36, (double)field_37, (std::string)field_38, (bool)field_39,
+  (int)field_40, (double)field_41, (std::string)field_42, (bool)field_43,
+  (int)field_44, (double)field_45, (std::string)field_46, (bool)field_47,
+  (int)field_48, (double)field_49, (std::string)field_50, (bool)field_51,
+  (int)field_52, (double)field_53, (std::string)field_54, (bool)field_55,
+  (int)field_56, (double)field_57, (std::string)field_58, (bool)field_59,
+  (int)field_60, (double)field_61, (std::string)field_62, (bool)field_63,
+  (int)field_64, (double)field_65, (std::string)field_66, (bool)field_67,
+  (int)field_68, (double)field_69, (std::string)field_70, (bool)field_71,
+  (int)field_72, (double)field_73, (std::string)field_74, (bool)field_75,
+  (int)field_76, (double)field_77, (std::string)field_78, (bool)field_79,
+  (int)field_80, (double)field_81, (std::string)field_82, (bool)field_83,
+  (int)field_84, (double)field_85, (std::string)field_86, (bool)field_87,
+  (int)field_88, (double)field_89, (std::string)field_90, (bool)field_91,
+  (int)field_92, (double)field_93, (std::string)field_94, (bool)field_95,
+  (int)field_96, (double)field_97, (std::string)field_98, (bool)field_99,
+  (int)field_100, (double)field_101, (std::string)field_102, (bool)field_103,
+  (int)field_104, (double)field_105, (std::string)field_106, (bool)field_107,
+  (int)field_108, (double)field_109, (std::string)field_110, (bool)field_111,
+  (int)field_112, (double)field_113, (std::string)field_114, (bool)field_115,
+  (int)field_116, (double)field_117, (std::string)field_118, (bool)field_119,
+  (int)field_120, (double)field_121, (std::string)field_122, (bool)field_123,
+  (int)field_124, (double)field_125, (std::string)field_126, (bool)field_127);
+DEFINE_SCHEMA(WideByMemberWalk,
+  (int)field_0, (double)field_1, (std::string)field_2, (bool)field_3,
+  (int)field_4, (double)field_5, (std::string)field_6, (bool)field_7,
+  (int)field_8, (double)field_9, (std::string)field_10, (bool)field_11,
+  (int)field_12, (double)field_13, (std::string)field_14, (bool)field_15,
+  (int)field_16, (double)field_17, (std::string)field_18, (bool)field_19,
+  (int)field_20, (double)field_21, (std::string)field_22, (bool)field_23,
+  (int)field_24, (double)field_25, (std::string)field_26, (bool)field_27,
+  (int)field_28, (double)field_29, (std::string)field_30, (bool)field_31,
+  (int)field_32, (double)field_33, (std::string)field_34, (bool)field_35,
+  (int)field_36, (double)field_37, (std::string)field_38, (bool)field_39,
+  (int)field_40, (double)field_41, (std::string)field_42, (bool)field_43,
+  (int)field_44, (double)field_45, (std::string)field_46, (bool)field_47,
+  (int)field_48, (double)field_49, (std::string)field_50, (bool)field_51,
+  (int)field_52, (double)field_53, (std::string)field_54, (bool)field_55,
+  (int)field_56, (double)field_57, (std::string)field_58, (bool)field_59,
+  (int)field_60, (double)field_61, (std::string)field_62, (bool)field_63,
+  (int)field_64, (double)field_65, (std::string)field_66, (bool)field_67,
+  (int)field_68, (double)field_69, (std::string)field_70, (bool)field_71,
+  (int)field_72, (double)field_73, (std::string)field_74, (bool)field_75,
+  (int)field_76, (double)field_77, (std::string)field_78, (bool)field_79,
+  (int)field_80, (double)field_81, (std::string)field_82, (bool)field_83,
+  (int)field_84, (double)field_85, (std::string)field_86, (bool)field_87,
+  (int)field_88, (double)field_89, (std::string)field_90, (bool)field_91,
+  (int)field_92, (double)field_93, (std::string)field_94, (bool)field_95,
+  (int)field_96, (double)field_97, (std::string)field_98, (bool)field_99,
+  (int)field_100, (double)field_101, (std::string)field_102, (bool)field_103,
+  (int)field_104, (double)field_105, (std::string)field_106, (bool)field_107,
+  (int)field_108, (double)field_109, (std::string)field_110, (bool)field_111,
+  (int)field_112, (double)field_113, (std::string)field_114, (bool)field_115,
+  (int)field_116, (double)field_117, (std::string)field_118, (bool)field_119,
+  (int)field_120, (double)field_121, (std::string)field_122, (bool)field_123,
+  (int)field_124, (double)field_125, (std::string)field_126, (bool)field_127);
+
+template <>
+inline constexpr size_t detail::member_walk_min_fields<WideByLookup> = WideByLookup::_field_count_ + 1;
+
+// n 个对象组成的数组, 每个对象包含全部 128 个字段, 成员顺序与定义顺序相反
+static std::string makeWideJSON(size_t n) {
+  std::string out{"["};
+  for (size_t i = 0; i < n; ++i) {
+    out += i == 0 ? "{" : ",\n{";
+    for (size_t j = 128; j-- > 0;) {
+      out += "\"field_" + std::to_string(j) + "\": ";
+      switch (j % 4) {
+        case 0: out += std::to_string(i + j); break;
+        case 1: out += std::to_string(static_cast<double>(i + j) + 0.25); break;
+        case 2: out += "\"value_" + std::to_string(j) + "\""; break;
+        default: out += j % 8 == 3 ? "true" : "false"; break;
+      }
+      out += j == 0 ? "}" : ", ";
+    }
+  }
+  out += ']';
+  return out;
+}
+
+template <typename P, typename T>
+static void runLoad(benchmark::State& state) {
+  const auto json = makeWideJSON(state.range(0));
+  for (auto _ : state) {
+    std::vector<T> objs;
+    auto res = detail::load_to_obj<P>(objs, [&json] { return std::string_view(json); });
+    if (res != Result::SUCCESS) {
+      state.SkipWithError("load failed");
+      break;
+    }
+    benchmark::DoNotOptimize(objs);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * state.range(0)));
+}
+
+// jsoncpp 的耗时主要在构建 DOM, 这里只统计从 DOM 反序列化的部分
+template <typename T>
+static void runDeserializeFromDom(benchmark::State& state) {
+  const auto json = makeWideJSON(state.range(0));
+  detail::JsonCppParser parser;
+  if (parser.parse(json) != Result::SUCCESS) {
+    state.SkipWithError("parse failed");
+    return;
+  }
+  for (auto _ : state) {
+    std::vector<T> objs;
+    benchmark::DoNotOptimize(detail::CompoundDeserializeTraits<std::vector<T>>::deserialize(
+        objs, parser.toRootElemType()));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * state.range(0)));
+}
+
+static void BM_wide_jsoncpp_lookup(benchmark::State& state) {
+  runDeserializeFromDom<WideByLookup>(state);
+}
+BENCHMARK(BM_wide_jsoncpp_lookup)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+static void BM_wide_jsoncpp_member_walk(benchmark::State& state) {
+  runDeserializeFromDom<WideByMemberWalk>(state);
+}
+BENCHMARK(BM_wide_jsoncpp_member_walk)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+// 包含解析的完整加载
+static void BM_wide_jsoncpp_load(benchmark::State& state) {
+  runLoad<detail::JsonCppParser, WideByMemberWalk>(state);
+}
+BENCHMARK(BM_wide_jsoncpp_load)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+static void BM_wide_pull(benchmark::State& state) {
+  runLoad<detail::JsonPullParser, WideByMemberWalk>(state);
+}
+BENCHMARK(BM_wide_pull)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+static void BM_wide_tape(benchmark::State& state) {
+  runLoad<detail::JsonTapeParser, WideByMemberWalk>(state);
+}
+BENCHMARK(BM_wide_tape)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
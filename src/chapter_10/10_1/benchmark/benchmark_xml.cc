@@ -0,0 +1,139 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/16 00:27:03
+# Desc   : 内置 XmlParser 的 loadXML2Obj 与手写的 tinyxml2 加载代码对比
+########################################################################
+*/
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "tinyxml2.h"
+
+#include "bench_util.h"
+#include "config_loader/loader.h"
+#include "schema.h"
+
+namespace {
+
+constexpr size_t kPointCount = 1'000'000;
+
+const std::string& pointsXML() {
+  static const std::string xml = bench::makePointsXML(kPointCount);
+  return xml;
+}
+
+// 书中 practice/point.cpp 的写法: 逐个读取属性和子元素; other 固定按 double 读取, 比 std::variant 的匹配更简单
+Result loadPointsTinyXML2(std::vector<Point>& points, std::string_view content) {
+  tinyxml2::XMLDocument doc;
+  if (doc.Parse(content.data(), content.size()) != tinyxml2::XML_SUCCESS) {
+    return Result::ERR_ILL_FORMED;
+  }
+  const tinyxml2::XMLElement* root = doc.RootElement();
+  if (root == nullptr) {
+    return Result::ERR_MISSING_FIELD;
+  }
+  points.clear();
+  for (const tinyxml2::XMLElement* elem = root->FirstChildElement(); elem != nullptr;
+       elem = elem->NextSiblingElement()) {
+    Point& point = points.emplace_back();
+    if (elem->QueryDoubleAttribute("x", &point.x) != tinyxml2::XML_SUCCESS ||
+        elem->QueryDoubleAttribute("y", &point.y) != tinyxml2::XML_SUCCESS) {
+      return Result::ERR_EXTRACTING_FIELD;
+    }
+    if (double z{}; elem->QueryDoubleAttribute("z", &z) == tinyxml2::XML_SUCCESS) {
+      point.z = z;
+    }
+    const tinyxml2::XMLElement* other = elem->FirstChildElement("other");
+    double value{};
+    if (other == nullptr || other->QueryDoubleText(&value) != tinyxml2::XML_SUCCESS) {
+      return Result::ERR_EXTRACTING_FIELD;
+    }
+    point.other = value;
+  }
+  return Result::SUCCESS;
+}
+
+void setCounters(benchmark::State& state, size_t allocations) {
+  state.counters["allocs"] = static_cast<double>(allocations) / static_cast<double>(state.iterations());
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * pointsXML().size()));
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kPointCount));
+}
+
+}  // namespace
+
+// 目标 vector 在迭代之间复用, allocs 只统计解析器本身的分配(内容拷贝到 XmlParser 的缓冲区)
+static void BM_xml_load(benchmark::State& state) {
+  const std::string& content = pointsXML();
+  std::vector<Point> points;
+  size_t allocations{0};
+  for (auto _ : state) {
+    bench::AllocationScope scope;
+    if (loadXML2Obj(points, [&content] { return std::string_view(content); }) != Result::SUCCESS) {
+      state.SkipWithError("load failed");
+      return;
+    }
+    allocations += scope.count();
+  }
+  setCounters(state, allocations);
+}
+BENCHMARK(BM_xml_load)->Unit(benchmark::kMillisecond);
+
+static void BM_tinyxml2_load(benchmark::State& state) {
+  const std::string& content = pointsXML();
+  std::vector<Point> points;
+  size_t allocations{0};
+  for (auto _ : state) {
+    bench::AllocationScope scope;
+    if (loadPointsTinyXML2(points, content) != Result::SUCCESS) {
+      state.SkipWithError("load failed");
+      return;
+    }
+    allocations += scope.count();
+  }
+  setCounters(state, allocations);
+}
+BENCHMARK(BM_tinyxml2_load)->Unit(benchmark::kMillisecond);
+
+// 只解析: XmlParser 复用缓冲区和节点数组, tinyxml2 每个节点从内存池中分配
+static void BM_xml_parse(benchmark::State& state) {
+  const std::string& content = pointsXML();
+  parser::XmlParser parser;
+  size_t allocations{0};
+  for (auto _ : state) {
+    bench::AllocationScope scope;
+    if (parser.parse(content) != Result::SUCCESS) {
+      state.SkipWithError("parse failed");
+      return;
+    }
+    allocations += scope.count();
+  }
+  setCounters(state, allocations);
+}
+BENCHMARK(BM_xml_parse)->Unit(benchmark::kMillisecond);
+
+static void BM_tinyxml2_parse(benchmark::State& state) {
+  const std::string& content = pointsXML();
+  size_t allocations{0};
+  for (auto _ : state) {
+    bench::AllocationScope scope;
+    tinyxml2::XMLDocument doc;
+    if (doc.Parse(content.data(), content.size()) != tinyxml2::XML_SUCCESS) {
+      state.SkipWithError("parse failed");
+      return;
+    }
+    allocations += scope.count();
+  }
+  setCounters(state, allocations);
+}
+BENCHMARK(BM_tinyxml2_parse)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,83 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/16 00:18:46
+# Desc   : 内置 YamlParser 与各 json 后端加载内容相同的文档
+########################################################################
+*/
+
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "bench_util.h"
+#include "config_loader/loader.h"
+#include "schema.h"
+
+namespace {
+
+constexpr size_t kPointCount = 100'000;
+
+const std::string& pointsJSON() {
+  static const std::string json = bench::makePointsJSON(kPointCount);
+  return json;
+}
+
+const std::string& pointsYAML() {
+  static const std::string yaml = bench::makePointsYAML(kPointCount);
+  return yaml;
+}
+
+// 目标 vector 在迭代之间复用, allocs 只统计解析器本身的分配
+template <typename P>
+void runLoad(benchmark::State& state, const std::string& content) {
+  std::vector<Point> points;
+  size_t allocations{0};
+  for (auto _ : state) {
+    bench::AllocationScope scope;
+    if (detail::load_to_obj<P>(points, [&content] { return std::string_view(content); }) != Result::SUCCESS) {
+      state.SkipWithError("load failed");
+      return;
+    }
+    allocations += scope.count();
+  }
+  state.counters["allocs"] = static_cast<double>(allocations) / static_cast<double>(state.iterations());
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * content.size()));
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kPointCount));
+}
+
+}  // namespace
+
+static void BM_yaml(benchmark::State& state) {
+  runLoad<detail::YamlParser>(state, pointsYAML());
+}
+BENCHMARK(BM_yaml)->Unit(benchmark::kMillisecond);
+
+// json 也是合法的 YAML(流式集合)
+static void BM_yaml_flow(benchmark::State& state) {
+  runLoad<detail::YamlParser>(state, pointsJSON());
+}
+BENCHMARK(BM_yaml_flow)->Unit(benchmark::kMillisecond);
+
+static void BM_json_jsoncpp(benchmark::State& state) {
+  runLoad<detail::JsonCppParser>(state, pointsJSON());
+}
+BENCHMARK(BM_json_jsoncpp)->Unit(benchmark::kMillisecond);
+
+static void BM_json_pull(benchmark::State& state) {
+  runLoad<detail::JsonPullParser>(state, pointsJSON());
+}
+BENCHMARK(BM_json_pull)->Unit(benchmark::kMillisecond);
+
+static void BM_json_tape(benchmark::State& state) {
+  runLoad<detail::JsonTapeParser>(state, pointsJSON());
+}
+BENCHMARK(BM_json_tape)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,151 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:41:41
+# Desc   : 整个配置对象(包括其中的字符串和容器)分配在一块 arena 中, 销毁时一次释放, 不逐个析构
+########################################################################
+*/
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "define_schema.h"
+#include "loader.h"
+#include "memory_resource.h"
+
+namespace detail {
+
+// 递归类型(如 children 为 std::pmr::vector<Tree> 的 Tree)检查到一定深度后停止
+inline constexpr int kMaxArenaCheckDepth = 8;
+
+// 不析构就释放时不会泄漏: 所有内存都来自 std::pmr 的 allocator, 其余部分可以平凡析构;
+// std::string、std::vector 和智能指针在 arena 之外分配, 不满足要求
+template <typename T>
+struct ArenaSafe {
+  static constexpr bool check(int) {
+    return std::is_trivially_destructible_v<T>;
+  }
+};  // struct ArenaSafe<T>
+
+template <typename Alloc>
+struct ArenaSafe<std::basic_string<char, std::char_traits<char>, Alloc>> {
+  static constexpr bool check(int) {
+    return std::same_as<Alloc, std::pmr::polymorphic_allocator<char>>;
+  }
+};  // struct ArenaSafe<std::basic_string<char, std::char_traits<char>, Alloc>>
+
+template <typename Container, typename ValueType = Container::value_type>
+struct SeqContainerArenaSafe {
+  static constexpr bool check(int depth) {
+    return std::same_as<typename Container::allocator_type, std::pmr::polymorphic_allocator<ValueType>>
+        && ArenaSafe<ValueType>::check(depth);
+  }
+};  // struct SeqContainerArenaSafe
+
+template <typename T, typename Alloc>
+struct ArenaSafe<std::vector<T, Alloc>> : SeqContainerArenaSafe<std::vector<T, Alloc>> {
+};  // struct ArenaSafe<std::vector<T, Alloc>>
+
+template <typename T, typename Alloc>
+struct ArenaSafe<std::list<T, Alloc>> : SeqContainerArenaSafe<std::list<T, Alloc>> {
+};  // struct ArenaSafe<std::list<T, Alloc>>
+
+template <typename T>
+struct ArenaSafe<std::optional<T>> {
+  static constexpr bool check(int depth) {
+    return ArenaSafe<T>::check(depth);
+  }
+};  // struct ArenaSafe<std::optional<T>>
+
+template <typename... Ts>
+struct ArenaSafe<std::variant<Ts...>> {
+  static constexpr bool check(int depth) {
+    return (ArenaSafe<Ts>::check(depth) && ...);
+  }
+};  // struct ArenaSafe<std::variant<Ts...>>
+
+template <concepts::Reflected T>
+struct ArenaSafe<T> {
+  static constexpr bool check(int depth) {
+    if (depth >= kMaxArenaCheckDepth) {
+      return true;
+    }
+    return checkFields(depth + 1, std::make_index_sequence<T::_field_count_>{});
+  }
+private:
+  template <size_t... Is>
+  static constexpr bool checkFields(int depth, std::index_sequence<Is...>) {
+    return (ArenaSafe<std::remove_cvref_t<
+        decltype(std::declval<typename T::template FIELD<T&, Is>&>().value())>>::check(depth) && ...);
+  }
+};  // struct ArenaSafe<T>
+
+}  // namespace detail
+
+/*
+DEFINE_SCHEMA(Tree, (std::pmr::string)name, (std::pmr::vector<Tree>)children);
+
+ArenaObject<Tree> tree;
+if (tree.loadJSON(path) == Result::SUCCESS) {
+  use(tree->name);
+}
+// tree 析构时整块 arena 归还给系统, 不遍历节点
+*/
+template <typename T>
+class ArenaObject {
+  static_assert(detail::ArenaSafe<T>::check(0),
+      "ArenaObject requires std::pmr strings and containers (no std::string, std::vector or smart pointers)");
+public:
+  explicit ArenaObject(size_t initial_size = 64 * 1024) : arena_(initial_size) {}
+  ArenaObject(const ArenaObject&) = delete;
+  ArenaObject& operator=(const ArenaObject&) = delete;
+  // 不调用 T 的析构函数, 由 arena_ 一次释放所有内存
+  ~ArenaObject() = default;
+
+  // 释放上一次加载的对象, 在新的 arena 中加载; 失败时不保留任何对象(get() 返回 nullptr)
+  // content 与 loadJSON2Obj 相同, 可以是文件路径或返回内容的函数
+  template <concepts::Parser P = detail::JsonCppParser, typename Content>
+  Result loadJSON(Content&& content) {
+    value_ = nullptr;
+    arena_.release();
+    ScopedMemoryResource scope{&arena_};
+    T* obj = ::new (arena_.allocate(sizeof(T), alignof(T))) T();
+    auto res = loadJSON2Obj<P>(*obj, std::forward<Content>(content));
+    if (res == Result::SUCCESS) {
+      value_ = obj;
+    }
+    return res;
+  }
+
+  // 只读: 修改字符串和容器时分配的内存在下一次 loadJSON 或析构之前不会被复用
+  const T* get() const {
+    return value_;
+  }
+  const T& operator*() const {
+    return *value_;
+  }
+  const T* operator->() const {
+    return value_;
+  }
+  explicit operator bool() const {
+    return value_ != nullptr;
+  }
+
+private:
+  std::pmr::monotonic_buffer_resource arena_;
+  T* value_{nullptr};
+};  // class ArenaObject
@@ -0,0 +1,391 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/16 00:44:28
+# Desc   : 按列存储的对象数组(SoA): DEFINE_SCHEMA 的每个字段各自一个连续的数组, 从 json 的对象数组加载
+########################################################################
+*/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "field_index.h"
+#include "loader.h"
+#include "serialize/serialize_traits.h"
+
+/*
+DEFINE_SCHEMA(Point, (double)x, (double)y, (std::optional<double>)z, (std::variant<std::string, int, double>)other);
+
+Columns<Point> points;
+loadJSON2Obj(points, path);  // 与 std::vector<Point> 的格式相同: [{"x": 1, "y": 2}, ...]
+std::span<const double> xs = points.column<"x">();  // 所有元素的 x, 连续存放
+double sum = std::reduce(xs.begin(), xs.end());
+points[3].get<"y">() = 1.0;  // 按行访问
+Point p = points[3].toObject();
+*/
+
+namespace detail {
+
+// 作为模板参数的字符串字面量, 用于 column<"x">()
+template <size_t N>
+struct FixedString {
+  char data[N]{};
+
+  constexpr FixedString(const char (&text)[N]) {
+    std::copy_n(text, N, data);
+  }
+  constexpr std::string_view view() const {
+    return std::string_view(data, N - 1);
+  }
+};  // struct FixedString
+
+// T 的第 I 个字段的类型
+template <concepts::Reflected T, size_t I>
+using FieldType = std::remove_cvref_t<decltype(std::declval<typename T::template FIELD<T&, I>&>().value())>;
+
+template <concepts::Reflected T, typename Seq = std::make_index_sequence<T::_field_count_>>
+struct ColumnTuple;
+
+template <concepts::Reflected T, size_t... Is>
+struct ColumnTuple<T, std::index_sequence<Is...>> {
+  using type = std::tuple<std::vector<FieldType<T, Is>>...>;
+};  // struct ColumnTuple
+
+template <concepts::Reflected T, FixedString Name>
+constexpr size_t fieldIndexOf() {
+  constexpr size_t index = FieldIndex<T>::find(Name.view());
+  static_assert(index != FieldIndex<T>::npos, "no such field in DEFINE_SCHEMA");
+  return index;
+}
+
+template <typename T>
+struct SnapshotTraits;
+
+}  // namespace detail
+
+// 所有列的长度始终相同; 列中的元素用 makeValue 构造, 与 DEFINE_SCHEMA 的字段一致
+// bool 字段的列是 std::vector<bool>, 不能取得 std::span, 只能按行或通过 columnVector() 访问
+template <concepts::Reflected T>
+class Columns {
+  static_assert(T::_field_count_ > 0, "Columns requires at least one field");
+public:
+  static constexpr size_t kColumnCount = T::_field_count_;
+  template <size_t I>
+  using ColumnType = detail::FieldType<T, I>;
+
+  // 一行的代理对象, 只保存容器的指针和行号; 容器的大小变化后失效
+  template <bool kConst>
+  class RowRef {
+  public:
+    using Container = std::conditional_t<kConst, const Columns, Columns>;
+
+    RowRef(Container* columns, size_t row) : columns_(columns), row_(row) {}
+
+    // bool 字段返回 std::vector<bool> 的代理对象
+    template <size_t I>
+    decltype(auto) get() const {
+      return std::get<I>(columns_->columns_)[row_];
+    }
+    template <detail::FixedString Name>
+    decltype(auto) get() const {
+      return get<detail::fieldIndexOf<T, Name>()>();
+    }
+    size_t index() const {
+      return row_;
+    }
+    // 拷贝出一个完整的对象
+    T toObject() const {
+      return toObject(std::make_index_sequence<kColumnCount>{});
+    }
+    // 逐个字段赋值
+    void assign(const T& obj) const requires (!kConst) {
+      assign(obj, std::make_index_sequence<kColumnCount>{});
+    }
+    operator RowRef<true>() const requires (!kConst) {
+      return RowRef<true>{columns_, row_};
+    }
+
+  private:
+    template <size_t... Is>
+    T toObject(std::index_sequence<Is...>) const {
+      T obj;
+      ((typename T::template FIELD<T&, Is>{obj}.value() = get<Is>()), ...);
+      return obj;
+    }
+    template <size_t... Is>
+    void assign(const T& obj, std::index_sequence<Is...>) const {
+      ((get<Is>() = typename T::template FIELD<const T&, Is>{obj}.value()), ...);
+    }
+
+    Container* columns_;
+    size_t row_;
+  };  // class RowRef
+
+  using Row = RowRef<false>;
+  using ConstRow = RowRef<true>;
+
+  // 按行遍历, 解引用得到 Row/ConstRow
+  template <bool kConst>
+  class RowIterator {
+  public:
+    // 解引用得到的是代理对象而不是引用, 不满足 LegacyForwardIterator; 只对 C++20 的迭代器概念声明为前向迭代器
+    using iterator_concept = std::forward_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = RowRef<kConst>;
+    using difference_type = std::ptrdiff_t;
+    using Container = std::conditional_t<kConst, const Columns, Columns>;
+
+    RowIterator() = default;
+    RowIterator(Container* columns, size_t row) : columns_(columns), row_(row) {}
+
+    RowRef<kConst> operator*() const {
+      return RowRef<kConst>{columns_, row_};
+    }
+    RowIterator& operator++() {
+      ++row_;
+      return *this;
+    }
+    RowIterator operator++(int) {
+      auto it = *this;
+      ++row_;
+      return it;
+    }
+    bool operator==(const RowIterator& other) const {
+      return row_ == other.row_;
+    }
+
+  private:
+    Container* columns_{nullptr};
+    size_t row_{0};
+  };  // class RowIterator
+
+  size_t size() const {
+    return std::get<0>(columns_).size();
+  }
+  bool empty() const {
+    return size() == 0;
+  }
+  void reserve(size_t n) {
+    forEachColumn([n](auto& column) {
+      column.reserve(n);
+    });
+  }
+  // 新增的行用 makeValue 初始化
+  void resize(size_t n) {
+    forEachColumn([n](auto& column) {
+      using Value = typename std::remove_cvref_t<decltype(column)>::value_type;
+      if (column.size() > n) {
+        column.erase(column.begin() + static_cast<std::ptrdiff_t>(n), column.end());
+      }
+      while (column.size() < n) {
+        column.push_back(detail::makeValue<Value>());
+      }
+    });
+  }
+  void clear() {
+    forEachColumn([](auto& column) {
+      column.clear();
+    });
+  }
+  // 追加一个默认值的行
+  Row emplace_back() {
+    resize(size() + 1);
+    return Row{this, size() - 1};
+  }
+  void push_back(const T& obj) {
+    emplace_back().assign(obj);
+  }
+
+  Row operator[](size_t row) {
+    return Row{this, row};
+  }
+  ConstRow operator[](size_t row) const {
+    return ConstRow{this, row};
+  }
+  RowIterator<false> begin() {
+    return {this, 0};
+  }
+  RowIterator<false> end() {
+    return {this, size()};
+  }
+  RowIterator<true> begin() const {
+    return {this, 0};
+  }
+  RowIterator<true> end() const {
+    return {this, size()};
+  }
+
+  // 第 I 个字段的所有值, 按行号连续存放; 可以修改元素, 不能改变长度
+  template <size_t I>
+  std::span<ColumnType<I>> column() requires (!std::same_as<ColumnType<I>, bool>) {
+    return std::get<I>(columns_);
+  }
+  template <size_t I>
+  std::span<const ColumnType<I>> column() const requires (!std::same_as<ColumnType<I>, bool>) {
+    return std::get<I>(columns_);
+  }
+  template <detail::FixedString Name>
+  auto column() {
+    return column<detail::fieldIndexOf<T, Name>()>();
+  }
+  template <detail::FixedString Name>
+  auto column() const {
+    return column<detail::fieldIndexOf<T, Name>()>();
+  }
+  // 包括 bool 字段
+  template <size_t I>
+  const std::vector<ColumnType<I>>& columnVector() const {
+    return std::get<I>(columns_);
+  }
+
+private:
+  template <typename> friend struct detail::SnapshotTraits;
+
+  template <typename F>
+  void forEachColumn(F&& f) {
+    std::apply([&f](auto&... columns) {
+      (f(columns), ...);
+    }, columns_);
+  }
+
+  typename detail::ColumnTuple<T>::type columns_;
+};  // class Columns
+
+namespace detail {
+
+// 格式与 std::vector<T> 相同; 已有的行被原地复用, 多余的行在最后删除
+// 元素不是对象时与 T 一样返回 ERR_TYPE
+template <concepts::Reflected T>
+struct CompoundDeserializeTraits<Columns<T>> {
+  template <concepts::ParserElem ElemType>
+  static Result deserialize(Columns<T>& columns, ElemType node) {
+    if (!node.isValid()) {
+      columns.clear();
+      return Result::SUCCESS;
+    }
+    if constexpr (concepts::ElementCountElem<ElemType>) {
+      columns.reserve(node.getElementCount());
+    }
+    size_t row{0};
+    CHECK_SUCCESS_OR_RETURN(node.forEachElement([&columns, &row](ElemType item) {
+      if (row == columns.size()) {
+        columns.emplace_back();
+      }
+      return deserializeRow(columns[row++], item);
+    }));
+    columns.resize(row);
+    return Result::SUCCESS;
+  }
+
+private:
+  using Row = typename Columns<T>::Row;
+  // 与 CompoundDeserializeTraits<T> 共用字段分发, 字段值写到这一行的各列中
+  using RowDispatch = ReflectedFieldDispatch<T, const Row, CompoundDeserializeTraits>;
+  friend RowDispatch;
+
+  template <concepts::ParserElem ElemType>
+  static Result deserializeRow(const Row& row, const ElemType& item) {
+    return RowDispatch::deserialize(row, item);
+  }
+
+  template <size_t I, concepts::ParserElem ElemType>
+  static Result deserializeField(const Row& row, const ElemType& elem) {
+    using Value = FieldType<T, I>;
+    decltype(auto) cell = row.template get<I>();
+    if constexpr (std::is_reference_v<decltype(cell)>) {
+      return CompoundDeserializeTraits<Value>::deserialize(cell, elem);
+    } else {
+      // std::vector<bool> 的元素是代理对象
+      Value value = cell;
+      CHECK_SUCCESS_OR_RETURN(CompoundDeserializeTraits<Value>::deserialize(value, elem));
+      cell = value;
+      return Result::SUCCESS;
+    }
+  }
+};  // struct CompoundDeserializeTraits<Columns<T>>
+
+// 输出为对象数组, 与 std::vector<T> 相同
+template <concepts::Reflected T>
+struct SerializeTraits<Columns<T>> {
+  template <concepts::Writer W>
+  static void serialize(const Columns<T>& columns, W& writer) {
+    writer.beginArray(columns.size());
+    for (auto row : columns) {
+      writer.beginObject(T::_field_count_);
+      serializeRow(row, writer, std::make_index_sequence<T::_field_count_>{});
+      writer.endObject();
+    }
+    writer.endArray();
+  }
+
+private:
+  template <concepts::Writer W, size_t... Is>
+  static void serializeRow(const typename Columns<T>::ConstRow& row, W& writer, std::index_sequence<Is...>) {
+    ((writer.key(T::template FIELD<T&, Is>::name()),
+      SerializeTraits<FieldType<T, Is>>::serialize(row.template get<Is>(), writer)), ...);
+  }
+};  // struct SerializeTraits<Columns<T>>
+
+// 快照中按列保存: 行数之后依次是每一列的所有值
+template <concepts::Reflected T>
+struct SnapshotTraits<Columns<T>> {
+  static constexpr uint64_t fingerprint(uint64_t h, int depth) {
+    return SnapshotTraits<T>::fingerprint(mixFingerprint(h, "columns"), depth);
+  }
+  static void save(const Columns<T>& columns, SnapshotWriter& writer) {
+    writer.write(static_cast<uint64_t>(columns.size()));
+    std::apply([&writer](const auto&... column) {
+      (saveColumn(column, writer), ...);
+    }, columns.columns_);
+  }
+  static Result load(Columns<T>& columns, SnapshotReader& reader) {
+    uint64_t size{0};
+    if (!reader.read(size)) {
+      return Result::ERR_ILL_FORMED;
+    }
+    Result res{Result::SUCCESS};
+    std::apply([&reader, &res, size](auto&... column) {
+      (... && (res = loadColumn(column, reader, size), res == Result::SUCCESS));
+    }, columns.columns_);
+    if (res != Result::SUCCESS) {
+      columns.clear();
+    }
+    return res;
+  }
+
+private:
+  template <typename Value>
+  static void saveColumn(const std::vector<Value>& column, SnapshotWriter& writer) {
+    for (const auto& value : column) {
+      SnapshotTraits<Value>::save(value, writer);
+    }
+  }
+  template <typename Value>
+  static Result loadColumn(std::vector<Value>& column, SnapshotReader& reader, uint64_t size) {
+    column.clear();
+    // 损坏的快照中 size 可能很大, 预留的空间不超过剩余的字节数
+    column.reserve(std::min<uint64_t>(size, reader.remaining()));
+    for (uint64_t i = 0; i < size; ++i) {
+      Value value = makeValue<Value>();
+      CHECK_SUCCESS_OR_RETURN(SnapshotTraits<Value>::load(value, reader));
+      column.push_back(std::move(value));
+    }
+    return Result::SUCCESS;
+  }
+};  // struct SnapshotTraits<Columns<T>>
+
+}  // namespace detail
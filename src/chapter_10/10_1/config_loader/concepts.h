@@ -13,11 +13,15 @@
 #pragma once
 
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <string>
+#include <string_view>
 
 #include "enable_parser.h"
 #include "result.h"
+#include "value_kind.h"
 
 namespace concepts {
 
@@ -36,6 +40,7 @@ template <typename ElemType>
 concept ParserElem = requires(const ElemType& elem) {
   { elem.isValid() } -> std::convertible_to<bool>;
   { elem.getValueText() } -> std::same_as<std::optional<std::string>>;
+  // 返回的指针至少在文档下一次 parse() 或析构之前有效, 同一文档中的多个 key 互不覆盖
   { elem.getKeyName() } -> std::same_as<const char*>;
   { elem.toChildElem("") } -> std::same_as<ElemType>;
   requires requires(Result(&f)(ElemType)) {
@@ -44,6 +49,59 @@ concept ParserElem = requires(const ElemType& elem) {
   { elem.serializeToString() } -> std::same_as<std::string>;
 };
 
+// 以下为 ParserElem 可选的类型化取值接口, 后端原生实现后可以省掉 getValueText() 的字符串往返
+// 节点不是对应类型时返回 std::nullopt, 调用方回退到 getValueText()
+template <typename ElemType>
+concept Int64ValueElem = requires(const ElemType& elem) {
+  { elem.getInt64Value() } -> std::same_as<std::optional<int64_t>>;
+};
+
+template <typename ElemType>
+concept Uint64ValueElem = requires(const ElemType& elem) {
+  { elem.getUint64Value() } -> std::same_as<std::optional<uint64_t>>;
+};
+
+template <typename ElemType>
+concept DoubleValueElem = requires(const ElemType& elem) {
+  { elem.getDoubleValue() } -> std::same_as<std::optional<double>>;
+};
+
+template <typename ElemType>
+concept BoolValueElem = requires(const ElemType& elem) {
+  { elem.getBoolValue() } -> std::same_as<std::optional<bool>>;
+};
+
+// string_view 指向后端内部的存储, 生命周期同 parser
+template <typename ElemType>
+concept StringValueElem = requires(const ElemType& elem) {
+  { elem.getStringValue() } -> std::same_as<std::optional<std::string_view>>;
+};
+
+// 后端知道值的原始类型时提供, std::variant 据此直接选择备选类型, 不用逐个尝试
+template <typename ElemType>
+concept ValueKindElem = requires(const ElemType& elem) {
+  { elem.getValueKind() } -> std::same_as<ValueKind>;
+};
+
+// 数组和对象的元素个数, 不需要解析元素; 其他节点返回 0
+// 只有不用额外扫描就能得到个数的后端才提供(如 JsonPullParser 不提供)
+template <typename ElemType>
+concept ElementCountElem = requires(const ElemType& elem) {
+  { elem.getElementCount() } -> std::same_as<size_t>;
+};
+
+// 节点在输入中的原始文本(不拷贝), 生命周期同 parser 和输入内容; 没有提供时可以用 serializeToString()
+template <typename ElemType>
+concept RawTextElem = requires(const ElemType& elem) {
+  { elem.getRawText() } -> std::same_as<std::optional<std::string_view>>;
+};
+
+// key 不以 '\0' 结尾的后端可以提供 getKeyView(), 避免 getKeyName() 的拷贝
+template <typename ElemType>
+concept KeyViewElem = requires(const ElemType& elem) {
+  { elem.getKeyView() } -> std::same_as<std::string_view>;
+};
+
 
 template <typename P>
 concept Parser = detail::enable_parser<P> || requires(P p, std::string_view content) {
@@ -58,6 +116,22 @@ static_assert(Parser<detail::UnsupportedParser>);
 template <typename T>
 concept Arithmetic = std::is_arithmetic_v<T>;
 
+// 序列化的输出端, 对象和数组开始时给出元素个数(有的格式需要先写长度)
+template <typename W>
+concept Writer = requires(W w, std::string_view text, size_t size) {
+  w.beginObject(size);
+  w.key(text);
+  w.endObject();
+  w.beginArray(size);
+  w.endArray();
+  w.writeNull();
+  w.writeBool(true);
+  w.writeInt64(int64_t{0});
+  w.writeUint64(uint64_t{0});
+  w.writeDouble(0.0);
+  w.writeString(text);
+};
+
 
 }  // namespace concepts
 
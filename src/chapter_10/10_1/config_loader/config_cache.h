@@ -0,0 +1,276 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/16 00:32:50
+# Desc   : 进程内的配置缓存: 同一个文件(路径、设备号、inode、大小、修改时间都相同)按同一个类型加载时共享一份结果
+########################################################################
+*/
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <typeindex>
+#include <unordered_map>
+
+#if __has_include(<sys/stat.h>)
+#include <sys/stat.h>
+#define CONFIG_LOADER_HAS_STAT 1
+#else
+#define CONFIG_LOADER_HAS_STAT 0
+#endif
+
+#include "loader.h"
+
+/*
+// 多个子系统各自加载同一个文件, 只有第一次解析, 之后都拿到同一个对象
+std::shared_ptr<const Config> config;
+if (loadJSON2ObjCached(config, "conf/config.json") != Result::SUCCESS) { ... }
+*/
+
+// 文件的标识, 任何一项变化都视为不同的文件; 大小和修改时间(纳秒)都不变的改写无法发现
+struct FileIdentity {
+  uint64_t device{0};
+  uint64_t inode{0};
+  uint64_t size{0};
+  int64_t mtime_ns{0};
+
+  bool operator==(const FileIdentity&) const = default;
+};  // struct FileIdentity
+
+struct ConfigCacheStats {
+  uint64_t hits{0};
+  uint64_t misses{0};       // 包括文件不存在和加载失败
+  uint64_t evictions{0};
+  size_t size{0};           // 当前的条目数
+  size_t capacity{0};
+};  // struct ConfigCacheStats
+
+namespace detail {
+
+// 文件不存在或不能访问时返回 std::nullopt; 没有 stat() 的平台 device 和 inode 为 0
+inline std::optional<FileIdentity> fileIdentity(std::string_view path) {
+#if CONFIG_LOADER_HAS_STAT
+  struct stat st {};
+  if (::stat(std::filesystem::path(path).c_str(), &st) != 0) {
+    return std::nullopt;
+  }
+#if defined(__APPLE__)
+  const auto& mtime = st.st_mtimespec;
+#else
+  const auto& mtime = st.st_mtim;
+#endif
+  return FileIdentity{
+    .device = static_cast<uint64_t>(st.st_dev),
+    .inode = static_cast<uint64_t>(st.st_ino),
+    .size = static_cast<uint64_t>(st.st_size),
+    .mtime_ns = static_cast<int64_t>(mtime.tv_sec) * 1'000'000'000 + mtime.tv_nsec,
+  };
+#else
+  std::error_code ec;
+  const std::filesystem::path fs_path{path};
+  const auto size = std::filesystem::file_size(fs_path, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  const auto mtime = std::filesystem::last_write_time(fs_path, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  return FileIdentity{
+    .size = static_cast<uint64_t>(size),
+    .mtime_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(mtime.time_since_epoch()).count(),
+  };
+#endif
+}
+
+// 只区分类型, 同一个文件按不同的类型或后端加载时各自缓存
+template <typename T, typename P>
+struct ConfigCacheTag {};
+
+// 按条目数限制大小, 超出时淘汰最久没有使用的条目; 被淘汰的对象在持有者释放后才析构
+// 同一个文件同时未命中时各自解析, 先插入的结果被所有调用者共享
+class ConfigCache {
+public:
+  static constexpr size_t kDefaultCapacity = 64;
+
+  static ConfigCache& instance() {
+    static ConfigCache cache;
+    return cache;
+  }
+
+  ConfigCache(const ConfigCache&) = delete;
+  ConfigCache& operator=(const ConfigCache&) = delete;
+
+  template <typename T, concepts::Parser P>
+  Result load(std::shared_ptr<const T>& out, std::string_view path) {
+    const auto identity = fileIdentity(path);
+    if (!identity.has_value()) {
+      countMiss();
+      return Result::ERR_READ_FILE;
+    }
+    const KeyView key{path, *identity, typeid(ConfigCacheTag<T, P>)};
+    if (auto cached = find(key); cached != nullptr) {
+      out = std::static_pointer_cast<const T>(std::move(cached));
+      return Result::SUCCESS;
+    }
+    auto obj = std::make_shared<T>();
+    Result res;
+    try {
+      res = loadJSON2Obj<P>(*obj, path);
+    } catch (const FileReadError&) {
+      res = Result::ERR_READ_FILE;
+    }
+    if (res != Result::SUCCESS) {
+      return res;
+    }
+    std::shared_ptr<const T> loaded = std::move(obj);
+    // 加载期间文件被改写时不缓存, 避免把新的内容记在旧的标识下
+    if (fileIdentity(path) == identity) {
+      loaded = std::static_pointer_cast<const T>(insert(key, loaded));
+    }
+    out = std::move(loaded);
+    return Result::SUCCESS;
+  }
+
+  // 缩小时立即淘汰多出的条目; 0 表示不缓存
+  void setCapacity(size_t capacity) {
+    std::lock_guard lock{mutex_};
+    capacity_ = capacity;
+    evictOverflow();
+  }
+
+  ConfigCacheStats stats() const {
+    std::lock_guard lock{mutex_};
+    return {
+      .hits = hits_,
+      .misses = misses_,
+      .evictions = evictions_,
+      .size = lru_.size(),
+      .capacity = capacity_,
+    };
+  }
+
+  // 清空条目和计数
+  void clear() {
+    std::lock_guard lock{mutex_};
+    index_.clear();
+    lru_.clear();
+    hits_ = misses_ = evictions_ = 0;
+  }
+
+private:
+  struct KeyView {
+    std::string_view path;
+    FileIdentity identity;
+    std::type_index type;
+
+    bool operator==(const KeyView&) const = default;
+  };  // struct KeyView
+
+  struct KeyHash {
+    size_t operator()(const KeyView& key) const {
+      size_t h = std::hash<std::string_view>{}(key.path);
+      for (uint64_t value : {key.identity.device, key.identity.inode, key.identity.size,
+                             static_cast<uint64_t>(key.identity.mtime_ns), static_cast<uint64_t>(key.type.hash_code())}) {
+        h = (h ^ value) * 0x9e3779b97f4a7c15ULL;
+      }
+      return h ^ (h >> 29);
+    }
+  };  // struct KeyHash
+
+  struct Entry {
+    std::string path;  // index_ 的 key 指向这里, list 的节点不会移动
+    KeyView key;
+    std::shared_ptr<const void> value;
+  };  // struct Entry
+
+  ConfigCache() = default;
+
+  std::shared_ptr<const void> find(const KeyView& key) {
+    std::lock_guard lock{mutex_};
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      ++misses_;
+      return nullptr;
+    }
+    ++hits_;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->value;
+  }
+
+  void countMiss() {
+    std::lock_guard lock{mutex_};
+    ++misses_;
+  }
+
+  // 返回缓存中的对象: 别的线程已经插入了同一个 key 时返回它的结果
+  std::shared_ptr<const void> insert(const KeyView& key, std::shared_ptr<const void> value) {
+    std::lock_guard lock{mutex_};
+    if (capacity_ == 0) {
+      return value;
+    }
+    if (auto it = index_.find(key); it != index_.end()) {
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return it->second->value;
+    }
+    Entry& entry = lru_.emplace_front(Entry{.path = std::string(key.path), .key = key, .value = std::move(value)});
+    entry.key.path = entry.path;
+    index_.emplace(entry.key, lru_.begin());
+    evictOverflow();
+    return entry.value;
+  }
+
+  void evictOverflow() {
+    while (lru_.size() > capacity_) {
+      index_.erase(lru_.back().key);
+      lru_.pop_back();
+      ++evictions_;
+    }
+  }
+
+  mutable std::mutex mutex_;
+  std::list<Entry> lru_;  // 最近使用的在前
+  std::unordered_map<KeyView, std::list<Entry>::iterator, KeyHash> index_;
+  size_t capacity_{kDefaultCapacity};
+  uint64_t hits_{0};
+  uint64_t misses_{0};
+  uint64_t evictions_{0};
+};  // class ConfigCache
+
+}  // namespace detail
+
+// 命中时直接返回缓存的对象, 不读取文件内容(只 stat 一次); 未命中时解析并在成功后缓存, 只缓存成功的结果
+// 返回的对象不可修改, 由所有调用者共享; 文件变化后旧的条目不再命中, 由 LRU 淘汰
+// 读不到文件时返回 ERR_READ_FILE, 反序列化抛出的其他异常(如 std::bad_alloc)继续抛出, 不缓存
+template <concepts::Parser P = detail::JsonCppParser, typename T>
+Result loadJSON2ObjCached(std::shared_ptr<const T>& obj, std::string_view path) {
+  return detail::ConfigCache::instance().load<T, P>(obj, path);
+}
+
+// 默认容量为 ConfigCache::kDefaultCapacity 个文件
+inline void setConfigCacheCapacity(size_t capacity) {
+  detail::ConfigCache::instance().setCapacity(capacity);
+}
+
+inline ConfigCacheStats configCacheStats() {
+  return detail::ConfigCache::instance().stats();
+}
+
+inline void clearConfigCache() {
+  detail::ConfigCache::instance().clear();
+}
@@ -0,0 +1,221 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:34:51
+# Desc   : 配置热加载: 后台线程监听文件变化并重新加载, 读取方通过原子操作拿到一致的快照, 不会被加载阻塞
+########################################################################
+*/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#if __has_include(<sys/inotify.h>)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#define CONFIG_LOADER_HAS_INOTIFY 1
+#else
+#include <condition_variable>
+#define CONFIG_LOADER_HAS_INOTIFY 0
+#endif
+
+#include "loader.h"
+
+/*
+ConfigHandle<Config> handle{"conf/config.json"};
+if (handle.reload() != Result::SUCCESS) { ... }  // 首次加载
+handle.watch();                                 // 文件变化后自动重新加载
+
+// 请求处理线程, 每个线程一个 Reader
+auto reader = handle.reader();
+const Config& config = reader.get();
+*/
+template <typename T, concepts::Parser P = detail::JsonCppParser>
+class ConfigHandle {
+public:
+  using Snapshot = std::shared_ptr<const T>;
+
+  // 缓存最近一次拿到的快照, 配置没有变化时 get() 只有一次原子读(version), 不修改共享的引用计数;
+  // 不是线程安全的, 每个读线程各自持有一个
+  class Reader {
+  public:
+    explicit Reader(const ConfigHandle& handle) : handle_(&handle) {}
+    // 返回的引用在下一次调用 get() 之前有效; 首次加载成功之前不能调用
+    const T& get() {
+      const uint64_t version = handle_->version_.load(std::memory_order_acquire);
+      if (version != version_) {
+        snapshot_ = handle_->get();
+        version_ = version;
+      }
+      return *snapshot_;
+    }
+    // 持有返回值即可在 get() 之后继续使用旧的快照
+    const Snapshot& snapshot() {
+      get();
+      return snapshot_;
+    }
+  private:
+    const ConfigHandle* handle_;
+    uint64_t version_{0};
+    Snapshot snapshot_;
+  };  // class Reader
+
+  explicit ConfigHandle(std::string path) : path_(std::move(path)) {}
+  ConfigHandle(const ConfigHandle&) = delete;
+  ConfigHandle& operator=(const ConfigHandle&) = delete;
+
+  // 首次加载成功之前返回 nullptr
+  Snapshot get() const {
+    return current_.load(std::memory_order_acquire);
+  }
+  Reader reader() const {
+    return Reader{*this};
+  }
+  // 每发布一次新配置加 1, 首次加载成功后为 1
+  uint64_t version() const {
+    return version_.load(std::memory_order_acquire);
+  }
+
+  // 在调用线程中加载, 成功后发布; 失败时保留原来的配置并返回错误码
+  // 读不到文件时返回 ERR_READ_FILE, 反序列化抛出的其他异常(如 std::bad_alloc)继续抛出, 同样保留原来的配置
+  // 上上次发布的配置已经没有读者持有时, 原地覆盖它(复用 vector、string 等已分配的空间), 否则加载到新的对象
+  Result reload() {
+    std::lock_guard lock{reload_mutex_};
+    std::shared_ptr<T> target;
+    if (retired_ != nullptr && retired_.use_count() == 1) {
+      // 与读者释放引用时的 release 配对, 读者对旧配置的读取都发生在覆盖之前
+      std::atomic_thread_fence(std::memory_order_acquire);
+      target = std::move(retired_);
+    } else {
+      target = std::make_shared<T>();
+    }
+    Result res;
+    try {
+      // 被监视的文件随时可能被原地改写, 不能 mmap(截断时访问映射会触发 SIGBUS)
+      res = loadJSON2Obj<P>(*target, [this] {
+        return detail::get_file_content(path_, detail::FileContent::kNoMmap);
+      });
+    } catch (const FileReadError&) {
+      // 文件被替换的瞬间可能打不开, 等下一次变化
+      res = Result::ERR_READ_FILE;
+    }
+    last_result_.store(res, std::memory_order_relaxed);
+    if (res != Result::SUCCESS) {
+      // 没有发布过, 下次还可以复用
+      retired_ = std::move(target);
+      return res;
+    }
+    current_.store(target, std::memory_order_release);
+    version_.fetch_add(1, std::memory_order_release);
+    retired_ = std::exchange(published_, std::move(target));
+    return res;
+  }
+  // 最近一次 reload() 的结果, 用于观察后台加载是否失败; 后台线程中反序列化抛出其他异常时为 ERR_EXTRACTING_FIELD
+  Result lastReloadResult() const {
+    return last_result_.load(std::memory_order_relaxed);
+  }
+
+  // 启动后台线程监听文件所在目录, 文件被写入或被替换(rename)后重新加载;
+  // 不支持 inotify 的平台每隔 poll_interval 检查一次修改时间
+  void watch(std::chrono::milliseconds poll_interval = std::chrono::milliseconds{100}) {
+    if (watcher_.joinable()) {
+      return;
+    }
+    watcher_ = std::jthread([this, poll_interval](std::stop_token stop) {
+      watchLoop(stop, poll_interval);
+    });
+  }
+
+private:
+#if CONFIG_LOADER_HAS_INOTIFY
+  void watchLoop(std::stop_token stop, std::chrono::milliseconds poll_interval) {
+    const std::filesystem::path path{path_};
+    auto dir = path.parent_path();
+    if (dir.empty()) {
+      dir = ".";
+    }
+    const auto file_name = path.filename().string();
+    int fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+      return;
+    }
+    // 监听目录而不是文件: 编辑器和发布工具通常写临时文件再 rename, 原文件的 watch 会失效
+    if (::inotify_add_watch(fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+      ::close(fd);
+      return;
+    }
+    alignas(inotify_event) char buffer[4096];
+    while (!stop.stop_requested()) {
+      pollfd pfd{fd, POLLIN, 0};
+      if (::poll(&pfd, 1, static_cast<int>(poll_interval.count())) <= 0) {
+        continue;
+      }
+      bool changed{false};
+      ssize_t n;
+      while ((n = ::read(fd, buffer, sizeof(buffer))) > 0) {
+        for (char* p = buffer; p < buffer + n;) {
+          auto* event = reinterpret_cast<inotify_event*>(p);
+          changed = changed || (event->len > 0 && file_name == event->name);
+          p += sizeof(inotify_event) + event->len;
+        }
+      }
+      if (changed) {
+        reloadInBackground();
+      }
+    }
+    ::close(fd);
+  }
+#else
+  void watchLoop(std::stop_token stop, std::chrono::milliseconds poll_interval) {
+    std::error_code ec;
+    auto last_write = std::filesystem::last_write_time(path_, ec);
+    std::mutex mutex;
+    std::condition_variable_any cv;
+    std::unique_lock lock{mutex};
+    while (!stop.stop_requested()) {
+      // 只用于可以被 stop 打断的等待
+      cv.wait_for(lock, stop, poll_interval, [] { return false; });
+      auto write_time = std::filesystem::last_write_time(path_, ec);
+      if (!ec && write_time != last_write) {
+        last_write = write_time;
+        reloadInBackground();
+      }
+    }
+  }
+#endif
+
+  // 异常逃出 jthread 会终止进程; 保留原来的配置, 等下一次变化
+  void reloadInBackground() noexcept {
+    try {
+      reload();
+    } catch (...) {
+      last_result_.store(Result::ERR_EXTRACTING_FIELD, std::memory_order_relaxed);
+    }
+  }
+
+  const std::string path_;
+  std::atomic<Snapshot> current_;
+  std::atomic<uint64_t> version_{0};
+  std::atomic<Result> last_result_{Result::SUCCESS};
+  std::mutex reload_mutex_;
+  // 以下两个只在持有 reload_mutex_ 时访问
+  std::shared_ptr<T> published_;  // 当前发布的配置(可写的引用)
+  std::shared_ptr<T> retired_;    // 上一次发布的配置, 等读者都释放后复用
+  // 最后一个成员, 析构时最先停止并等待后台线程退出
+  std::jthread watcher_;
+};  // class ConfigHandle
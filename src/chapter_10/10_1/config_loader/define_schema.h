@@ -19,6 +19,7 @@
 
 #include "concepts.h"
 #include "macro.h"
+#include "memory_resource.h"
 #include "result.h"
 
 
@@ -44,8 +45,9 @@ REPEAT_2(FIELD_EACH, 0, (double)x, (double)y)
     FIELD_EACH(0, (double)x) FIELD_EACH(1, (double)y)
 */
 
+// 字段用 makeValue 初始化: 数值类型为 0, std::pmr 的字符串和容器使用当前线程的 memory_resource
 #define FIELD_EACH(i, arg) \
-  PAIR(arg); \
+  PAIR(arg) = ::detail::makeValue<decltype(STRIP(arg))>(); \
   template <typename T> \
   struct FIELD<T, i> { \
     T& obj; \
@@ -56,7 +58,7 @@ REPEAT_2(FIELD_EACH, 0, (double)x, (double)y)
 /*
 FIELD_EACH(1, (double)y)
   =>
-    double y;
+    double y = ::detail::makeValue<decltype(y)>();
     template <typename T>
     struct FIELD<T, 1> {
       T& obj;
@@ -12,6 +12,7 @@
 */
 #pragma once
 
+#include "type/associative_container.h"
 #include "type/concepts_primitive.h"
 #include "type/concepts_reflected.h"
 #include "type/sequence_container.h"
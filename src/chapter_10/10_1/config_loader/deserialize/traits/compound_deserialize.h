@@ -12,8 +12,10 @@
 */
 #pragma once
 
+#include <cstddef>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <variant>
 
 #include "../../concepts.h"
@@ -22,4 +24,33 @@
 namespace  detail {
 template <typename T>
 struct CompoundDeserializeTraits;
+
+// 对象成员的 key
+template <concepts::ParserElem ElemType>
+std::string_view getKeyView(const ElemType& elem) {
+  if constexpr (concepts::KeyViewElem<ElemType>) {
+    return elem.getKeyView();
+  } else {
+    const char* key = elem.getKeyName();
+    return key == nullptr ? std::string_view{} : std::string_view(key);
+  }
+}
+
+// 节点不是对象时(后端能给出类型的话)返回 false
+template <concepts::ParserElem ElemType>
+bool isObjectNode(const ElemType& node) {
+  if constexpr (concepts::ValueKindElem<ElemType>) {
+    return node.getValueKind() == ValueKind::kObject;
+  } else {
+    return true;
+  }
+}
+
+// 后端能直接给出元素个数时一次分配好, 不用在追加的过程中反复扩容
+template <typename Container, concepts::ParserElem ElemType>
+void reserveElements(Container& container, const ElemType& node) {
+  if constexpr (concepts::ElementCountElem<ElemType> && requires { container.reserve(size_t{}); }) {
+    container.reserve(node.getElementCount());
+  }
+}
 }  // namespace detail
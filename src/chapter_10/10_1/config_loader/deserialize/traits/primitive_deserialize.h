@@ -13,11 +13,16 @@
 #pragma once
 
 #include <algorithm>
+#include <charconv>
+#include <concepts>
 #include <optional>
-#include <sstream>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
 
 #include "../../concepts.h"
+#include "../../interned_string.h"
 #include "../../result.h"
 
 namespace detail {
@@ -40,28 +45,120 @@ struct PrimitiveDeserializeTraits;
 
 template <concepts::Arithmetic Number>
 struct PrimitiveDeserializeTraits<Number> {
+  // 后端提供了类型化接口时直接取值, 否则回退到 getValueText()
+  template <concepts::ParserElem Elem>
+  static Result deserialize(Number& num, const Elem& node) {
+    if constexpr (std::floating_point<Number> && concepts::DoubleValueElem<Elem>) {
+      if (auto value = node.getDoubleValue(); value.has_value()) {
+        num = static_cast<Number>(*value);
+        return Result::SUCCESS;
+      }
+    } else if constexpr (std::signed_integral<Number> && concepts::Int64ValueElem<Elem>) {
+      if (auto value = node.getInt64Value(); value.has_value()) {
+        return assignInRange(num, *value);
+      }
+    } else if constexpr (std::unsigned_integral<Number> && concepts::Uint64ValueElem<Elem>) {
+      if (auto value = node.getUint64Value(); value.has_value()) {
+        return assignInRange(num, *value);
+      }
+    }
+    // 带引号的数字(如 "y": "2")直接从输入中的文本解析, 不用先拷贝出来
+    if constexpr (concepts::StringValueElem<Elem>) {
+      if (auto view = node.getStringValue(); view.has_value()) {
+        return deserialize(num, *view);
+      }
+    }
+    return deserialize(num, node.getValueText());
+  }
+
   static Result deserialize(Number& num, std::optional<std::string> value_text) {
     if (!value_text.has_value()) {
       return Result::ERR_EXTRACTING_FIELD;
     }
-    // 对 int8_t和 uint8_t 特殊处理，免得被当成 char 类型
-    if constexpr(std::is_same_v<Number, int8_t> || std::is_same_v<Number, uint8_t>) {
-      num = std::stol(*value_text, nullptr, is_hex(*value_text) ? 16 : 10);
+    return deserialize(num, std::string_view(*value_text));
+  }
+
+  // 先按十进制解析, 失败后整数类型再按 is_hex 判断是否为十六进制; 必须完整消耗 text, 溢出也视为失败
+  // 浮点数不按十六进制重试, 否则溢出的 1e400 会被读成 0x1e400; 溢出后也不重试
+  // 与原来的 stringstream 一样接受首尾的空白和开头的 '+'(from_chars 不接受)
+  // int8_t 和 uint8_t 走整数分支, 不会被当成 char 类型
+  static Result deserialize(Number& num, std::string_view text) {
+    text = trimNumber(text);
+    const std::errc ec = fromChars(num, text, 10);
+    if (ec == std::errc{}) {
       return Result::SUCCESS;
-    } else {
-      std::stringstream ss;
-      ss << *value_text;
-      if (is_hex(*value_text)) {
-        ss << std::hex;
+    }
+    if constexpr (std::integral<Number>) {
+      if (ec != std::errc::result_out_of_range && is_hex(text)) {
+        if (text.size() >= 2 && (text[1] == 'x' || text[1] == 'X')) {
+          text.remove_prefix(2);
+        }
+        if (fromChars(num, text, 16) == std::errc{}) {
+          return Result::SUCCESS;
+        }
       }
-      ss >> num;
-      return ss.fail() ? Result::ERR_EXTRACTING_FIELD : Result::SUCCESS;
     }
+    return Result::ERR_EXTRACTING_FIELD;
+  }
+
+private:
+  static std::string_view trimNumber(std::string_view text) {
+    constexpr std::string_view kSpaces = " \t\n\r\f\v";
+    const auto begin = text.find_first_not_of(kSpaces);
+    if (begin == std::string_view::npos) {
+      return {};
+    }
+    text = text.substr(begin, text.find_last_not_of(kSpaces) - begin + 1);
+    // 只去掉一个 '+', "+-1" 和 "++1" 仍然失败
+    if (text.size() > 1 && text.front() == '+' && text[1] != '+' && text[1] != '-') {
+      text.remove_prefix(1);
+    }
+    return text;
+  }
+
+  // 解析失败时不修改 num; 没有完整消耗 text 时返回 std::errc::invalid_argument
+  static std::errc fromChars(Number& num, std::string_view text, int base) {
+    const char* end = text.data() + text.size();
+    Number value{};
+    std::from_chars_result res;
+    if constexpr (std::floating_point<Number>) {
+      res = std::from_chars(text.data(), end, value, std::chars_format::general);
+    } else {
+      res = std::from_chars(text.data(), end, value, base);
+    }
+    if (res.ec != std::errc{}) {
+      return res.ec;
+    }
+    if (res.ptr != end) {
+      return std::errc::invalid_argument;
+    }
+    num = value;
+    return std::errc{};
+  }
+
+  template <std::integral Integer>
+  static Result assignInRange(Number& num, Integer value) {
+    if (!std::in_range<Number>(value)) {
+      return Result::ERR_EXTRACTING_FIELD;
+    }
+    num = static_cast<Number>(value);
+    return Result::SUCCESS;
   }
 };  // struct PrimitiveDeserializeTraits<Number>
 
 template <>
 struct PrimitiveDeserializeTraits<bool> {
+  template <concepts::ParserElem Elem>
+  static Result deserialize(bool& value, const Elem& node) {
+    if constexpr (concepts::BoolValueElem<Elem>) {
+      if (auto bool_value = node.getBoolValue(); bool_value.has_value()) {
+        value = *bool_value;
+        return Result::SUCCESS;
+      }
+    }
+    return deserialize(value, node.getValueText());
+  }
+
   static Result deserialize(bool& value, std::optional<std::string> value_text) {
     if (!value_text.has_value()) {
       return Result::ERR_EXTRACTING_FIELD;
@@ -79,16 +176,54 @@ struct PrimitiveDeserializeTraits<bool> {
   }
 };  // struct PrimitiveDeserializeTraits<bool>
 
+// 包括 std::pmr::string
+template <typename Alloc>
+struct PrimitiveDeserializeTraits<std::basic_string<char, std::char_traits<char>, Alloc>> {
+  using String = std::basic_string<char, std::char_traits<char>, Alloc>;
+
+  template <concepts::ParserElem Elem>
+  static Result deserialize(String& value, const Elem& node) {
+    if constexpr (concepts::StringValueElem<Elem>) {
+      if (auto view = node.getStringValue(); view.has_value()) {
+        value.assign(*view);  // 复用 value 已有的空间
+        return Result::SUCCESS;
+      }
+    }
+    return deserialize(value, node.getValueText());
+  }
+
+  static Result deserialize(String& value, std::optional<std::string> value_text) {
+    if (!value_text.has_value()) {
+      return Result::ERR_EXTRACTING_FIELD;
+    }
+    if constexpr (std::same_as<String, std::string>) {
+      value = std::move(*value_text);
+    } else {
+      value.assign(*value_text);  // 保留 value 的 allocator
+    }
+    return Result::SUCCESS;
+  }
+};  // struct PrimitiveDeserializeTraits<String>
+
+// 驻留到当前线程的 InternTable 中, 见 ScopedInternTable
 template <>
-struct PrimitiveDeserializeTraits<std::string> {
-  static Result deserialize(std::string& value, std::optional<std::string> value_text) {
+struct PrimitiveDeserializeTraits<InternedString> {
+  template <concepts::ParserElem Elem>
+  static Result deserialize(InternedString& value, const Elem& node) {
+    if constexpr (concepts::StringValueElem<Elem>) {
+      if (auto view = node.getStringValue(); view.has_value()) {
+        value = currentInternTable().intern(*view);
+        return Result::SUCCESS;
+      }
+    }
+    auto value_text = node.getValueText();
     if (!value_text.has_value()) {
       return Result::ERR_EXTRACTING_FIELD;
     }
-    value = std::move(*value_text);
+    value = currentInternTable().intern(*value_text);
     return Result::SUCCESS;
   }
-};  // struct PrimitiveDeserializeTraits<std::string>
+};  // struct PrimitiveDeserializeTraits<InternedString>
 
 }  // namespace detail
 
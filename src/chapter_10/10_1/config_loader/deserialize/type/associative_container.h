@@ -0,0 +1,212 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:50:19
+# Desc   : 以字符串为 key 的关联容器, 由 json 对象的成员反序列化得到
+########################################################################
+*/
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <version>
+
+#if __cpp_lib_flat_map
+#include <flat_map>
+#endif
+#if __cpp_lib_flat_set
+#include <flat_set>
+#endif
+
+#include "../traits/compound_deserialize.h"
+#include "../../concepts.h"
+#include "../../memory_resource.h"
+#include "../../result.h"
+
+namespace detail {
+
+// std::map、std::unordered_map: 覆盖原有的内容, 已有的 key 连同 value 的节点一起复用(value 原地反序列化),
+// 没有出现的 key 删除; 重复的 key 与 DEFINE_SCHEMA 的字段一样只取第一个
+template <typename Map, typename Key = Map::key_type, typename T = Map::mapped_type>
+  requires std::constructible_from<Key, std::string_view>
+struct NodeMapDeserialize {
+  static Result deserialize(Map& map, concepts::ParserElem auto node) {
+    if (!node.isValid()) {
+      map.clear();
+      return Result::SUCCESS;
+    }
+    if (!isObjectNode(node)) {
+      return Result::ERR_TYPE;
+    }
+    Map old = std::move(map);
+    map.clear();
+    reserveElements(map, node);
+    return node.forEachElement([&map, &old](concepts::ParserElem auto member) {
+      Key key(getKeyView(member));
+      T* value{nullptr};
+      if (auto handle = old.empty() ? typename Map::node_type{} : old.extract(key); !handle.empty()) {
+        value = &map.insert(std::move(handle)).position->second;
+      } else {
+        auto [it, inserted] = constructValue<T>([&map, &key](auto&&... args) {
+          return map.try_emplace(std::move(key), std::forward<decltype(args)>(args)...);
+        });
+        if (!inserted) {
+          return Result::SUCCESS;
+        }
+        value = &it->second;
+      }
+      return CompoundDeserializeTraits<T>::deserialize(*value, member);
+    });
+  }
+};  // struct NodeMapDeserialize
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+struct CompoundDeserializeTraits<std::map<Key, T, Compare, Alloc>>
+    : NodeMapDeserialize<std::map<Key, T, Compare, Alloc>> {
+};  // struct CompoundDeserializeTraits<std::map<Key, T, Compare, Alloc>>
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
+struct CompoundDeserializeTraits<std::unordered_map<Key, T, Hash, KeyEqual, Alloc>>
+    : NodeMapDeserialize<std::unordered_map<Key, T, Hash, KeyEqual, Alloc>> {
+};  // struct CompoundDeserializeTraits<std::unordered_map<Key, T, Hash, KeyEqual, Alloc>>
+
+#if __cpp_lib_flat_map
+// 按成员的顺序把 key 写入底层的 key 容器(复用它的空间), 按 key 稳定排序后去重; 重复的 key 与 std::map 一样只取第一个,
+// 后面的不构造也不反序列化 value; 最后用 std::sorted_unique 直接接管两个容器, 不再排序
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+  requires std::constructible_from<Key, std::string_view>
+struct CompoundDeserializeTraits<std::flat_map<Key, T, Compare, KeyContainer, MappedContainer>> {
+  using Map = std::flat_map<Key, T, Compare, KeyContainer, MappedContainer>;
+  static constexpr size_t kSkipped = std::numeric_limits<size_t>::max();
+
+  template <concepts::ParserElem ElemType>
+  static Result deserialize(Map& map, ElemType node) {
+    if (!node.isValid()) {
+      map.clear();
+      return Result::SUCCESS;
+    }
+    if (!isObjectNode(node)) {
+      return Result::ERR_TYPE;
+    }
+    const Compare comp = map.key_comp();
+    auto containers = std::move(map).extract();
+    auto& keys = containers.keys;
+    auto& values = containers.values;
+    keys.clear();
+    values.clear();
+    reserveElements(keys, node);
+    std::vector<ElemType> members;
+    reserveElements(members, node);
+    CHECK_SUCCESS_OR_RETURN(node.forEachElement([&keys, &members](ElemType member) {
+      keys.emplace_back(getKeyView(member));
+      members.push_back(member);
+      return Result::SUCCESS;
+    }));
+
+    // 稳定排序后, 相同的 key 中排在最前面的就是最先出现的; slots[i] 为第 i 个成员的 value 在结果中的下标
+    const size_t count = keys.size();
+    std::vector<size_t> order(count);
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::ranges::stable_sort(order, [&keys, &comp](size_t a, size_t b) {
+      return comp(keys[a], keys[b]);
+    });
+    std::vector<size_t> slots(count, kSkipped);
+    size_t unique_count{0};
+    for (size_t r = 0; r < count; ++r) {
+      if (r == 0 || comp(keys[order[r - 1]], keys[order[r]])) {
+        slots[order[r]] = unique_count++;
+      }
+    }
+    permute(keys, order);
+    size_t out{0};
+    for (size_t r = 0; r < count; ++r) {
+      if (out == 0 || comp(keys[out - 1], keys[r])) {
+        if (out != r) {
+          keys[out] = std::move(keys[r]);
+        }
+        ++out;
+      }
+    }
+    keys.erase(keys.begin() + static_cast<std::ptrdiff_t>(out), keys.end());
+
+    if constexpr (requires { values.reserve(unique_count); }) {
+      values.reserve(unique_count);
+    }
+    for (size_t i = 0; i < unique_count; ++i) {
+      constructValue<T>([&values](auto&&... args) -> T& {
+        return values.emplace_back(std::forward<decltype(args)>(args)...);
+      });
+    }
+    // 按成员的顺序反序列化, 出错时与 std::map 一样返回第一个错误
+    Result res{Result::SUCCESS};
+    for (size_t i = 0; i < count && res == Result::SUCCESS; ++i) {
+      if (slots[i] != kSkipped) {
+        res = CompoundDeserializeTraits<T>::deserialize(values[slots[i]], members[i]);
+      }
+    }
+    map = Map(std::sorted_unique, std::move(keys), std::move(values), comp);
+    return res;
+  }
+
+private:
+  // 原地重排, 之后 keys[r] 为原来的 keys[order[r]]; 按置换的环移动, order 被改写
+  static void permute(KeyContainer& keys, std::vector<size_t>& order) {
+    for (size_t i = 0; i < order.size(); ++i) {
+      if (order[i] == i) {
+        continue;
+      }
+      Key first = std::move(keys[i]);
+      size_t j = i;
+      while (order[j] != i) {
+        const size_t next = order[j];
+        keys[j] = std::move(keys[next]);
+        order[j] = j;
+        j = next;
+      }
+      keys[j] = std::move(first);
+      order[j] = j;
+    }
+  }
+};  // struct CompoundDeserializeTraits<std::flat_map<Key, T, Compare, KeyContainer, MappedContainer>>
+#endif
+
+#if __cpp_lib_flat_set
+// 由 json 数组反序列化, 元素写入底层容器后由 flat_set 的构造函数排序、去重
+template <typename Key, typename Compare, typename KeyContainer>
+struct CompoundDeserializeTraits<std::flat_set<Key, Compare, KeyContainer>> {
+  using Set = std::flat_set<Key, Compare, KeyContainer>;
+
+  static Result deserialize(Set& set, concepts::ParserElem auto node) {
+    if (!node.isValid()) {
+      set.clear();
+      return Result::SUCCESS;
+    }
+    auto keys = std::move(set).extract();
+    keys.clear();
+    reserveElements(keys, node);
+    auto res = node.forEachElement([&keys](concepts::ParserElem auto item) {
+      auto& key = constructValue<Key>([&keys](auto&&... args) -> Key& {
+        return keys.emplace_back(std::forward<decltype(args)>(args)...);
+      });
+      return CompoundDeserializeTraits<Key>::deserialize(key, item);
+    });
+    set = Set(std::move(keys), set.key_comp());
+    return res;
+  }
+};  // struct CompoundDeserializeTraits<std::flat_set<Key, Compare, KeyContainer>>
+#endif
+
+}  // namespace detail
@@ -24,7 +24,7 @@ struct CompoundDeserializeTraits<T> {
     if (!node.isValid()) {
       return Result::ERR_MISSING_FIELD;
     } else {
-      return PrimitiveDeserializeTraits<T>::deserialize(obj, node.getValueText());
+      return PrimitiveDeserializeTraits<T>::deserialize(obj, node);
     }
   }
 };  // struct CompoundDeserializeTraits<T>
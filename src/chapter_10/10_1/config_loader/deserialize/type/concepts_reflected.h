@@ -12,25 +12,97 @@
 */
 #pragma once
 
+#include <array>
+#include <bitset>
+#include <string_view>
+#include <utility>
+
 #include "../traits/compound_deserialize.h"
 #include "../../concepts.h"
+#include "../../define_schema.h"
+#include "../../field_index.h"
+#include "../../enable_parser.h"
 
 namespace detail {
 
-template <concepts::Reflected T>
-struct CompoundDeserializeTraits<T> {
-  static Result deserialize(T& obj, concepts::ParserElem auto node) {
+// T 的字段分发: 按后端和字段数选择逐个查找字段(toChildElem)或遍历一遍成员; 两种方式对同一个输入的结果相同
+// 重复的 key 只取第一个. JsonCppParser 例外: jsoncpp 解析时后面的值覆盖前面的, DOM 中只剩最后一个,
+// 两种方式看到的都是它, 所以结果仍然与字段数无关
+// Target 是字段值所在的位置(T 本身, 或 Columns<T> 的一行), Fields::deserializeField<I>(target, elem) 反序列化第 I 个字段
+template <concepts::Reflected T, typename Target, typename Fields>
+struct ReflectedFieldDispatch {
+  template <concepts::ParserElem ElemType>
+  static Result deserialize(Target& target, const ElemType& node) {
     if (!node.isValid()) {
       return Result::ERR_MISSING_FIELD;
     }
-    return forEachField(obj, [&node](auto&& field_info) {
-      decltype(auto) field_name = field_info.name();
-      decltype(auto) value = field_info.value();
-      return CompoundDeserializeTraits<std::remove_cvref_t<decltype(value)>>
-        ::deserialize(value, node.toChildElem(field_name));
-    });
+    // 在选择逐字段查找还是遍历成员之前检查, 两种方式对非对象节点返回同样的错误码
+    if (!isObjectNode(node)) {
+      return Result::ERR_TYPE;
+    }
+    if constexpr (enable_member_walk<ElemType> || T::_field_count_ >= member_walk_min_fields<T>) {
+      return deserializeByMemberWalk(target, node);
+    } else {
+      return deserializeByField(target, node, std::make_index_sequence<T::_field_count_>{});
+    }
+  }
+
+private:
+  template <concepts::ParserElem ElemType, size_t... Is>
+  static Result deserializeByField(Target& target, const ElemType& node, std::index_sequence<Is...>) {
+    Result res{Result::SUCCESS};
+    static_cast<void>((... && ((res = Fields::template deserializeField<Is>(
+        target, node.toChildElem(T::template FIELD<T&, Is>::name()))) == Result::SUCCESS)));
+    return res;
+  }
+
+  // 下标 -> 字段的跳转表
+  template <concepts::ParserElem ElemType, size_t... Is>
+  static constexpr auto makeFieldDeserializers(std::index_sequence<Is...>) {
+    return std::array<Result (*)(Target&, const ElemType&), sizeof...(Is)>{
+        &Fields::template deserializeField<Is, ElemType>...};
+  }
+
+  // 遍历一遍对象成员, key 经 FieldIndex 的完美哈希得到字段下标后直接跳转到对应字段, 未知的 key 直接跳过;
+  // 没有出现的字段用无效节点反序列化, 与逐个 toChildElem() 的结果保持一致(必选字段返回 ERR_MISSING_FIELD)
+  template <concepts::ParserElem ElemType>
+  static Result deserializeByMemberWalk(Target& target, const ElemType& node) {
+    static constexpr auto deserializers =
+        makeFieldDeserializers<ElemType>(std::make_index_sequence<T::_field_count_>{});
+    std::bitset<T::_field_count_> seen;
+    CHECK_SUCCESS_OR_RETURN(node.forEachElement([&target, &seen](ElemType member) {
+      const size_t index = FieldIndex<T>::find(getKeyView(member));
+      // 重复的 key 只取第一个, 之后的不再覆盖
+      if (index == FieldIndex<T>::npos || seen[index]) {
+        return Result::SUCCESS;
+      }
+      seen.set(index);
+      return deserializers[index](target, member);
+    }));
+    for (size_t index = 0; index < T::_field_count_; ++index) {
+      if (!seen[index]) {
+        CHECK_SUCCESS_OR_RETURN(deserializers[index](target, ElemType{}));
+      }
+    }
+    return Result::SUCCESS;
+  }
+};  // struct ReflectedFieldDispatch
+
+template <concepts::Reflected T>
+struct CompoundDeserializeTraits<T> {
+  template <concepts::ParserElem ElemType>
+  static Result deserialize(T& obj, ElemType node) {
+    return ReflectedFieldDispatch<T, T, CompoundDeserializeTraits>::deserialize(obj, node);
+  }
+
+private:
+  friend struct ReflectedFieldDispatch<T, T, CompoundDeserializeTraits>;
+
+  template <size_t I, concepts::ParserElem ElemType>
+  static Result deserializeField(T& obj, const ElemType& elem) {
+    decltype(auto) value = typename T::template FIELD<T&, I>{obj}.value();
+    return CompoundDeserializeTraits<std::remove_cvref_t<decltype(value)>>::deserialize(value, elem);
   }
 };  // struct CompoundDeserializeTraits<T>
 
 }  // namespace detail
-
@@ -12,34 +12,169 @@
 */
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <iterator>
 #include <list>
+#include <type_traits>
 #include <vector>
 
 #include "../traits/compound_deserialize.h"
+#include "../../concepts.h"
+#include "../../enable_parser.h"
+#include "../../interned_string.h"
+#include "../../memory_resource.h"
+#include "../../parallel.h"
 #include "../../result.h"
 
 namespace detail {
 
+// 覆盖容器原有的内容: 已有的元素原地反序列化(复用元素内部已分配的空间), 不够时在末尾追加, 多余的删除
 template <typename Container, typename ValueType = Container::value_type>
 struct SeqContainerDeserialize {
   static Result deserialize(Container& container, concepts::ParserElem auto node) {
     if (!node.isValid()) {
+      container.clear();
       return Result::SUCCESS;
     }
-    return node.forEachElement([&container](concepts::ParserElem auto item) {
-      ValueType value;
-      CHECK_SUCCESS_OR_RETURN(CompoundDeserializeTraits<ValueType>::deserialize(value, item));
-      container.emplace_back(std::move(value));
-      return Result::SUCCESS;
-    });
+    reserveElements(container, node);
+    auto it = container.begin();
+    CHECK_SUCCESS_OR_RETURN(node.forEachElement([&container, &it](concepts::ParserElem auto item) {
+      if (it == container.end()) {
+        if constexpr (uses_pmr_allocator<Container>) {
+          container.emplace_back();  // 元素使用容器的 allocator
+        } else {
+          constructValue<ValueType>([&container](auto&&... args) -> decltype(auto) {
+            return container.emplace_back(std::forward<decltype(args)>(args)...);
+          });
+        }
+        it = std::prev(container.end());
+      }
+      if constexpr (std::is_reference_v<decltype(*it)>) {
+        return CompoundDeserializeTraits<ValueType>::deserialize(*it++, item);
+      } else {
+        // std::vector<bool> 的元素是代理对象
+        ValueType value = *it;
+        CHECK_SUCCESS_OR_RETURN(CompoundDeserializeTraits<ValueType>::deserialize(value, item));
+        *it++ = value;
+        return Result::SUCCESS;
+      }
+    }));
+    container.erase(it, container.end());
+    return Result::SUCCESS;
   }
 };  // struct SeqContainerDeserialize
 
-template <typename T>
-struct CompoundDeserializeTraits<std::vector<T>> : SeqContainerDeserialize<std::vector<T>>{
-};  // struct CompoundDeserializeTraits<std::vector<T>>
+// 包括 std::pmr::vector 和 std::pmr::list
+// 元素个数不少于 ParallelDeserializeOptions::min_elements 时, 把元素按下标分成连续的几段, 由线程池原地反序列化到
+// 预先 resize 好的位置; 出错时返回下标最小的错误, 与逐个反序列化的结果相同; 元素抛出的异常也按下标比较,
+// 等所有段都结束后在调用线程重新抛出
+// 以下情况逐个反序列化: 节点不能跨线程读取、std::vector<bool>、使用 memory_resource 分配(不一定是线程安全的)
+template <typename T, typename Alloc>
+struct CompoundDeserializeTraits<std::vector<T, Alloc>> {
+  using Container = std::vector<T, Alloc>;
+  // 每个线程分到的段数, 段越多各线程的负载越平均
+  static constexpr size_t kChunksPerThread = 4;
+
+  template <concepts::ParserElem ElemType>
+  static Result deserialize(Container& container, ElemType node) {
+    if constexpr (enable_parallel_deserialize<ElemType> && concepts::ElementCountElem<ElemType>
+        && !std::same_as<T, bool> && !uses_pmr_allocator<Container>) {
+      if (node.isValid() && !t_in_parallel_task && t_memory_resource == nullptr) {
+        const size_t threads = parallelDeserializeThreads();
+        if (threads > 1) {
+          const size_t count = node.getElementCount();
+          if (count > 0 && count >= g_parallel_min_elements.load(std::memory_order_relaxed)) {
+            return parallelDeserialize(container, node, count, threads);
+          }
+        }
+      }
+    }
+    return SeqContainerDeserialize<Container>::deserialize(container, node);
+  }
+
+private:
+  template <concepts::ParserElem ElemType>
+  static Result parallelDeserialize(Container& container, ElemType node, size_t count, size_t threads) {
+    std::vector<ElemType> items;
+    items.reserve(count);
+    CHECK_SUCCESS_OR_RETURN(node.forEachElement([&items](ElemType item) {
+      items.push_back(item);
+      return Result::SUCCESS;
+    }));
+    container.resize(items.size());
+
+    const size_t chunk_count = std::min(items.size(), threads * kChunksPerThread);
+    std::vector<Result> results(chunk_count, Result::SUCCESS);
+    std::vector<std::exception_ptr> exceptions(chunk_count);
+    std::atomic<size_t> failed_chunk{chunk_count};  // 出错或抛出异常的段中最小的下标
+    InternTable* intern_table = t_intern_table;
+    auto fail = [&failed_chunk](size_t chunk) {
+      size_t failed = failed_chunk.load(std::memory_order_relaxed);
+      while (chunk < failed && !failed_chunk.compare_exchange_weak(failed, chunk, std::memory_order_relaxed)) {
+      }
+    };
+    // parallelFor 要求 task 不抛出异常: 异常留在这一段中, 不能让调用线程在其他线程还在使用 task 时退出
+    auto task = [&](size_t chunk) {
+      ScopedInternTable scope{intern_table};
+      // 前面的段已经出错时不再执行
+      if (chunk > failed_chunk.load(std::memory_order_relaxed)) {
+        return;
+      }
+      const size_t end = (chunk + 1) * items.size() / chunk_count;
+      try {
+        for (size_t i = chunk * items.size() / chunk_count; i < end; ++i) {
+          auto res = CompoundDeserializeTraits<T>::deserialize(container[i], items[i]);
+          if (res != Result::SUCCESS) {
+            results[chunk] = res;
+            fail(chunk);
+            return;
+          }
+        }
+      } catch (...) {
+        exceptions[chunk] = std::current_exception();
+        fail(chunk);
+      }
+    };
+    ThreadPool::instance().parallelFor(chunk_count, threads, task);
+    for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+      if (exceptions[chunk] != nullptr) {
+        std::rethrow_exception(exceptions[chunk]);
+      }
+      CHECK_SUCCESS_OR_RETURN(results[chunk]);
+    }
+    return Result::SUCCESS;
+  }
+};  // struct CompoundDeserializeTraits<std::vector<T, Alloc>>
+
+template <typename T, typename Alloc>
+struct CompoundDeserializeTraits<std::list<T, Alloc>> : SeqContainerDeserialize<std::list<T, Alloc>>{
+};  // struct CompoundDeserializeTraits<std::list<T, Alloc>>
+
+template <typename T, typename Alloc>
+struct CompoundDeserializeTraits<std::deque<T, Alloc>> : SeqContainerDeserialize<std::deque<T, Alloc>>{
+};  // struct CompoundDeserializeTraits<std::deque<T, Alloc>>
 
-template <typename T>
-struct CompoundDeserializeTraits<std::list<T>> : SeqContainerDeserialize<std::list<T>>{
-};  // struct CompoundDeserializeTraits<std::list<T>>
+// 元素个数必须正好是 N, 不分配内存
+template <typename T, size_t N>
+struct CompoundDeserializeTraits<std::array<T, N>> {
+  static Result deserialize(std::array<T, N>& arr, concepts::ParserElem auto node) {
+    if (!node.isValid()) {
+      return Result::ERR_MISSING_FIELD;
+    }
+    size_t count{0};
+    CHECK_SUCCESS_OR_RETURN(node.forEachElement([&arr, &count](concepts::ParserElem auto item) {
+      if (count == N) {
+        return Result::ERR_TYPE;
+      }
+      return CompoundDeserializeTraits<T>::deserialize(arr[count++], item);
+    }));
+    return count == N ? Result::SUCCESS : Result::ERR_TYPE;
+  }
+};  // struct CompoundDeserializeTraits<std::array<T, N>>
 }  // namespace detail
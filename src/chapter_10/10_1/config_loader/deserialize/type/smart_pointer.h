@@ -13,6 +13,7 @@
 #pragma once
 
 #include "../traits/compound_deserialize.h"
+#include "../../memory_resource.h"
 #include "../../result.h"
 #include <memory>
 
@@ -21,12 +22,26 @@ template <typename SP>
 struct SmartPointerDeserialize {
   static Result deserialize(SP& sp, concepts::ParserElem auto node) {
     if (!node.isValid()) {
+      sp.reset();
       return Result::SUCCESS;
     }
     using ElementType = typename SP::element_type;
-    ElementType value;
-    CHECK_SUCCESS_OR_RETURN(CompoundDeserializeTraits<ElementType>::deserialize(value, node));
-    sp.reset(new ElementType(std::move(value)));
+    // 独占的 unique_ptr 原地反序列化; shared_ptr 指向的对象可能还被别处引用(如 ConfigHandle 发布的旧配置), 总是新建
+    if constexpr (std::same_as<SP, std::unique_ptr<ElementType>>) {
+      if (sp != nullptr) {
+        return CompoundDeserializeTraits<ElementType>::deserialize(*sp, node);
+      }
+    }
+    // 在最终的位置构造对象, 成功后才替换 sp, 失败时 sp 不变;
+    // shared_ptr 用 allocate_shared, 对象和控制块只分配一次
+    SP value;
+    if constexpr (std::same_as<SP, std::shared_ptr<ElementType>>) {
+      value = makeSharedValue<ElementType>();
+    } else {
+      value = makeUniqueValue<ElementType>();
+    }
+    CHECK_SUCCESS_OR_RETURN(CompoundDeserializeTraits<ElementType>::deserialize(*value, node));
+    sp = std::move(value);
     return Result::SUCCESS;
   }
 };  // struct SmartPointerDeserialize
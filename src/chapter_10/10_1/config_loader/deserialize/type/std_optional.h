@@ -13,18 +13,29 @@
 #pragma once
 
 #include "../traits/compound_deserialize.h"
+#include "../../memory_resource.h"
 
 namespace detail {
 template <typename T>
 struct CompoundDeserializeTraits<std::optional<T>> {
+  // 字段缺失时清空; 已有值时原地反序列化
   static Result deserialize(std::optional<T>& obj, concepts::ParserElem auto node) {
     if (!node.isValid()) {
+      obj.reset();
       return Result::SUCCESS;
     }
-    T value;
-    CHECK_SUCCESS_OR_RETURN(CompoundDeserializeTraits<T>::deserialize(value, node));
-    obj.emplace(std::move(value));
-    return Result::SUCCESS;
+    const bool had_value = obj.has_value();
+    if (!had_value) {
+      // 直接在 optional 中构造, 失败时再清空
+      constructValue<T>([&obj](auto&&... args) -> T& {
+        return obj.emplace(std::forward<decltype(args)>(args)...);
+      });
+    }
+    auto res = CompoundDeserializeTraits<T>::deserialize(*obj, node);
+    if (res != Result::SUCCESS && !had_value) {
+      obj.reset();
+    }
+    return res;
   }
 };  // struct CompoundDeserializeTraits<std::optional<T>>
 
@@ -12,25 +12,113 @@
 */
 #pragma once
 
+#include <algorithm>
+#include <concepts>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
 #include "../traits/compound_deserialize.h"
+#include "../../concepts.h"
+#include "../../memory_resource.h"
 
 namespace detail {
+
+// 备选类型 T 与节点类型 kind 的匹配程度: 2 类型一致, 1 可以转换(整数之于浮点数, 或者无法判断的自定义类型), 0 不匹配
+template <typename T>
+struct AlternativeKind {
+  static constexpr int match(ValueKind kind) {
+    if constexpr (std::same_as<T, bool>) {
+      return kind == ValueKind::kBool ? 2 : 0;
+    } else if constexpr (std::integral<T>) {
+      return kind == ValueKind::kInteger ? 2 : 0;
+    } else if constexpr (std::floating_point<T>) {
+      return kind == ValueKind::kReal ? 2 : kind == ValueKind::kInteger ? 1 : 0;
+    } else if constexpr (std::convertible_to<const T&, std::string_view>) {
+      return kind == ValueKind::kString ? 2 : 0;
+    } else if constexpr (concepts::Reflected<T> || requires { typename T::mapped_type; }) {
+      return kind == ValueKind::kObject ? 2 : 0;
+    } else if constexpr (std::ranges::range<T>) {
+      return kind == ValueKind::kArray ? 2 : 0;
+    } else {
+      return 1;
+    }
+  }
+};  // struct AlternativeKind<T>
+
+template <typename T>
+struct AlternativeKind<std::optional<T>> : AlternativeKind<T> {
+};  // struct AlternativeKind<std::optional<T>>
+template <typename T>
+struct AlternativeKind<std::unique_ptr<T>> : AlternativeKind<T> {
+};  // struct AlternativeKind<std::unique_ptr<T>>
+template <typename T>
+struct AlternativeKind<std::shared_ptr<T>> : AlternativeKind<T> {
+};  // struct AlternativeKind<std::shared_ptr<T>>
+
+template <typename... Ts>
+struct AlternativeKind<std::variant<Ts...>> {
+  static constexpr int match(ValueKind kind) {
+    return std::max({AlternativeKind<Ts>::match(kind)...});
+  }
+};  // struct AlternativeKind<std::variant<Ts...>>
+
 template <typename... Ts>
 struct CompoundDeserializeTraits<std::variant<Ts...>> {
+  // 后端能给出节点类型时(ValueKindElem), 只尝试与之匹配的备选类型: 先类型一致的, 再可以转换的, 各自按声明顺序;
+  // 没有匹配的备选类型(如 "2" 之于 std::variant<int, double>)或者后端不能给出类型时, 按声明顺序逐个尝试
   static Result deserialize(std::variant<Ts...>& obj, concepts::ParserElem auto node) {
     if (!node.isValid()) {
       return Result::ERR_MISSING_FIELD;
     }
-    auto build_variant = [&obj, &node]<typename T>(T&& value) {
-      auto res = CompoundDeserializeTraits<T>::deserialize(value, node);
-      if (res == Result::SUCCESS) {
-        obj.template emplace<T>(std::move(value));
+    constexpr auto indexes = std::index_sequence_for<Ts...>{};
+    if constexpr (concepts::ValueKindElem<decltype(node)>) {
+      const ValueKind kind = node.getValueKind();
+      bool tried{false};
+      for (int rank : {2, 1}) {
+        if (tryAlternatives(obj, node, indexes, [kind, rank]<typename T>(std::type_identity<T>) {
+              return AlternativeKind<T>::match(kind) == rank;
+            }, tried)) {
+          return Result::SUCCESS;
+        }
       }
-      return res;
-    };
-    bool success{false};
-    ((success = (build_variant(Ts{}) == Result::SUCCESS)) || ...);
-    return success ? Result::SUCCESS : Result::ERR_TYPE;
+      if (tried) {
+        return Result::ERR_TYPE;
+      }
+    }
+    bool tried{false};
+    return tryAlternatives(obj, node, indexes, []<typename T>(std::type_identity<T>) { return true; }, tried)
+        ? Result::SUCCESS : Result::ERR_TYPE;
+  }
+
+private:
+  // 依次尝试 accept 的备选类型, 直到成功
+  template <size_t... Is, typename Accept>
+  static bool tryAlternatives(std::variant<Ts...>& obj, auto& node, std::index_sequence<Is...>,
+      Accept&& accept, bool& tried) {
+    return ((accept(std::type_identity<Ts>{})
+        && (tried = true, deserializeAlternative<Is>(obj, node) == Result::SUCCESS)) || ...);
+  }
+
+  // 当前保存的就是第 I 个备选类型时原地反序列化; 否则直接在 variant 中构造, 失败时恢复原来的值
+  template <size_t I>
+  static Result deserializeAlternative(std::variant<Ts...>& obj, auto& node) {
+    using T = std::variant_alternative_t<I, std::variant<Ts...>>;
+    if (obj.index() == I) {
+      return CompoundDeserializeTraits<T>::deserialize(*std::get_if<I>(&obj), node);
+    }
+    std::variant<Ts...> saved(std::move(obj));
+    auto& value = constructValue<T>([&obj](auto&&... args) -> T& {
+      return obj.template emplace<I>(std::forward<decltype(args)>(args)...);
+    });
+    auto res = CompoundDeserializeTraits<T>::deserialize(value, node);
+    if (res != Result::SUCCESS) {
+      obj = std::move(saved);
+    }
+    return res;
   }
 };  // struct CompoundDeserializeTraits<std::variant<Ts...>>
 
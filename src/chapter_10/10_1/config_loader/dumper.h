@@ -0,0 +1,35 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:32:40
+# Desc   : 把对象输出为配置文件的内容, 与 loader.h 相对应
+########################################################################
+*/
+#pragma once
+
+#include <string>
+
+#include "serialize/json_writer.h"
+#include "serialize/msgpack_writer.h"
+#include "serialize/serialize_traits.h"
+
+// out 原有的内容会被覆盖, 已分配的空间会复用; 输出可以被 loadJSON2Obj 重新加载
+template <typename T>
+void dumpObj2JSON(const T& obj, std::string& out) {
+  out.clear();
+  detail::JsonWriter writer{out};
+  detail::SerializeTraits<T>::serialize(obj, writer);
+}
+
+// 输出 MessagePack 编码, 可以被 loadMsgPack2Obj 重新加载
+template <typename T>
+void dumpObj2MsgPack(const T& obj, std::string& out) {
+  out.clear();
+  detail::MsgPackWriter writer{out};
+  detail::SerializeTraits<T>::serialize(obj, writer);
+}
@@ -12,6 +12,8 @@
 */
 #pragma once
 
+#include <cstddef>
+
 namespace detail {
 
 struct UnsupportedParser {
@@ -21,4 +23,18 @@ template <typename P>
 inline constexpr bool enable_parser = false;
 template <>
 inline constexpr bool enable_parser<detail::UnsupportedParser> = true;
+
+// 反序列化 Reflected 类型时, 是否遍历一遍对象的成员再按 key 分发到字段, 而不是逐个字段 toChildElem()
+// 适用于按需扫描输入的后端, 一次遍历可以读完整个对象
+template <typename ElemType>
+inline constexpr bool enable_member_walk = false;
+
+// 构建了 DOM 的后端逐个字段查找的次数随字段数增长(jsoncpp 每次都是一次 std::map 查找),
+// 字段数不少于该值时同样遍历一遍对象的成员; 可以针对某个 Reflected 类型特化
+template <typename T>
+inline constexpr size_t member_walk_min_fields = 16;
+
+// 节点是否可以被多个线程同时读取(解析结束后不再修改的 DOM 或 tape), 是则大数组可以分段并行反序列化
+template <typename ElemType>
+inline constexpr bool enable_parallel_deserialize = false;
 }  // namespace detail
@@ -0,0 +1,180 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:26:08
+# Desc   : 编译期根据 DEFINE_SCHEMA 的字段名生成完美哈希表, 把 key 映射到字段下标
+########################################################################
+*/
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+#include "concepts.h"
+
+namespace detail {
+
+// 只取长度和首、中、尾三个字符, 有字段名在这几个位置上都相同时(如 field_1, field_2)整个 key 参与计算
+constexpr uint32_t hashFieldName(std::string_view key, bool full) {
+  constexpr uint32_t kPrime = 0x01000193;
+  uint32_t h = (0x811c9dc5 ^ static_cast<uint32_t>(key.size())) * kPrime;
+  if (key.empty()) {
+    return h;
+  }
+  if (full) {
+    for (char c : key) {
+      h = (h ^ static_cast<unsigned char>(c)) * kPrime;
+    }
+  } else {
+    h = (h ^ static_cast<unsigned char>(key.front())) * kPrime;
+    h = (h ^ static_cast<unsigned char>(key[key.size() / 2])) * kPrime;
+    h = (h ^ static_cast<unsigned char>(key.back())) * kPrime;
+  }
+  return h ^ (h >> 15);
+}
+
+// 用桶的偏移量 displacement 重新打散, 得到最终的槽位
+constexpr uint32_t displaceFieldHash(uint32_t h, uint32_t displacement) {
+  h ^= displacement * 0x9e3779b9;
+  h ^= h >> 16;
+  h *= 0x85ebca6b;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35;
+  return h ^ (h >> 16);
+}
+
+constexpr size_t powerOfTwoAtLeast(size_t n) {
+  size_t result{1};
+  while (result < n) {
+    result *= 2;
+  }
+  return result;
+}
+
+// hash and displace: key 先按哈希值分到桶中, 再为每个桶找一个偏移量, 使桶内的 key 都落到空闲的槽位,
+// 槽位数为不小于 2 * N 的 2 的幂
+template <size_t N>
+struct FieldHashTable {
+  static constexpr uint16_t kEmpty = UINT16_MAX;
+  static constexpr size_t kBucketCount = powerOfTwoAtLeast(N / 2 + 1);
+  std::array<uint16_t, powerOfTwoAtLeast(2 * N)> slots{};
+  std::array<uint16_t, kBucketCount> displacements{};
+  bool full{false};
+
+  constexpr size_t slotOf(std::string_view key) const {
+    const uint32_t h = hashFieldName(key, full);
+    return displaceFieldHash(h, displacements[h & (kBucketCount - 1)]) & (slots.size() - 1);
+  }
+};  // struct FieldHashTable
+
+template <size_t N>
+constexpr bool needFullFieldHash(const std::array<std::string_view, N>& names) {
+  for (size_t i = 0; i < N; ++i) {
+    for (size_t j = i + 1; j < N; ++j) {
+      if (hashFieldName(names[i], false) == hashFieldName(names[j], false)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+template <size_t N>
+constexpr FieldHashTable<N> buildFieldHashTable(const std::array<std::string_view, N>& names) {
+  using Table = FieldHashTable<N>;
+  Table table;
+  table.full = needFullFieldHash(names);
+  table.slots.fill(Table::kEmpty);
+  std::array<uint32_t, N> hashes{};
+  std::array<size_t, Table::kBucketCount> bucket_sizes{};
+  for (size_t i = 0; i < N; ++i) {
+    hashes[i] = hashFieldName(names[i], table.full);
+    ++bucket_sizes[hashes[i] & (Table::kBucketCount - 1)];
+  }
+  // 先处理 key 多的桶, 这时空闲槽位多, 容易找到偏移量
+  std::array<size_t, Table::kBucketCount> order{};
+  for (size_t b = 0; b < Table::kBucketCount; ++b) {
+    order[b] = b;
+  }
+  for (size_t i = 0; i < Table::kBucketCount; ++i) {
+    for (size_t j = i + 1; j < Table::kBucketCount; ++j) {
+      if (bucket_sizes[order[j]] > bucket_sizes[order[i]]) {
+        std::swap(order[i], order[j]);
+      }
+    }
+  }
+  for (size_t bucket : order) {
+    if (bucket_sizes[bucket] == 0) {
+      break;
+    }
+    bool placed{false};
+    for (uint32_t displacement = 0; displacement < Table::kEmpty && !placed; ++displacement) {
+      std::array<size_t, N> taken{};
+      size_t taken_count{0};
+      placed = true;
+      for (size_t i = 0; i < N && placed; ++i) {
+        if ((hashes[i] & (Table::kBucketCount - 1)) != bucket) {
+          continue;
+        }
+        const size_t slot = displaceFieldHash(hashes[i], displacement) & (table.slots.size() - 1);
+        for (size_t t = 0; t < taken_count; ++t) {
+          placed = placed && taken[t] != slot;
+        }
+        placed = placed && table.slots[slot] == Table::kEmpty;
+        taken[taken_count++] = slot;
+      }
+      if (placed) {
+        table.displacements[bucket] = static_cast<uint16_t>(displacement);
+        for (size_t i = 0; i < N; ++i) {
+          if ((hashes[i] & (Table::kBucketCount - 1)) == bucket) {
+            table.slots[displaceFieldHash(hashes[i], displacement) & (table.slots.size() - 1)] =
+                static_cast<uint16_t>(i);
+          }
+        }
+      }
+    }
+    if (!placed) {
+      // 字段名重复(哈希值相同)时找不到偏移量, 编译期报错
+      throw "duplicate field name in DEFINE_SCHEMA";
+    }
+  }
+  return table;
+}
+
+template <concepts::Reflected T, size_t... Is>
+constexpr std::array<std::string_view, sizeof...(Is)> makeFieldNames(std::index_sequence<Is...>) {
+  return {std::string_view(T::template FIELD<T, Is>::name())...};
+}
+
+template <concepts::Reflected T>
+inline constexpr auto field_names = makeFieldNames<T>(std::make_index_sequence<T::_field_count_>{});
+
+template <concepts::Reflected T>
+inline constexpr auto field_hash_table = buildFieldHashTable(field_names<T>);
+
+// 按 key 查找 T 的字段下标, 一次哈希加一次字符串比较
+template <concepts::Reflected T>
+struct FieldIndex {
+  static constexpr size_t npos = static_cast<size_t>(-1);
+  static constexpr size_t size = T::_field_count_;
+
+  // 不是 T 的字段时返回 npos
+  static constexpr size_t find(std::string_view key) {
+    constexpr const auto& table = field_hash_table<T>;
+    const auto index = table.slots[table.slotOf(key)];
+    return index != table.kEmpty && field_names<T>[index] == key ? index : npos;
+  }
+  static constexpr std::string_view name(size_t index) {
+    return field_names<T>[index];
+  }
+};  // struct FieldIndex
+
+}  // namespace detail
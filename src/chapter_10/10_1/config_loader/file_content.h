@@ -0,0 +1,187 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:23:49
+# Desc   : 文件内容: 默认用 read() 读入内存, 超过阈值的普通文件可以只读 mmap
+########################################################################
+*/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <limits>
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#define CONFIG_LOADER_HAS_MMAP 1
+#else
+#include <fstream>
+#include <iterator>
+#define CONFIG_LOADER_HAS_MMAP 0
+#endif
+
+// 打开或读取文件失败, 如 loadJSON2Obj(obj, path) 读不到 path 时抛出
+class FileReadError : public std::runtime_error {
+public:
+  using std::runtime_error::runtime_error;
+};  // class FileReadError
+
+namespace detail {
+
+// 只能移动, 通过 view() 或隐式转换为 std::string_view 访问内容, 内容在对象析构前有效
+class FileContent {
+public:
+  // 不使用 mmap
+  static constexpr size_t kNoMmap = std::numeric_limits<size_t>::max();
+
+  // 大小不小于 mmap_min_size 的普通文件使用 mmap, 省掉一次拷贝; 其余文件用 read() 读入内存
+  // 映射期间文件被截断(如其他进程原地改写配置)时, 访问映射的内容会触发 SIGBUS, 所以默认不使用 mmap,
+  // 只对确定不会被原地改写的大文件打开
+  // 打开或读取失败时抛出 FileReadError
+  explicit FileContent(std::string_view path, size_t mmap_min_size = kNoMmap) {
+#if CONFIG_LOADER_HAS_MMAP
+    int fd = ::open(std::filesystem::path(path).c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throw FileReadError(std::format("Cannot open file: {}", path));
+    }
+    // 管道、字符设备、/proc 下的文件等 st_size 不可信, 当作大小未知, 也不能 mmap
+    struct stat st {};
+    const size_t file_size = ::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0
+        ? static_cast<size_t>(st.st_size) : 0;
+    if (file_size > 0 && file_size >= mmap_min_size) {
+      void* addr = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED) {
+        // 解析器从头到尾顺序访问, 让内核加大预读
+        ::madvise(addr, file_size, MADV_SEQUENTIAL);
+        map_ = addr;
+        view_ = std::string_view(static_cast<const char*>(addr), file_size);
+      }
+    }
+    const bool ok = map_ != nullptr || readAll(fd, file_size);
+    ::close(fd);
+    if (!ok) {
+      throw FileReadError(std::format("Cannot read file: {}", path));
+    }
+#else
+    std::ifstream file{std::filesystem::path(path), std::ios::binary};
+    if (!file.is_open()) {
+      throw FileReadError(std::format("Cannot open file: {}", path));
+    }
+    buffer_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    if (file.bad()) {
+      throw FileReadError(std::format("Cannot read file: {}", path));
+    }
+    view_ = buffer_;
+#endif
+  }
+  FileContent(FileContent&& other) noexcept
+      : map_(std::exchange(other.map_, nullptr)),
+        buffer_(std::move(other.buffer_)),
+        view_(map_ != nullptr ? other.view_ : std::string_view(buffer_)) {
+    other.view_ = {};
+  }
+  FileContent& operator=(FileContent&& other) noexcept {
+    if (this != &other) {
+      release();
+      map_ = std::exchange(other.map_, nullptr);
+      buffer_ = std::move(other.buffer_);
+      view_ = map_ != nullptr ? other.view_ : std::string_view(buffer_);
+      other.view_ = {};
+    }
+    return *this;
+  }
+  FileContent(const FileContent&) = delete;
+  FileContent& operator=(const FileContent&) = delete;
+  ~FileContent() {
+    release();
+  }
+
+  std::string_view view() const {
+    return view_;
+  }
+  operator std::string_view() const {
+    return view_;
+  }
+  bool empty() const {
+    return view_.empty();
+  }
+  // 内容是否来自 mmap
+  bool isMapped() const {
+    return map_ != nullptr;
+  }
+
+private:
+#if CONFIG_LOADER_HAS_MMAP
+  static constexpr size_t kReadChunk = 64 * 1024;
+
+  // 直接读到 buffer_ 中, 不经过中间缓冲区; size_hint 为 fstat 得到的大小, 未知时为 0
+  // 大小可信时只分配一次: 多留 1 字节, 读到 0 确认是文件结尾; 文件在读的过程中变长时继续扩大
+  // 读到文件结尾返回 true; read() 出错(EINTR 除外)返回 false, 不把已经读到的部分当作完整内容
+  bool readAll(int fd, size_t size_hint) {
+    size_t size{0};
+    bool done{false};
+    bool ok{true};
+    while (!done) {
+      const size_t capacity = std::max(size_hint + 1, size + kReadChunk);
+      buffer_.resize_and_overwrite(capacity, [&](char* data, size_t) {
+        while (size < capacity) {
+          ssize_t n = ::read(fd, data + size, capacity - size);
+          if (n > 0) {
+            size += static_cast<size_t>(n);
+          } else if (n == 0) {
+            done = true;
+            break;
+          } else if (errno != EINTR) {
+            done = true;
+            ok = false;
+            break;
+          }
+        }
+        return size;
+      });
+    }
+    if (!ok) {
+      buffer_.clear();
+      return false;
+    }
+    view_ = buffer_;
+    return true;
+  }
+#endif
+  void release() {
+#if CONFIG_LOADER_HAS_MMAP
+    if (map_ != nullptr) {
+      ::munmap(map_, view_.size());
+      map_ = nullptr;
+    }
+#endif
+  }
+
+  void* map_{nullptr};
+  std::string buffer_;
+  std::string_view view_;
+};  // class FileContent
+
+}  // namespace detail
+
+// 按路径加载时读取文件的方式, 如 loadJSON2Obj(obj, path, FileReadOptions{.mmap_min_size = 1 << 20})
+struct FileReadOptions {
+  // 大小不小于 mmap_min_size 的普通文件使用 mmap, 默认不使用; 使用的前提见 detail::FileContent
+  size_t mmap_min_size{detail::FileContent::kNoMmap};
+};  // struct FileReadOptions
@@ -0,0 +1,241 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/16 00:38:56
+# Desc   : 驻留字符串: 相同的值只保存一份, 字段中只有一个指针, 哈希在驻留时算好, 相等比较先比较指针
+########################################################################
+*/
+#pragma once
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+
+/*
+DEFINE_SCHEMA(Instance, (std::string)name, (InternedString)service, (InternedString)region);
+
+std::vector<Instance> instances;
+loadJSON2Obj(instances, path);  // 所有 region 相同的元素共享同一份字符串, 驻留在全局表中
+
+InternTable table;  // 只在本次加载中去重, 随 table 一起释放
+{
+  ScopedInternTable scope{&table};
+  loadJSON2Obj(instances, path);
+}
+*/
+
+class InternTable;
+
+struct InternTableStats {
+  size_t strings{0};     // 不同字符串的个数
+  size_t bytes{0};       // 保存字符串用掉的字节数, 包括每个字符串的头部和结尾的 '\0'
+  uint64_t lookups{0};   // intern() 的调用次数, lookups - strings 即重复出现的次数
+};  // struct InternTableStats
+
+// 默认构造为空字符串; 只保存一个指针, 可以平凡地拷贝和析构, 指向的字符串由所属的 InternTable 管理
+class InternedString {
+public:
+  InternedString() = default;
+  // 驻留到当前线程的表中, 见 ScopedInternTable
+  explicit InternedString(std::string_view value);
+
+  std::string_view view() const {
+    return entry_ == nullptr ? std::string_view{} : std::string_view(entry_->data(), entry_->size);
+  }
+  // 以 '\0' 结尾
+  const char* c_str() const {
+    return entry_ == nullptr ? "" : entry_->data();
+  }
+  size_t size() const {
+    return entry_ == nullptr ? 0 : entry_->size;
+  }
+  bool empty() const {
+    return entry_ == nullptr;
+  }
+  // 与 std::hash<std::string_view> 的结果相同
+  size_t hash() const {
+    return entry_ == nullptr ? emptyHash() : entry_->hash;
+  }
+  std::string str() const {
+    return std::string(view());
+  }
+  operator std::string_view() const {
+    return view();
+  }
+
+  // 同一个表中的字符串只比较指针; 来自不同的表时先比较哈希再比较内容
+  friend bool operator==(const InternedString& lhs, const InternedString& rhs) {
+    return lhs.entry_ == rhs.entry_ || (lhs.hash() == rhs.hash() && lhs.view() == rhs.view());
+  }
+  friend bool operator==(const InternedString& lhs, std::string_view rhs) {
+    return lhs.view() == rhs;
+  }
+  // 按内容比较, 与 std::string 的顺序相同
+  friend std::strong_ordering operator<=>(const InternedString& lhs, const InternedString& rhs) {
+    return lhs.entry_ == rhs.entry_ ? std::strong_ordering::equal : lhs.view() <=> rhs.view();
+  }
+  friend std::strong_ordering operator<=>(const InternedString& lhs, std::string_view rhs) {
+    return lhs.view() <=> rhs;
+  }
+
+private:
+  friend class InternTable;
+
+  // 内容紧跟在头部之后
+  struct Entry {
+    size_t hash;
+    size_t size;
+
+    const char* data() const {
+      return reinterpret_cast<const char*>(this + 1);
+    }
+  };  // struct Entry
+
+  explicit InternedString(const Entry* entry) : entry_(entry) {}
+
+  static size_t emptyHash() {
+    static const size_t hash = std::hash<std::string_view>{}(std::string_view{});
+    return hash;
+  }
+
+  const Entry* entry_{nullptr};
+};  // class InternedString
+
+// 线程安全: 按哈希分成若干段, 每段各自加锁; 字符串只增不减, 在表析构时一起释放,
+// 表的生命周期要长于从它得到的所有 InternedString
+class InternTable {
+public:
+  InternTable() = default;
+  InternTable(const InternTable&) = delete;
+  InternTable& operator=(const InternTable&) = delete;
+
+  InternedString intern(std::string_view value) {
+    if (value.empty()) {
+      return InternedString{};
+    }
+    const size_t hash = std::hash<std::string_view>{}(value);
+    Shard& shard = shards_[(hash >> 7) % kShardCount];
+    std::lock_guard lock{shard.mutex};
+    ++shard.lookups;
+    if (auto it = shard.entries.find(Probe{value, hash}); it != shard.entries.end()) {
+      return InternedString{*it};
+    }
+    const size_t bytes = sizeof(Entry) + value.size() + 1;
+    void* memory = shard.arena.allocate(bytes, alignof(Entry));
+    auto* entry = ::new (memory) Entry{.hash = hash, .size = value.size()};
+    char* data = static_cast<char*>(memory) + sizeof(Entry);
+    std::memcpy(data, value.data(), value.size());
+    data[value.size()] = '\0';
+    shard.entries.insert(entry);
+    shard.bytes += bytes;
+    return InternedString{entry};
+  }
+
+  InternTableStats stats() const {
+    InternTableStats stats;
+    for (const Shard& shard : shards_) {
+      std::lock_guard lock{shard.mutex};
+      stats.strings += shard.entries.size();
+      stats.bytes += shard.bytes;
+      stats.lookups += shard.lookups;
+    }
+    return stats;
+  }
+
+private:
+  using Entry = InternedString::Entry;
+
+  static constexpr size_t kShardCount = 16;
+
+  // 查找时不构造 Entry
+  struct Probe {
+    std::string_view value;
+    size_t hash;
+  };  // struct Probe
+
+  struct EntryHash {
+    using is_transparent = void;
+    size_t operator()(const Entry* entry) const {
+      return entry->hash;
+    }
+    size_t operator()(const Probe& probe) const {
+      return probe.hash;
+    }
+  };  // struct EntryHash
+
+  struct EntryEqual {
+    using is_transparent = void;
+    bool operator()(const Entry* lhs, const Entry* rhs) const {
+      return lhs == rhs;
+    }
+    bool operator()(const Probe& probe, const Entry* entry) const {
+      return probe.hash == entry->hash && probe.value == std::string_view(entry->data(), entry->size);
+    }
+    bool operator()(const Entry* entry, const Probe& probe) const {
+      return (*this)(probe, entry);
+    }
+  };  // struct EntryEqual
+
+  struct Shard {
+    mutable std::mutex mutex;
+    std::pmr::monotonic_buffer_resource arena;
+    std::unordered_set<const Entry*, EntryHash, EntryEqual> entries;
+    size_t bytes{0};
+    uint64_t lookups{0};
+  };  // struct Shard
+
+  std::array<Shard, kShardCount> shards_;
+};  // class InternTable
+
+namespace detail {
+
+inline thread_local InternTable* t_intern_table{nullptr};  // nullptr 表示全局的表
+
+}  // namespace detail
+
+// 全局的表, 从不析构, 在静态对象析构期间仍然可以使用其中的字符串
+inline InternTable& globalInternTable() {
+  static InternTable* table = new InternTable;
+  return *table;
+}
+
+inline InternTable& currentInternTable() {
+  return detail::t_intern_table != nullptr ? *detail::t_intern_table : globalInternTable();
+}
+
+// 在作用域内, 当前线程反序列化得到的 InternedString 驻留在 table 中(并行反序列化的任务也使用这个表)
+class ScopedInternTable {
+public:
+  explicit ScopedInternTable(InternTable* table) : saved_(std::exchange(detail::t_intern_table, table)) {}
+  ScopedInternTable(const ScopedInternTable&) = delete;
+  ScopedInternTable& operator=(const ScopedInternTable&) = delete;
+  ~ScopedInternTable() {
+    detail::t_intern_table = saved_;
+  }
+private:
+  InternTable* saved_;
+};  // class ScopedInternTable
+
+inline InternedString::InternedString(std::string_view value) : InternedString(currentInternTable().intern(value)) {}
+
+template <>
+struct std::hash<InternedString> {
+  size_t operator()(const InternedString& value) const {
+    return value.hash();
+  }
+};  // struct std::hash<InternedString>
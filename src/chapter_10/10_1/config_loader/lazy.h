@@ -0,0 +1,156 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:53:52
+# Desc   : 延迟反序列化的字段: 加载时只保存子文档的原始文本, 第一次访问时才解析
+########################################################################
+*/
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "loader.h"
+#include "memory_resource.h"
+#include "serialize/serialize_traits.h"
+
+/*
+DEFINE_SCHEMA(Config, (std::string)name, (Lazy<Routes>)routes);
+
+Config config;
+loadJSON2Obj<detail::JsonPullParser>(config, path);  // routes 只拷贝原始文本
+const Routes& routes = config.routes.get();  // 第一次访问时用 P 解析, 之后直接返回
+*/
+// 原始文本在第一次访问时用 P 解析, 默认使用不构建 DOM 的 JsonPullParser;
+// get() 可以被多个线程同时调用, 只解析一次; 重新加载与读取不能同时进行(与其他字段相同)
+// 外层文档要用能给出原始文本的后端(JsonPullParser、JsonTapeParser)加载; 其他后端(包括默认的 JsonCppParser)
+// 要把每个 Lazy 字段从 DOM 重新序列化一遍, benchmark_lazy 中比不用 Lazy 直接反序列化还慢 1.6 倍左右
+template <typename T, concepts::Parser P = detail::JsonPullParser>
+class Lazy {
+public:
+  Lazy() = default;
+  Lazy(Lazy&&) noexcept = default;
+  Lazy& operator=(Lazy&&) noexcept = default;
+
+  // 没有加载过时返回默认构造的 T
+  const T& get() const {
+    if (state_ == nullptr) {
+      static const T empty{};
+      return empty;
+    }
+    std::call_once(state_->once, [state = state_.get()] {
+      state->result = detail::load_to_obj<P>(state->value, [state] {
+        return std::string_view(state->raw);
+      });
+      state->parsed.store(true, std::memory_order_release);
+    });
+    return state_->value;
+  }
+  const T& operator*() const {
+    return get();
+  }
+  const T* operator->() const {
+    return &get();
+  }
+  // 解析的结果, 会触发解析; 没有加载过时返回 ERR_MISSING_FIELD
+  Result result() const {
+    if (state_ == nullptr) {
+      return Result::ERR_MISSING_FIELD;
+    }
+    get();
+    return state_->result;
+  }
+  // 是否已经解析过, 不会触发解析
+  bool parsed() const {
+    return state_ != nullptr && state_->parsed.load(std::memory_order_acquire);
+  }
+  // 保存的原始文本
+  std::string_view rawText() const {
+    return state_ == nullptr ? std::string_view{} : std::string_view(state_->raw);
+  }
+
+  // 替换原始文本, 之前解析的结果作废; 还没有被解析过时复用原来的空间
+  void assign(std::string_view raw) {
+    if (state_ == nullptr || parsed()) {
+      state_ = std::make_unique<State>();
+    }
+    state_->raw.assign(raw);
+  }
+
+private:
+  struct State {
+    std::string raw;
+    std::once_flag once;
+    std::atomic<bool> parsed{false};
+    Result result{Result::SUCCESS};
+    T value = detail::makeValue<T>();
+  };  // struct State
+
+  // once_flag 不能移动, 放在堆上
+  std::unique_ptr<State> state_;
+};  // class Lazy
+
+namespace detail {
+
+// 只拷贝子文档的原始文本; 后端不能给出原始文本时(如 JsonCppParser)用 serializeToString() 重新生成, 代价见 Lazy
+template <typename T, typename P>
+struct CompoundDeserializeTraits<Lazy<T, P>> {
+  template <concepts::ParserElem ElemType>
+  static Result deserialize(Lazy<T, P>& lazy, ElemType node) {
+    if (!node.isValid()) {
+      return Result::ERR_MISSING_FIELD;
+    }
+    if constexpr (concepts::RawTextElem<ElemType>) {
+      auto raw = node.getRawText();
+      if (!raw.has_value()) {
+        return Result::ERR_ILL_FORMED;
+      }
+      lazy.assign(*raw);
+    } else {
+      lazy.assign(node.serializeToString());
+    }
+    return Result::SUCCESS;
+  }
+};  // struct CompoundDeserializeTraits<Lazy<T, P>>
+
+// 输出解析后的值, 会触发解析
+template <typename T, typename P>
+struct SerializeTraits<Lazy<T, P>> {
+  template <concepts::Writer W>
+  static void serialize(const Lazy<T, P>& lazy, W& writer) {
+    SerializeTraits<T>::serialize(lazy.get(), writer);
+  }
+};  // struct SerializeTraits<Lazy<T, P>>
+
+// 快照中保存原始文本, 从快照加载后仍然是延迟解析的
+template <typename T, typename P>
+struct SnapshotTraits<Lazy<T, P>> {
+  static constexpr uint64_t fingerprint(uint64_t h, int depth) {
+    return SnapshotTraits<T>::fingerprint(mixFingerprint(h, "lazy"), depth);
+  }
+  static void save(const Lazy<T, P>& lazy, SnapshotWriter& writer) {
+    auto raw = lazy.rawText();
+    writer.write(static_cast<uint64_t>(raw.size()));
+    writer.write(raw.data(), raw.size());
+  }
+  static Result load(Lazy<T, P>& lazy, SnapshotReader& reader) {
+    uint64_t size{0};
+    std::string_view raw;
+    if (!reader.read(size) || !reader.readView(raw, size)) {
+      return Result::ERR_ILL_FORMED;
+    }
+    lazy.assign(raw);
+    return Result::SUCCESS;
+  }
+};  // struct SnapshotTraits<Lazy<T, P>>
+
+}  // namespace detail
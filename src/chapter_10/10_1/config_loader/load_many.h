@@ -0,0 +1,97 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/16 00:05:19
+# Desc   : 多个配置文件并发加载: 读文件和解析在线程池中重叠进行, 每个文件返回一个 Result
+########################################################################
+*/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "interned_string.h"
+#include "loader.h"
+#include "memory_resource.h"
+#include "parallel.h"
+
+/*
+std::vector<LoadRequest<>> requests{{server, "server.json"}, {routes, "routes.json"}, ...};
+std::vector<Result> results = loadMany(requests);  // results[i] 对应 requests[i]
+*/
+// 一个待加载的文件: 对象和路径, 对象可以是不同的类型; 路径指向的字符串和对象在 loadMany 返回前有效
+template <concepts::Parser P = detail::JsonCppParser>
+class LoadRequest {
+public:
+  template <typename T>
+  LoadRequest(T& obj, std::string_view path)
+      : obj_(&obj), path_(path), load_([](void* obj, std::string_view path) {
+        return loadJSON2Obj<P>(*static_cast<T*>(obj), path);
+      }) {}
+
+  // 打开或读取文件失败(FileReadError)时返回 ERR_READ_FILE; 其他异常(如 std::bad_alloc、自定义反序列化抛出的)继续抛出
+  Result load() const {
+    try {
+      return load_(obj_, path_);
+    } catch (const FileReadError&) {
+      return Result::ERR_READ_FILE;
+    }
+  }
+
+private:
+  void* obj_;
+  std::string_view path_;
+  Result (*load_)(void*, std::string_view);
+};  // class LoadRequest
+
+// 至多 max_threads 个线程(包括调用线程, 0 表示 std::thread::hardware_concurrency())同时加载, 全部完成后返回;
+// 文件按顺序分给空闲的线程, 各个文件中的大数组不再并行反序列化
+// 调用线程的 ScopedInternTable 和 ScopedMemoryResource 在每个任务中继续生效; 设置了 memory_resource 时
+// (不一定是线程安全的)与并行反序列化一样不再并行, 全部在调用线程中加载
+// LoadRequest::load() 抛出的异常不影响其他文件的加载, 全部完成后在调用线程抛出下标最小的那个
+template <concepts::Parser P>
+std::vector<Result> loadMany(std::span<const LoadRequest<P>> requests, size_t max_threads = 0) {
+  if (max_threads == 0) {
+    max_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  std::pmr::memory_resource* memory_resource = detail::t_memory_resource;
+  if (memory_resource != nullptr) {
+    max_threads = 1;
+  }
+  InternTable* intern_table = detail::t_intern_table;
+  std::vector<Result> results(requests.size(), Result::SUCCESS);
+  std::vector<std::exception_ptr> exceptions(requests.size());
+  // parallelFor 要求 task 不抛出异常
+  auto task = [&requests, &results, &exceptions, memory_resource, intern_table](size_t i) {
+    ScopedMemoryResource resource_scope{memory_resource};
+    ScopedInternTable intern_scope{intern_table};
+    try {
+      results[i] = requests[i].load();
+    } catch (...) {
+      exceptions[i] = std::current_exception();
+    }
+  };
+  detail::ThreadPool::instance().parallelFor(requests.size(), max_threads, task);
+  for (const auto& exception : exceptions) {
+    if (exception != nullptr) {
+      std::rethrow_exception(exception);
+    }
+  }
+  return results;
+}
+
+template <concepts::Parser P>
+std::vector<Result> loadMany(const std::vector<LoadRequest<P>>& requests, size_t max_threads = 0) {
+  return loadMany(std::span<const LoadRequest<P>>(requests), max_threads);
+}
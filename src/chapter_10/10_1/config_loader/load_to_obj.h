@@ -13,49 +13,74 @@
 #pragma once
 
 #include <cassert>
-#include <filesystem>
-#include <format>
-#include <fstream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
 
 #include "deserialize/all_types.h"
+#include "file_content.h"
 #include "result.h"
 
 namespace detail {
 
-inline std::string get_file_content(std::string_view path) {
-  std::ifstream file{std::filesystem::path(path)};
-  if (!file.is_open()) {
-    throw std::runtime_error(std::format("Cannot open file: {}", path));
-  }
-
-  std::stringstream buffer;
-  buffer << file.rdbuf();
-
-  return buffer.str();
+// 返回的内容在 FileContent 析构前有效; mmap_min_size 见 FileContent
+inline FileContent get_file_content(std::string_view path, size_t mmap_min_size = FileContent::kNoMmap) {
+  return FileContent{path, mmap_min_size};
 }
+
 template <concepts::Parser P>
 struct LoadToObj {
+  // loader 返回的内容只需要能转换为 std::string_view(如 std::string、FileContent),
+  // 在解析和反序列化结束前由这里持有
   template <typename T, std::invocable GET_CONTENT>
+    requires std::convertible_to<std::invoke_result_t<GET_CONTENT>, std::string_view>
   static Result operator()(T& obj, GET_CONTENT&& loader) {
-    std::string content = loader();
+    auto content_holder = loader();
+    P parser;
+    // 原地解析的后端(如 XmlParser)直接改写 loader 返回的 std::string, 省掉一次拷贝
+    if constexpr (std::same_as<decltype(content_holder), std::string> &&
+                  requires { { parser.parseInSitu(std::span<char>{}) } -> std::same_as<Result>; }) {
+      if (content_holder.empty()) {
+        return Result::ERR_EMPTY_CONTENT;
+      }
+      CHECK_SUCCESS_OR_RETURN(parser.parseInSitu(content_holder));
+      return deserializeRoot(parser, obj);
+    } else {
+      return parseInto(parser, obj, content_holder);
+    }
+  }
+
+  template <typename T>
+  static Result operator()(T& obj, std::string_view path, const FileReadOptions& options = {}) {
+    return operator()(obj, [&path, &options] {
+      return get_file_content(path, options.mmap_min_size);
+    });
+  }
+
+  // 用调用者提供的 parser 解析 content 并反序列化到 obj, 多次调用时 parser 内部的空间可以复用
+  template <typename T>
+  static Result parseInto(P& parser, T& obj, std::string_view content) {
     if (content.empty()) {
       return Result::ERR_EMPTY_CONTENT;
     }
+    CHECK_SUCCESS_OR_RETURN(parser.parse(content));
+    return deserializeRoot(parser, obj);
+  }
 
-    P parser;
-    CHECK_SUCCESS_OR_RETURN(parser.parse(content.data()));
+private:
+  template <typename T>
+  static Result deserializeRoot(P& parser, T& obj) {
     auto root_elem = parser.toRootElemType();
     if (!root_elem.isValid()) {
       return Result::ERR_MISSING_FIELD;
     }
-    return CompoundDeserializeTraits<T>::deserialize(obj, root_elem);
-  }
-
-  template <typename T>
-  static Result operator()(T& obj, std::string_view path) {
-    return operator()(obj, [&path] {
-      return get_file_content(path);
-    });
+    auto res = CompoundDeserializeTraits<T>::deserialize(obj, root_elem);
+    // 按需解析的后端在反序列化过程中才会发现语法错误, 优先返回语法错误
+    if constexpr (requires { { parser.finish() } -> std::same_as<Result>; }) {
+      CHECK_SUCCESS_OR_RETURN(parser.finish());
+    }
+    return res;
   }
 };  // struct LoadToObj
 
@@ -68,6 +93,10 @@ struct LoadToObj<UnsupportedParser> {
   Result operator()(T&, Loader&&) const {
     return Result::ERR_UNSUPPORTED_PARSER;
   }
+  template <typename T>
+  Result operator()(T&, std::string_view, const FileReadOptions&) const {
+    return Result::ERR_UNSUPPORTED_PARSER;
+  }
 };  // struct LoadToObj<concepts::UnsupportedParser>
 
 }  // namespace detail
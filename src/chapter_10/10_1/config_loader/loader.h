@@ -14,18 +14,52 @@
 
 #include "load_to_obj.h"
 #include "parser.h"
+#include "snapshot/snapshot.h"
 
+// 内置的 XmlParser: 属性和子元素都是成员, 数组写成包装元素, 见 parser/xml_parser.h
 template <typename T, typename Content>
 Result loadXML2Obj(T& obj, Content&& content) {
-  return detail::load_to_obj<detail::TinyXML2Parser>(obj, content);
+  return detail::load_to_obj<detail::XmlParser>(obj, content);
+}
+template <typename T>
+Result loadXML2Obj(T& obj, std::string_view path, const FileReadOptions& options) {
+  return detail::load_to_obj<detail::XmlParser>(obj, path, options);
 }
 
-template <typename T, typename Content>
+// 默认使用 JsonCppParser, 也可以指定其他 json 后端, 如 loadJSON2Obj<detail::JsonPullParser>(obj, path)
+template <concepts::Parser P = detail::JsonCppParser, typename T, typename Content>
 Result loadJSON2Obj(T& obj, Content&& content) {
-  return detail::load_to_obj<detail::JsonCppParser>(obj, content);
+  return detail::load_to_obj<P>(obj, content);
+}
+// 各个 load*2Obj 都可以用 FileReadOptions 指定读取文件的方式, 如对确定不会被原地改写的大文件使用 mmap
+template <concepts::Parser P = detail::JsonCppParser, typename T>
+Result loadJSON2Obj(T& obj, std::string_view path, const FileReadOptions& options) {
+  return detail::load_to_obj<P>(obj, path, options);
+}
+
+// 解析成功后把 obj 保存为二进制快照 snapshot_path; 下次加载时源文件(大小、修改时间、内容哈希)和 T 的结构都没有变化,
+// 则直接读取快照, 不再解析 path
+template <concepts::Parser P = detail::JsonCppParser, typename T>
+Result loadJSON2ObjWithSnapshot(T& obj, std::string_view path, std::string_view snapshot_path) {
+  return detail::loadWithSnapshot<P>(obj, path, snapshot_path);
 }
 
+// 内置的 YamlParser, 支持的语法见 parser/yaml_parser.h
 template <typename T, typename Content>
 Result loadYAML2Obj(T& obj, Content&& content) {
-  return detail::load_to_obj<detail::YamlCppParser>(obj, content);
+  return detail::load_to_obj<detail::YamlParser>(obj, content);
+}
+template <typename T>
+Result loadYAML2Obj(T& obj, std::string_view path, const FileReadOptions& options) {
+  return detail::load_to_obj<detail::YamlParser>(obj, path, options);
+}
+
+// 内置的 MsgPackParser, content 是 MessagePack 编码(如 dumpObj2MsgPack 的输出)
+template <typename T, typename Content>
+Result loadMsgPack2Obj(T& obj, Content&& content) {
+  return detail::load_to_obj<detail::MsgPackParser>(obj, content);
+}
+template <typename T>
+Result loadMsgPack2Obj(T& obj, std::string_view path, const FileReadOptions& options) {
+  return detail::load_to_obj<detail::MsgPackParser>(obj, path, options);
 }
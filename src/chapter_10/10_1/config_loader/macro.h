@@ -14,9 +14,10 @@
 
 #define EXPAND(x) x
 
-#define GET_NTH_ARG(_1, _2, _3, _4, _5, _6, _7, _8, n, ...) n
-#define GET_ARG_COUNT(...) GET_NTH_ARG(__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1)
+#define GET_NTH_ARG(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100, _101, _102, _103, _104, _105, _106, _107, _108, _109, _110, _111, _112, _113, _114, _115, _116, _117, _118, _119, _120, _121, _122, _123, _124, _125, _126, _127, _128, n, ...) n
+#define GET_ARG_COUNT(...) GET_NTH_ARG(__VA_ARGS__, 128, 127, 126, 125, 124, 123, 122, 121, 120, 119, 118, 117, 116, 115, 114, 113, 112, 111, 110, 109, 108, 107, 106, 105, 104, 103, 102, 101, 100, 99, 98, 97, 96, 95, 94, 93, 92, 91, 90, 89, 88, 87, 86, 85, 84, 83, 82, 81, 80, 79, 78, 77, 76, 75, 74, 73, 72, 71, 70, 69, 68, 67, 66, 65, 64, 63, 62, 61, 60, 59, 58, 57, 56, 55, 54, 53, 52, 51, 50, 49, 48, 47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1)
 
+// DEFINE_SCHEMA 最多支持 128 个字段
 #define REPEAT_1(f, i, arg) f(i, arg)
 #define REPEAT_2(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_1(f, i + 1, __VA_ARGS__))
 #define REPEAT_3(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_2(f, i + 1, __VA_ARGS__))
@@ -25,6 +26,126 @@
 #define REPEAT_6(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_5(f, i + 1, __VA_ARGS__))
 #define REPEAT_7(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_6(f, i + 1, __VA_ARGS__))
 #define REPEAT_8(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_7(f, i + 1, __VA_ARGS__))
+#define REPEAT_9(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_8(f, i + 1, __VA_ARGS__))
+#define REPEAT_10(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_9(f, i + 1, __VA_ARGS__))
+#define REPEAT_11(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_10(f, i + 1, __VA_ARGS__))
+#define REPEAT_12(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_11(f, i + 1, __VA_ARGS__))
+#define REPEAT_13(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_12(f, i + 1, __VA_ARGS__))
+#define REPEAT_14(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_13(f, i + 1, __VA_ARGS__))
+#define REPEAT_15(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_14(f, i + 1, __VA_ARGS__))
+#define REPEAT_16(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_15(f, i + 1, __VA_ARGS__))
+#define REPEAT_17(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_16(f, i + 1, __VA_ARGS__))
+#define REPEAT_18(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_17(f, i + 1, __VA_ARGS__))
+#define REPEAT_19(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_18(f, i + 1, __VA_ARGS__))
+#define REPEAT_20(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_19(f, i + 1, __VA_ARGS__))
+#define REPEAT_21(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_20(f, i + 1, __VA_ARGS__))
+#define REPEAT_22(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_21(f, i + 1, __VA_ARGS__))
+#define REPEAT_23(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_22(f, i + 1, __VA_ARGS__))
+#define REPEAT_24(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_23(f, i + 1, __VA_ARGS__))
+#define REPEAT_25(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_24(f, i + 1, __VA_ARGS__))
+#define REPEAT_26(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_25(f, i + 1, __VA_ARGS__))
+#define REPEAT_27(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_26(f, i + 1, __VA_ARGS__))
+#define REPEAT_28(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_27(f, i + 1, __VA_ARGS__))
+#define REPEAT_29(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_28(f, i + 1, __VA_ARGS__))
+#define REPEAT_30(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_29(f, i + 1, __VA_ARGS__))
+#define REPEAT_31(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_30(f, i + 1, __VA_ARGS__))
+#define REPEAT_32(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_31(f, i + 1, __VA_ARGS__))
+#define REPEAT_33(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_32(f, i + 1, __VA_ARGS__))
+#define REPEAT_34(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_33(f, i + 1, __VA_ARGS__))
+#define REPEAT_35(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_34(f, i + 1, __VA_ARGS__))
+#define REPEAT_36(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_35(f, i + 1, __VA_ARGS__))
+#define REPEAT_37(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_36(f, i + 1, __VA_ARGS__))
+#define REPEAT_38(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_37(f, i + 1, __VA_ARGS__))
+#define REPEAT_39(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_38(f, i + 1, __VA_ARGS__))
+#define REPEAT_40(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_39(f, i + 1, __VA_ARGS__))
+#define REPEAT_41(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_40(f, i + 1, __VA_ARGS__))
+#define REPEAT_42(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_41(f, i + 1, __VA_ARGS__))
+#define REPEAT_43(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_42(f, i + 1, __VA_ARGS__))
+#define REPEAT_44(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_43(f, i + 1, __VA_ARGS__))
+#define REPEAT_45(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_44(f, i + 1, __VA_ARGS__))
+#define REPEAT_46(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_45(f, i + 1, __VA_ARGS__))
+#define REPEAT_47(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_46(f, i + 1, __VA_ARGS__))
+#define REPEAT_48(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_47(f, i + 1, __VA_ARGS__))
+#define REPEAT_49(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_48(f, i + 1, __VA_ARGS__))
+#define REPEAT_50(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_49(f, i + 1, __VA_ARGS__))
+#define REPEAT_51(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_50(f, i + 1, __VA_ARGS__))
+#define REPEAT_52(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_51(f, i + 1, __VA_ARGS__))
+#define REPEAT_53(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_52(f, i + 1, __VA_ARGS__))
+#define REPEAT_54(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_53(f, i + 1, __VA_ARGS__))
+#define REPEAT_55(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_54(f, i + 1, __VA_ARGS__))
+#define REPEAT_56(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_55(f, i + 1, __VA_ARGS__))
+#define REPEAT_57(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_56(f, i + 1, __VA_ARGS__))
+#define REPEAT_58(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_57(f, i + 1, __VA_ARGS__))
+#define REPEAT_59(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_58(f, i + 1, __VA_ARGS__))
+#define REPEAT_60(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_59(f, i + 1, __VA_ARGS__))
+#define REPEAT_61(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_60(f, i + 1, __VA_ARGS__))
+#define REPEAT_62(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_61(f, i + 1, __VA_ARGS__))
+#define REPEAT_63(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_62(f, i + 1, __VA_ARGS__))
+#define REPEAT_64(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_63(f, i + 1, __VA_ARGS__))
+#define REPEAT_65(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_64(f, i + 1, __VA_ARGS__))
+#define REPEAT_66(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_65(f, i + 1, __VA_ARGS__))
+#define REPEAT_67(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_66(f, i + 1, __VA_ARGS__))
+#define REPEAT_68(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_67(f, i + 1, __VA_ARGS__))
+#define REPEAT_69(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_68(f, i + 1, __VA_ARGS__))
+#define REPEAT_70(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_69(f, i + 1, __VA_ARGS__))
+#define REPEAT_71(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_70(f, i + 1, __VA_ARGS__))
+#define REPEAT_72(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_71(f, i + 1, __VA_ARGS__))
+#define REPEAT_73(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_72(f, i + 1, __VA_ARGS__))
+#define REPEAT_74(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_73(f, i + 1, __VA_ARGS__))
+#define REPEAT_75(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_74(f, i + 1, __VA_ARGS__))
+#define REPEAT_76(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_75(f, i + 1, __VA_ARGS__))
+#define REPEAT_77(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_76(f, i + 1, __VA_ARGS__))
+#define REPEAT_78(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_77(f, i + 1, __VA_ARGS__))
+#define REPEAT_79(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_78(f, i + 1, __VA_ARGS__))
+#define REPEAT_80(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_79(f, i + 1, __VA_ARGS__))
+#define REPEAT_81(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_80(f, i + 1, __VA_ARGS__))
+#define REPEAT_82(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_81(f, i + 1, __VA_ARGS__))
+#define REPEAT_83(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_82(f, i + 1, __VA_ARGS__))
+#define REPEAT_84(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_83(f, i + 1, __VA_ARGS__))
+#define REPEAT_85(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_84(f, i + 1, __VA_ARGS__))
+#define REPEAT_86(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_85(f, i + 1, __VA_ARGS__))
+#define REPEAT_87(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_86(f, i + 1, __VA_ARGS__))
+#define REPEAT_88(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_87(f, i + 1, __VA_ARGS__))
+#define REPEAT_89(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_88(f, i + 1, __VA_ARGS__))
+#define REPEAT_90(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_89(f, i + 1, __VA_ARGS__))
+#define REPEAT_91(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_90(f, i + 1, __VA_ARGS__))
+#define REPEAT_92(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_91(f, i + 1, __VA_ARGS__))
+#define REPEAT_93(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_92(f, i + 1, __VA_ARGS__))
+#define REPEAT_94(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_93(f, i + 1, __VA_ARGS__))
+#define REPEAT_95(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_94(f, i + 1, __VA_ARGS__))
+#define REPEAT_96(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_95(f, i + 1, __VA_ARGS__))
+#define REPEAT_97(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_96(f, i + 1, __VA_ARGS__))
+#define REPEAT_98(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_97(f, i + 1, __VA_ARGS__))
+#define REPEAT_99(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_98(f, i + 1, __VA_ARGS__))
+#define REPEAT_100(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_99(f, i + 1, __VA_ARGS__))
+#define REPEAT_101(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_100(f, i + 1, __VA_ARGS__))
+#define REPEAT_102(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_101(f, i + 1, __VA_ARGS__))
+#define REPEAT_103(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_102(f, i + 1, __VA_ARGS__))
+#define REPEAT_104(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_103(f, i + 1, __VA_ARGS__))
+#define REPEAT_105(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_104(f, i + 1, __VA_ARGS__))
+#define REPEAT_106(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_105(f, i + 1, __VA_ARGS__))
+#define REPEAT_107(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_106(f, i + 1, __VA_ARGS__))
+#define REPEAT_108(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_107(f, i + 1, __VA_ARGS__))
+#define REPEAT_109(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_108(f, i + 1, __VA_ARGS__))
+#define REPEAT_110(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_109(f, i + 1, __VA_ARGS__))
+#define REPEAT_111(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_110(f, i + 1, __VA_ARGS__))
+#define REPEAT_112(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_111(f, i + 1, __VA_ARGS__))
+#define REPEAT_113(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_112(f, i + 1, __VA_ARGS__))
+#define REPEAT_114(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_113(f, i + 1, __VA_ARGS__))
+#define REPEAT_115(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_114(f, i + 1, __VA_ARGS__))
+#define REPEAT_116(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_115(f, i + 1, __VA_ARGS__))
+#define REPEAT_117(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_116(f, i + 1, __VA_ARGS__))
+#define REPEAT_118(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_117(f, i + 1, __VA_ARGS__))
+#define REPEAT_119(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_118(f, i + 1, __VA_ARGS__))
+#define REPEAT_120(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_119(f, i + 1, __VA_ARGS__))
+#define REPEAT_121(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_120(f, i + 1, __VA_ARGS__))
+#define REPEAT_122(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_121(f, i + 1, __VA_ARGS__))
+#define REPEAT_123(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_122(f, i + 1, __VA_ARGS__))
+#define REPEAT_124(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_123(f, i + 1, __VA_ARGS__))
+#define REPEAT_125(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_124(f, i + 1, __VA_ARGS__))
+#define REPEAT_126(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_125(f, i + 1, __VA_ARGS__))
+#define REPEAT_127(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_126(f, i + 1, __VA_ARGS__))
+#define REPEAT_128(f, i, arg, ...) f(i, arg) EXPAND(REPEAT_127(f, i + 1, __VA_ARGS__))
 
 #define PARE(...) __VA_ARGS__
 // PAIR((double)x) -> PARE (double) x -> double x
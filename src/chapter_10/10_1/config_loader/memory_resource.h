@@ -0,0 +1,83 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:38:58
+# Desc   : 反序列化时新建对象使用的 std::pmr::memory_resource, 按线程设置
+########################################################################
+*/
+#pragma once
+
+#include <memory>
+#include <memory_resource>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace detail {
+
+inline thread_local std::pmr::memory_resource* t_memory_resource{nullptr};  // nullptr 表示默认的 memory_resource
+
+inline std::pmr::memory_resource* currentMemoryResource() {
+  return t_memory_resource != nullptr ? t_memory_resource : std::pmr::get_default_resource();
+}
+
+template <typename T>
+inline constexpr bool uses_pmr_allocator = std::uses_allocator_v<T, std::pmr::polymorphic_allocator<>>;
+
+// DEFINE_SCHEMA 的字段和反序列化过程中新建的对象都通过这里构造:
+// std::pmr 的字符串和容器使用当前线程的 memory_resource, 其他类型值初始化
+template <typename T>
+T makeValue() {
+  if constexpr (uses_pmr_allocator<T>) {
+    return std::make_obj_using_allocator<T>(std::pmr::polymorphic_allocator<>(currentMemoryResource()));
+  } else {
+    return T();
+  }
+}
+
+// 在目标位置直接构造: construct(args...) 的参数与 makeValue 相同, 如 optional.emplace(args...)
+template <typename T, typename F>
+decltype(auto) constructValue(F&& construct) {
+  if constexpr (uses_pmr_allocator<T>) {
+    return std::apply(std::forward<F>(construct),
+        std::uses_allocator_construction_args<T>(std::pmr::polymorphic_allocator<>(currentMemoryResource())));
+  } else {
+    return std::forward<F>(construct)();
+  }
+}
+
+// 智能指针指向的对象本身用 new 分配, 它内部的 std::pmr 字符串和容器使用当前线程的 memory_resource
+template <typename T>
+std::unique_ptr<T> makeUniqueValue() {
+  return constructValue<T>([](auto&&... args) {
+    return std::make_unique<T>(std::forward<decltype(args)>(args)...);
+  });
+}
+
+// 对象和 shared_ptr 的控制块一起从当前线程的 memory_resource 分配, 只分配一次
+template <typename T>
+std::shared_ptr<T> makeSharedValue() {
+  return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>(currentMemoryResource()));
+}
+
+}  // namespace detail
+
+// 在作用域内, 当前线程反序列化时新建的 std::pmr 字符串和容器(包括 DEFINE_SCHEMA 类型中的字段)从 resource 分配;
+// resource 的生命周期要长于这些对象
+class ScopedMemoryResource {
+public:
+  explicit ScopedMemoryResource(std::pmr::memory_resource* resource)
+      : saved_(std::exchange(detail::t_memory_resource, resource)) {}
+  ScopedMemoryResource(const ScopedMemoryResource&) = delete;
+  ScopedMemoryResource& operator=(const ScopedMemoryResource&) = delete;
+  ~ScopedMemoryResource() {
+    detail::t_memory_resource = saved_;
+  }
+private:
+  std::pmr::memory_resource* saved_;
+};  // class ScopedMemoryResource
@@ -0,0 +1,239 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/16 00:07:04
+# Desc   : 流式读取 NDJSON(每行一个 json 对象): 按固定大小分块读取, 内存占用与文件大小无关
+########################################################################
+*/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#if __has_include(<unistd.h>)
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#define CONFIG_LOADER_HAS_UNISTD 1
+#else
+#include <cstdio>
+#define CONFIG_LOADER_HAS_UNISTD 0
+#endif
+
+#include "load_to_obj.h"
+#include "parser.h"
+
+/*
+NdjsonReader<LogRecord> reader{"access.log"};
+for (const LogRecord& record : reader) {  // 每次迭代把下一行反序列化到同一个对象中
+  ...
+}
+if (reader.status() != Result::SUCCESS) {
+  // 第 reader.lineNumber() 行出错
+}
+*/
+// 空行跳过; 某一行出错时停止, 由 status() 和 lineNumber() 给出错误和行号
+// 只保留一个 T, 每一行原地反序列化到其中(复用字段已分配的空间), 调用者需要保留某条记录时移动或拷贝出去;
+// 缓冲区大小为 chunk_size, 只有一行比它长时才扩大到这一行的长度
+template <typename T, concepts::Parser P = detail::JsonPullParser>
+class NdjsonReader {
+public:
+  static constexpr size_t kDefaultChunkSize = 1 << 20;
+
+  // 打不开文件时 status() 为 ERR_READ_FILE, 没有记录
+  explicit NdjsonReader(std::string_view path, size_t chunk_size = kDefaultChunkSize)
+      : buffer_(std::max<size_t>(chunk_size, 1), '\0') {
+#if CONFIG_LOADER_HAS_UNISTD
+    fd_ = ::open(std::filesystem::path(path).c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+      status_ = Result::ERR_READ_FILE;
+      return;
+    }
+#if defined(POSIX_FADV_SEQUENTIAL)
+    ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+#else
+    file_ = std::fopen(std::filesystem::path(path).string().c_str(), "rb");
+    if (file_ == nullptr) {
+      status_ = Result::ERR_READ_FILE;
+      return;
+    }
+#endif
+    owns_input_ = true;
+  }
+#if CONFIG_LOADER_HAS_UNISTD
+  // 从已经打开的 fd(文件、管道、socket)读取, 不负责关闭
+  explicit NdjsonReader(int fd, size_t chunk_size = kDefaultChunkSize)
+      : buffer_(std::max<size_t>(chunk_size, 1), '\0'), fd_(fd) {}
+#endif
+  NdjsonReader(const NdjsonReader&) = delete;
+  NdjsonReader& operator=(const NdjsonReader&) = delete;
+  ~NdjsonReader() {
+    if (owns_input_) {
+#if CONFIG_LOADER_HAS_UNISTD
+      ::close(fd_);
+#else
+      std::fclose(file_);
+#endif
+    }
+  }
+
+  // 把下一条记录反序列化到 value(), 读完或出错时返回 false
+  bool next() {
+    if (status_ != Result::SUCCESS || done_) {
+      return false;
+    }
+    std::string_view line;
+    while (nextLine(line)) {
+      ++line_number_;
+      if (line.find_first_not_of(" \t\r") == std::string_view::npos) {
+        continue;
+      }
+      status_ = detail::LoadToObj<P>::parseInto(parser_, value_, line);
+      return status_ == Result::SUCCESS;
+    }
+    done_ = true;
+    return false;
+  }
+  T& value() {
+    return value_;
+  }
+  // SUCCESS 表示还没有出错(包括已经读完)
+  Result status() const {
+    return status_;
+  }
+  // 最近读取的一行的行号, 从 1 开始; 出错时是出错的那一行
+  size_t lineNumber() const {
+    return line_number_;
+  }
+
+  // 单遍的输入迭代器, 解引用得到 value()
+  class iterator {
+  public:
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+    explicit iterator(NdjsonReader* reader) : reader_(reader) {}
+    T& operator*() const {
+      return reader_->value();
+    }
+    T* operator->() const {
+      return &reader_->value();
+    }
+    iterator& operator++() {
+      if (!reader_->next()) {
+        reader_ = nullptr;
+      }
+      return *this;
+    }
+    void operator++(int) {
+      ++*this;
+    }
+    bool operator==(std::default_sentinel_t) const {
+      return reader_ == nullptr;
+    }
+  private:
+    NdjsonReader* reader_{nullptr};
+  };  // class iterator
+
+  // 读取第一条记录; 只能遍历一次
+  iterator begin() {
+    return next() ? iterator{this} : iterator{};
+  }
+  std::default_sentinel_t end() const {
+    return std::default_sentinel;
+  }
+
+private:
+  // 下一行(不含换行符), 内容在下一次调用前有效; 没有更多内容或读取出错时返回 false
+  bool nextLine(std::string_view& line) {
+    while (true) {
+      const char* begin = buffer_.data() + begin_;
+      if (const void* nl = std::memchr(begin, '\n', end_ - begin_); nl != nullptr) {
+        const size_t len = static_cast<const char*>(nl) - begin;
+        line = std::string_view(begin, len);
+        begin_ += len + 1;
+        return true;
+      }
+      if (eof_) {
+        if (begin_ == end_) {
+          return false;
+        }
+        line = std::string_view(begin, end_ - begin_);  // 最后一行没有换行符
+        begin_ = end_;
+        return true;
+      }
+      // 把不完整的一行移到缓冲区开头, 一行占满缓冲区时扩大
+      if (begin_ > 0) {
+        std::memmove(buffer_.data(), begin, end_ - begin_);
+        end_ -= begin_;
+        begin_ = 0;
+      }
+      if (end_ == buffer_.size()) {
+        buffer_.resize(buffer_.size() * 2);
+      }
+      if (!fill()) {
+        return false;
+      }
+    }
+  }
+
+  // 读取一块内容追加到 [begin_, end_) 之后
+  bool fill() {
+#if CONFIG_LOADER_HAS_UNISTD
+    while (true) {
+      ssize_t n = ::read(fd_, buffer_.data() + end_, buffer_.size() - end_);
+      if (n > 0) {
+        end_ += static_cast<size_t>(n);
+      } else if (n == 0) {
+        eof_ = true;
+      } else if (errno == EINTR) {
+        continue;
+      } else {
+        status_ = Result::ERR_READ_FILE;
+        return false;
+      }
+      return true;
+    }
+#else
+    size_t n = std::fread(buffer_.data() + end_, 1, buffer_.size() - end_, file_);
+    end_ += n;
+    if (n == 0) {
+      if (std::ferror(file_)) {
+        status_ = Result::ERR_READ_FILE;
+        return false;
+      }
+      eof_ = true;
+    }
+    return true;
+#endif
+  }
+
+  std::string buffer_;
+  size_t begin_{0};  // 还没有处理的内容 [begin_, end_)
+  size_t end_{0};
+#if CONFIG_LOADER_HAS_UNISTD
+  int fd_{-1};
+#else
+  std::FILE* file_{nullptr};
+#endif
+  bool owns_input_{false};
+  bool eof_{false};
+  bool done_{false};
+  Result status_{Result::SUCCESS};
+  size_t line_number_{0};
+  P parser_;
+  T value_ = detail::makeValue<T>();
+};  // class NdjsonReader
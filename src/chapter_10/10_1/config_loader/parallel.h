@@ -0,0 +1,161 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/16 00:04:01
+# Desc   : 大数组并行反序列化: 设置项和调用线程也参与执行的线程池
+########################################################################
+*/
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 对所有线程的加载生效; 默认 max_threads 为 1, 即不并行
+struct ParallelDeserializeOptions {
+  size_t min_elements{100'000};  // 数组的元素个数不少于该值时才并行
+  size_t max_threads{1};         // 包括调用线程在内的线程数, 0 表示 std::thread::hardware_concurrency()
+};  // struct ParallelDeserializeOptions
+
+namespace detail {
+
+inline std::atomic<size_t> g_parallel_min_elements{ParallelDeserializeOptions{}.min_elements};
+inline std::atomic<size_t> g_parallel_max_threads{ParallelDeserializeOptions{}.max_threads};
+
+// 线程池中的线程, 以及正在执行并行任务的调用线程; 任务中遇到的大数组不再并行, 避免线程数成倍增长
+inline thread_local bool t_in_parallel_task{false};
+
+// 线程按需创建, 进程退出时回收; 同一时刻可以有多个调用线程提交任务
+class ThreadPool {
+public:
+  static constexpr size_t kMaxWorkers = 255;
+
+  static ThreadPool& instance() {
+    static ThreadPool pool;
+    return pool;
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool() {
+    {
+      std::lock_guard lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+  }
+
+  // 由至多 threads 个线程(包括调用线程)执行 task(0) ... task(count - 1), 全部完成后返回
+  // task 不能抛出异常: 在线程池的线程中会调用 std::terminate, 在调用线程中会在其他线程还在使用 task 时返回;
+  // 需要传递异常的 task 自己捕获, 在 parallelFor 返回后重新抛出
+  template <typename F>
+  void parallelFor(size_t count, size_t threads, F& task) {
+    threads = std::min({threads, count, kMaxWorkers + 1});
+    if (threads <= 1) {
+      for (size_t i = 0; i < count; ++i) {
+        task(i);
+      }
+      return;
+    }
+    auto batch = std::make_shared<Batch>();
+    batch->run = [](void* ctx, size_t i) {
+      (*static_cast<F*>(ctx))(i);
+    };
+    batch->ctx = &task;
+    batch->count = count;
+    {
+      std::lock_guard lock(mutex_);
+      while (workers_.size() < threads - 1) {
+        workers_.emplace_back([this] { workerLoop(); });
+      }
+      // 每个条目允许一个线程参与, 限制参与的线程数
+      queue_.insert(queue_.end(), threads - 1, batch);
+    }
+    cv_.notify_all();
+
+    const bool saved = std::exchange(t_in_parallel_task, true);
+    batch->work();
+    t_in_parallel_task = saved;
+    for (size_t finished = batch->finished.load(); finished != count; finished = batch->finished.load()) {
+      batch->finished.wait(finished);
+    }
+  }
+
+private:
+  struct Batch {
+    void (*run)(void*, size_t){nullptr};
+    void* ctx{nullptr};
+    size_t count{0};
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> finished{0};
+
+    // 领取还没有执行的任务直到领完; 最后完成的线程唤醒调用线程
+    void work() {
+      for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+        run(ctx, i);
+        if (finished.fetch_add(1) + 1 == count) {
+          finished.notify_all();
+        }
+      }
+    }
+  };  // struct Batch
+
+  ThreadPool() = default;
+
+  void workerLoop() {
+    t_in_parallel_task = true;
+    while (true) {
+      std::shared_ptr<Batch> batch;
+      {
+        std::unique_lock lock(mutex_);
+        cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+        if (stop_) {
+          return;
+        }
+        batch = std::move(queue_.front());
+        queue_.pop_front();
+      }
+      batch->work();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::shared_ptr<Batch>> queue_;
+  bool stop_{false};
+  std::vector<std::jthread> workers_;  // 最后声明, 最先 join
+};  // class ThreadPool
+
+// 当前设置下可用的线程数
+inline size_t parallelDeserializeThreads() {
+  size_t threads = g_parallel_max_threads.load(std::memory_order_relaxed);
+  if (threads == 0) {
+    threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  return threads;
+}
+
+}  // namespace detail
+
+inline void setParallelDeserializeOptions(const ParallelDeserializeOptions& options) {
+  detail::g_parallel_min_elements.store(options.min_elements, std::memory_order_relaxed);
+  detail::g_parallel_max_threads.store(options.max_threads, std::memory_order_relaxed);
+}
+
+inline ParallelDeserializeOptions parallelDeserializeOptions() {
+  return {
+    .min_elements = detail::g_parallel_min_elements.load(std::memory_order_relaxed),
+    .max_threads = detail::g_parallel_max_threads.load(std::memory_order_relaxed),
+  };
+}
@@ -14,10 +14,17 @@
 
 #include "enable_parser.h"
 #include "parser/json_parser.h"
-// #include "parser/yaml_parser.h"
+#include "parser/json_pull_parser.h"
+#include "parser/json_tape_parser.h"
+#include "parser/msgpack_parser.h"
+#include "parser/xml_parser.h"
+#include "parser/yaml_parser.h"
 
 namespace detail {
-using TinyXML2Parser = detail::UnsupportedParser;
 using JsonCppParser = parser::JsonCppParser;
-using YamlCppParser = detail::UnsupportedParser;
+using JsonPullParser = parser::JsonPullParser;
+using JsonTapeParser = parser::JsonTapeParser;
+using MsgPackParser = parser::MsgPackParser;
+using XmlParser = parser::XmlParser;
+using YamlParser = parser::YamlParser;
 }  // namespace detail
@@ -0,0 +1,125 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:13:18
+# Desc   :
+########################################################################
+*/
+
+#include "json_lexer.h"
+
+namespace parser::json {
+
+namespace {
+
+int hexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+bool readHex4(std::string_view raw, size_t pos, uint32_t& code) {
+  if (pos + 4 > raw.size()) {
+    return false;
+  }
+  code = 0;
+  for (size_t i = pos; i < pos + 4; ++i) {
+    int v = hexValue(raw[i]);
+    if (v < 0) {
+      return false;
+    }
+    code = code * 16 + static_cast<uint32_t>(v);
+  }
+  return true;
+}
+
+void appendUtf8(std::string& out, uint32_t code) {
+  if (code < 0x80) {
+    out += static_cast<char>(code);
+  } else if (code < 0x800) {
+    out += static_cast<char>(0xC0 | (code >> 6));
+    out += static_cast<char>(0x80 | (code & 0x3F));
+  } else if (code < 0x10000) {
+    out += static_cast<char>(0xE0 | (code >> 12));
+    out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (code & 0x3F));
+  } else {
+    out += static_cast<char>(0xF0 | (code >> 18));
+    out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+    out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (code & 0x3F));
+  }
+}
+
+// raw[i] 为 '\\' 之后的字符; 成功时 code 为转义表示的码点, i 指向转义的最后一个字符
+bool decodeEscape(std::string_view raw, size_t& i, uint32_t& code) {
+  if (i >= raw.size()) {
+    return false;
+  }
+  switch (raw[i]) {
+    case '"': code = '"'; return true;
+    case '\\': code = '\\'; return true;
+    case '/': code = '/'; return true;
+    case 'b': code = '\b'; return true;
+    case 'f': code = '\f'; return true;
+    case 'n': code = '\n'; return true;
+    case 'r': code = '\r'; return true;
+    case 't': code = '\t'; return true;
+    case 'u': {
+      if (!readHex4(raw, i + 1, code)) {
+        return false;
+      }
+      i += 4;
+      // UTF-16 代理对
+      if (code >= 0xD800 && code <= 0xDBFF) {
+        uint32_t low{0};
+        if (i + 2 >= raw.size() || raw[i + 1] != '\\' || raw[i + 2] != 'u'
+            || !readHex4(raw, i + 3, low) || low < 0xDC00 || low > 0xDFFF) {
+          return false;
+        }
+        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+        i += 6;
+      }
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+bool unescape(std::string_view raw, std::string& out) {
+  out.clear();
+  out.reserve(raw.size());
+  for (size_t i = 0; i < raw.size(); ++i) {
+    if (raw[i] != '\\') {
+      out += raw[i];
+      continue;
+    }
+    uint32_t code{0};
+    if (!decodeEscape(raw, ++i, code)) {
+      return false;
+    }
+    appendUtf8(out, code);
+  }
+  return true;
+}
+
+bool validateEscapes(std::string_view raw) {
+  for (size_t i = raw.find('\\'); i != std::string_view::npos; i = raw.find('\\', i + 1)) {
+    uint32_t code{0};
+    if (!decodeEscape(raw, ++i, code)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace parser::json
@@ -0,0 +1,92 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:16:01
+# Desc   : 不构建 DOM 的 json 后端共用的词法函数
+########################################################################
+*/
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace parser::json {
+
+inline bool isWhitespace(char c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+inline bool isDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+// 标量 token 之后只能是空白、',', '}', ']' 或者输入结尾
+inline bool isDelimiter(const char* p, const char* end) {
+  return p == end || isWhitespace(*p) || *p == ',' || *p == '}' || *p == ']';
+}
+
+// p 指向数字或 true/false/null, 返回 token 之后的位置, 不合法时返回 nullptr
+inline const char* scanScalar(const char* p, const char* end) {
+  if (p >= end) {
+    return nullptr;
+  }
+  for (std::string_view literal : {"true", "false", "null"}) {
+    if (*p == literal[0]) {
+      if (static_cast<size_t>(end - p) < literal.size()
+          || std::memcmp(p, literal.data(), literal.size()) != 0
+          || !isDelimiter(p + literal.size(), end)) {
+        return nullptr;
+      }
+      return p + literal.size();
+    }
+  }
+  // -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+  const char* q = p;
+  if (q < end && *q == '-') {
+    ++q;
+  }
+  if (q < end && *q == '0') {
+    ++q;
+  } else if (q < end && isDigit(*q)) {
+    while (q < end && isDigit(*q)) ++q;
+  } else {
+    return nullptr;
+  }
+  if (q < end && *q == '.') {
+    ++q;
+    if (q >= end || !isDigit(*q)) {
+      return nullptr;
+    }
+    while (q < end && isDigit(*q)) ++q;
+  }
+  if (q < end && (*q == 'e' || *q == 'E')) {
+    ++q;
+    if (q < end && (*q == '+' || *q == '-')) {
+      ++q;
+    }
+    if (q >= end || !isDigit(*q)) {
+      return nullptr;
+    }
+    while (q < end && isDigit(*q)) ++q;
+  }
+  return isDelimiter(q, end) ? q : nullptr;
+}
+
+// 合法的数字 token 中没有小数点和指数时为整数
+inline bool isIntegerToken(std::string_view token) {
+  return token.find_first_of(".eE") == std::string_view::npos;
+}
+
+// 展开字符串中的转义字符, raw 为引号之间的原始内容; 转义不合法时返回 false
+bool unescape(std::string_view raw, std::string& out);
+// 只检查转义, 规则与 unescape 相同, 不展开
+bool validateEscapes(std::string_view raw);
+
+}  // namespace parser::json
@@ -12,51 +12,115 @@
 */
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <string>
+#include <string_view>
+
+#include "../enable_parser.h"
 #include "../result.h"
+#include "../value_kind.h"
 
 #include "json/json.h"
 
 namespace parser {
 
+// 只持有 JsonCppParser 中 DOM 节点的指针，生命周期不能超过所属的 parser
+// 获取子节点、遍历子节点都不会拷贝子树
 class JsonElementType {
 public:
   JsonElementType() = default;
   explicit JsonElementType(const Json::Value& elem, const char* key_name = nullptr)
-      : key_name_(key_name), elem_(elem) {}
+      : key_name_(key_name), elem_(&elem) {}
   bool isValid() const {
-    return !elem_.isNull();
+    return !elem_->isNull();
   }
   std::optional<std::string> getValueText() const {
-    if (elem_.isObject() || elem_.isArray()) {
+    if (elem_->isObject() || elem_->isArray()) {
+      return std::nullopt;
+    }
+    return elem_->asString(); // 2和"2" 调用 asString() 后都是 "2", 无法通过该结果来判断原始类型是数字还是字符串
+  }
+  ValueKind getValueKind() const {
+    switch (elem_->type()) {
+      case Json::ValueType::intValue:
+      case Json::ValueType::uintValue:
+        return ValueKind::kInteger;
+      case Json::ValueType::realValue:
+        return ValueKind::kReal;
+      case Json::ValueType::stringValue:
+        return ValueKind::kString;
+      case Json::ValueType::booleanValue:
+        return ValueKind::kBool;
+      case Json::ValueType::arrayValue:
+        return ValueKind::kArray;
+      case Json::ValueType::objectValue:
+        return ValueKind::kObject;
+      default:
+        return ValueKind::kNull;
+    }
+  }
+  size_t getElementCount() const {
+    return elem_->isArray() || elem_->isObject() ? elem_->size() : 0;
+  }
+  std::optional<int64_t> getInt64Value() const {
+    if (!elem_->isInt64()) {
+      return std::nullopt;
+    }
+    return elem_->asInt64();
+  }
+  std::optional<uint64_t> getUint64Value() const {
+    if (!elem_->isUInt64()) {
+      return std::nullopt;
+    }
+    return elem_->asUInt64();
+  }
+  std::optional<double> getDoubleValue() const {
+    if (!elem_->isNumeric()) {
       return std::nullopt;
     }
-    return elem_.asString(); // 2和"2" 调用 asString() 后都是 "2", 无法通过该结果来判断原始类型是数字还是字符串
+    return elem_->asDouble();
+  }
+  std::optional<bool> getBoolValue() const {
+    if (!elem_->isBool()) {
+      return std::nullopt;
+    }
+    return elem_->asBool();
+  }
+  std::optional<std::string_view> getStringValue() const {
+    const char* begin{nullptr};
+    const char* end{nullptr};
+    if (!elem_->isString() || !elem_->getString(&begin, &end)) {
+      return std::nullopt;
+    }
+    return std::string_view(begin, end - begin);
   }
   const char* getKeyName() const {
     return key_name_;
   }
   JsonElementType toChildElem(std::string_view key) const {
-    if (!elem_.isObject()) {
-      return JsonElementType{Json::Value::nullSingleton()};
+    if (!elem_->isObject()) {
+      return JsonElementType{};
     }
-    return JsonElementType{elem_[key.data()], key.data()};
+    const Json::Value* child = elem_->find(key.data(), key.data() + key.size());
+    return child == nullptr ? JsonElementType{} : JsonElementType{*child, key.data()};
   }
   template <typename F>
   Result forEachElement(F&& f) const {
-    switch (elem_.type()) {
+    switch (elem_->type()) {
       case Json::ValueType::nullValue:
         return Result::SUCCESS;
       case Json::ValueType::arrayValue:
-        for (auto&& e: elem_) {
+        for (auto&& e: *elem_) {
           CHECK_SUCCESS_OR_RETURN(f(JsonElementType{e}));
         }
         return Result::SUCCESS;
       case Json::ValueType::objectValue: {
-        auto keys = elem_.getMemberNames();
-        for (auto &&key: keys) {
-          CHECK_SUCCESS_OR_RETURN(f(JsonElementType{elem_[key], key.c_str()}));
+        // memberName() 指向 DOM 中保存的 key(以 '\0' 结尾), 不需要像 getMemberNames() 那样再拷贝一份
+        for (auto it = elem_->begin(); it != elem_->end(); ++it) {
+          const char* key_end{nullptr};
+          CHECK_SUCCESS_OR_RETURN(f(JsonElementType{*it, it.memberName(&key_end)}));
         }
         return Result::SUCCESS;
       }
@@ -66,11 +130,11 @@ public:
   }
   std::string serializeToString() const {
     Json::FastWriter fastWriter;
-    return fastWriter.write(elem_);
+    return fastWriter.write(*elem_);
   }
 private:
   const char* key_name_{nullptr};
-  const Json::Value elem_;
+  const Json::Value* elem_{&Json::Value::nullSingleton()};
 };  // class JsonElementType
 
 class JsonCppParser {
@@ -83,3 +147,8 @@ private:
 };  // class JsonCppParser
 
 }  // namespace parser
+
+namespace detail {
+template <>
+inline constexpr bool enable_parallel_deserialize<parser::JsonElementType> = true;
+}  // namespace detail
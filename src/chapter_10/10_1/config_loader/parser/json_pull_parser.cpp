@@ -0,0 +1,360 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 15:20:18
+# Desc   :
+########################################################################
+*/
+
+#include "json_pull_parser.h"
+
+#include <array>
+#include <bitset>
+#include <vector>
+
+#include "json_lexer.h"
+
+namespace parser {
+
+namespace {
+
+// 字符串内需要特殊处理的字符: '"', '\\' 和控制字符
+constexpr auto kStringSpecial = [] {
+  std::array<bool, 256> table{};
+  for (int c = 0; c < 0x20; ++c) {
+    table[c] = true;
+  }
+  table['"'] = true;
+  table['\\'] = true;
+  return table;
+}();
+
+}  // namespace
+
+const char* JsonPullReader::scanString(const char* p, std::string_view& raw, bool& has_escape) {
+  if (p >= end_ || *p != '"') {
+    return fail();
+  }
+  const char* content = ++p;
+  has_escape = false;
+  while (p < end_) {
+    if (!kStringSpecial[static_cast<unsigned char>(*p)]) {
+      ++p;
+      continue;
+    }
+    if (*p == '"') {
+      raw = std::string_view(content, p - content);
+      return p + 1;
+    }
+    if (*p != '\\' || p + 1 >= end_) {
+      return fail();
+    }
+    has_escape = true;
+    p += 2;
+  }
+  return fail();
+}
+
+const char* JsonPullReader::scanScalar(const char* p) {
+  const char* end = json::scanScalar(p, end_);
+  return end == nullptr ? fail() : end;
+}
+
+const char* JsonPullReader::scanMemberKey(const char* p, std::string_view& raw, bool& has_escape) {
+  p = scanString(p, raw, has_escape);
+  if (p == nullptr) {
+    return nullptr;
+  }
+  p = skipWhitespace(p);
+  if (p >= end_ || *p != ':') {
+    return fail();
+  }
+  p = skipWhitespace(p + 1);
+  return p < end_ ? p : fail();
+}
+
+const char* JsonPullReader::skipString(const char* p) {
+  std::string_view raw;
+  bool has_escape{false};
+  p = scanString(p, raw, has_escape);
+  if (p != nullptr && has_escape && !json::validateEscapes(raw)) {
+    return fail();
+  }
+  return p;
+}
+
+const char* JsonPullReader::skipMemberKey(const char* p) {
+  p = skipString(p);
+  if (p == nullptr) {
+    return nullptr;
+  }
+  p = skipWhitespace(p);
+  if (p >= end_ || *p != ':') {
+    return fail();
+  }
+  p = skipWhitespace(p + 1);
+  return p < end_ ? p : fail();
+}
+
+const char* JsonPullReader::skipValue(const char* p) {
+  // 记录每一层是不是对象, 闭合符号必须与对应的开始符号匹配; 超出 kInlineDepth 的层才分配内存
+  constexpr size_t kInlineDepth = 1024;
+  std::bitset<kInlineDepth> inline_is_object;
+  std::vector<bool> deep_is_object;
+  size_t depth{0};
+  auto in_object = [&] {
+    return depth <= kInlineDepth ? inline_is_object[depth - 1] : deep_is_object.back();
+  };
+  while (true) {
+    // p 指向一个 value
+    if (p >= end_) {
+      return fail();
+    }
+    if (*p == '{' || *p == '[') {
+      const bool is_object = *p == '{';
+      const char* q = skipWhitespace(p + 1);
+      if (q < end_ && *q == (is_object ? '}' : ']')) {
+        p = q + 1;
+      } else {
+        if (depth < kInlineDepth) {
+          inline_is_object[depth] = is_object;
+        } else {
+          deep_is_object.push_back(is_object);
+        }
+        ++depth;
+        p = is_object ? skipMemberKey(q) : q;
+        if (p == nullptr) {
+          return nullptr;
+        }
+        continue;
+      }
+    } else if (*p == '"') {
+      p = skipString(p);
+    } else {
+      p = scanScalar(p);
+    }
+    if (p == nullptr) {
+      return nullptr;
+    }
+    // value 结束: 之后是 ',' 和下一个 value, 或者闭合当前这一层
+    while (depth > 0) {
+      p = skipWhitespace(p);
+      if (p >= end_) {
+        return fail();
+      }
+      if (*p == ',') {
+        p = skipWhitespace(p + 1);
+        if (in_object()) {
+          p = skipMemberKey(p);
+          if (p == nullptr) {
+            return nullptr;
+          }
+        }
+        break;
+      }
+      if (*p != (in_object() ? '}' : ']')) {
+        return fail();
+      }
+      if (depth > kInlineDepth) {
+        deep_is_object.pop_back();
+      }
+      --depth;
+      ++p;
+    }
+    if (depth == 0) {
+      return p;
+    }
+  }
+}
+
+bool JsonPullReader::unescape(std::string_view raw, std::string& out) {
+  if (!json::unescape(raw, out)) {
+    fail();
+    return false;
+  }
+  return true;
+}
+
+std::optional<std::string> JsonPullElementType::getValueText() const {
+  if (!isValid() || *value_ == '{' || *value_ == '[') {
+    return std::nullopt;
+  }
+  if (*value_ != '"') {
+    const char* end = reader_->scanScalar(value_);
+    if (end == nullptr) {
+      return std::nullopt;
+    }
+    reader_->complete(value_, end);
+    return std::string(value_, end);
+  }
+  std::string_view raw;
+  bool has_escape{false};
+  const char* end = reader_->scanString(value_, raw, has_escape);
+  if (end == nullptr) {
+    return std::nullopt;
+  }
+  std::string text;
+  if (!has_escape) {
+    text.assign(raw);
+  } else if (!reader_->unescape(raw, text)) {
+    return std::nullopt;
+  }
+  reader_->complete(value_, end);
+  return text;
+}
+
+ValueKind JsonPullElementType::getValueKind() const {
+  if (value_ == nullptr) {
+    return ValueKind::kNull;
+  }
+  switch (*value_) {
+    case 'n':
+      return ValueKind::kNull;
+    case 't': case 'f':
+      return ValueKind::kBool;
+    case '"':
+      return ValueKind::kString;
+    case '[':
+      return ValueKind::kArray;
+    case '{':
+      return ValueKind::kObject;
+    default:
+      break;
+  }
+  const char* end = reader_->scanScalar(value_);
+  if (end == nullptr) {
+    return ValueKind::kNull;  // 不合法的 token, 取值时报错
+  }
+  return json::isIntegerToken(std::string_view(value_, end - value_)) ? ValueKind::kInteger : ValueKind::kReal;
+}
+
+std::optional<bool> JsonPullElementType::getBoolValue() const {
+  if (value_ == nullptr || (*value_ != 't' && *value_ != 'f')) {
+    return std::nullopt;
+  }
+  const char* end = reader_->scanScalar(value_);
+  if (end == nullptr) {
+    return std::nullopt;
+  }
+  reader_->complete(value_, end);
+  return *value_ == 't';
+}
+
+std::optional<std::string_view> JsonPullElementType::getStringValue() const {
+  if (value_ == nullptr || *value_ != '"') {
+    return std::nullopt;
+  }
+  std::string_view raw;
+  bool has_escape{false};
+  const char* end = reader_->scanString(value_, raw, has_escape);
+  if (end == nullptr || has_escape) {
+    return std::nullopt;  // 含转义字符时由 getValueText() 展开
+  }
+  reader_->complete(value_, end);
+  return raw;
+}
+
+const char* JsonPullElementType::getKeyName() const {
+  if (raw_key_.data() == nullptr) {
+    return nullptr;
+  }
+  const std::string* key = reader_->keyNames().get(raw_key_.data(), [this](std::string& out) {
+    if (!key_escaped_) {
+      out.assign(raw_key_);
+      return true;
+    }
+    return reader_->unescape(raw_key_, out);
+  });
+  return key == nullptr ? nullptr : key->c_str();
+}
+
+std::string_view JsonPullElementType::getKeyView() const {
+  if (!key_escaped_) {
+    return raw_key_;
+  }
+  const char* key = getKeyName();
+  return key == nullptr ? std::string_view{} : std::string_view(key);
+}
+
+JsonPullElementType JsonPullElementType::toChildElem(std::string_view key) const {
+  if (value_ == nullptr || *value_ != '{') {
+    return JsonPullElementType{};
+  }
+  const char* p = reader_->skipWhitespace(value_ + 1);
+  if (p < reader_->end() && *p == '}') {
+    return JsonPullElementType{};
+  }
+  while (true) {
+    std::string_view raw_key;
+    bool key_escaped{false};
+    const char* item = reader_->scanMemberKey(p, raw_key, key_escaped);
+    if (item == nullptr) {
+      return JsonPullElementType{};
+    }
+    JsonPullElementType child{reader_, item, raw_key, key_escaped};
+    if (child.getKeyView() == key) {
+      return child;
+    }
+    p = reader_->valueEnd(item);
+    if (p == nullptr) {
+      return JsonPullElementType{};
+    }
+    p = reader_->skipWhitespace(p);
+    if (p < reader_->end() && *p == ',') {
+      p = reader_->skipWhitespace(p + 1);
+    } else if (p < reader_->end() && *p == '}') {
+      return JsonPullElementType{};
+    } else {
+      reader_->fail();
+      return JsonPullElementType{};
+    }
+  }
+}
+
+std::optional<std::string_view> JsonPullElementType::getRawText() const {
+  if (value_ == nullptr) {
+    return std::nullopt;
+  }
+  const char* end = reader_->valueEnd(value_);
+  if (end == nullptr) {
+    return std::nullopt;
+  }
+  reader_->complete(value_, end);
+  return std::string_view(value_, end - value_);
+}
+
+std::string JsonPullElementType::serializeToString() const {
+  if (value_ == nullptr) {
+    return "null";
+  }
+  auto raw = getRawText();
+  return raw.has_value() ? std::string(*raw) : std::string{};
+}
+
+Result JsonPullParser::parse(std::string_view content) {
+  reader_ = JsonPullReader{content};
+  root_ = reader_.skipWhitespace(reader_.begin());
+  return root_ == reader_.end() ? Result::ERR_ILL_FORMED : Result::SUCCESS;
+}
+
+JsonPullParser::ElemType JsonPullParser::toRootElemType() const {
+  return ElemType{&reader_, root_};
+}
+
+Result JsonPullParser::finish() const {
+  if (reader_.error() != Result::SUCCESS) {
+    return reader_.error();
+  }
+  const char* end = reader_.completedEnd(root_);
+  if (end != nullptr && reader_.skipWhitespace(end) != reader_.end()) {
+    return Result::ERR_ILL_FORMED;
+  }
+  return Result::SUCCESS;
+}
+
+}  // namespace parser
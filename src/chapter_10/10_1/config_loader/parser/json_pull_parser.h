@@ -0,0 +1,215 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 15:20:18
+# Desc   : 不构建 DOM 的 json pull 解析器, 节点直接指向输入内容
+########################################################################
+*/
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "../enable_parser.h"
+#include "../result.h"
+#include "../value_kind.h"
+#include "json_lexer.h"
+#include "key_name_cache.h"
+
+namespace parser {
+
+// JsonPullParser 的共享状态: 输入内容、第一个语法错误、最近一次被完整读取的 value
+// 节点按需扫描输入, 父节点遍历时如果子节点已经被读完, 可以直接跳到它的结尾而不用再扫描一遍
+class JsonPullReader {
+public:
+  JsonPullReader() = default;
+  explicit JsonPullReader(std::string_view content)
+      : begin_(content.data()), end_(content.data() + content.size()) {}
+
+  const char* begin() const { return begin_; }
+  const char* end() const { return end_; }
+  Result error() const { return error_; }
+
+  const char* skipWhitespace(const char* p) const {
+    while (p < end_ && json::isWhitespace(*p)) {
+      ++p;
+    }
+    return p;
+  }
+
+  // 以下扫描函数出错时记录 ERR_ILL_FORMED 并返回 nullptr
+  // p 指向 '"', 返回闭合引号之后的位置, raw 为引号之间未转义的原始内容
+  const char* scanString(const char* p, std::string_view& raw, bool& has_escape);
+  // p 指向数字或 true/false/null, 返回 token 之后的位置
+  const char* scanScalar(const char* p);
+  // p 指向成员的 key, 解析 "key" : 之后返回 value 的起始位置
+  const char* scanMemberKey(const char* p, std::string_view& raw, bool& has_escape);
+  // 跳过任意 value, 一遍完成与读取时相同的语法检查(分隔符、标量 token、转义)
+  const char* skipValue(const char* p);
+  // 返回 value 之后的位置, value 刚被完整读取过时不再重复扫描
+  const char* valueEnd(const char* value) {
+    return value == done_begin_ ? done_end_ : skipValue(value);
+  }
+  // 记录 [begin, end) 这个 value 已经被完整读取
+  void complete(const char* begin, const char* end) {
+    done_begin_ = begin;
+    done_end_ = end;
+  }
+  // 被完整读取过的 value 的结尾, 否则为 nullptr
+  const char* completedEnd(const char* value) const {
+    return value == done_begin_ ? done_end_ : nullptr;
+  }
+
+  bool unescape(std::string_view raw, std::string& out);
+  // 展开后的 key, 在下一次 parse() 之前有效
+  KeyNameCache& keyNames() { return key_names_; }
+
+  std::nullptr_t fail() {
+    if (error_ == Result::SUCCESS) {
+      error_ = Result::ERR_ILL_FORMED;
+    }
+    return nullptr;
+  }
+
+private:
+  // 与 scanString、scanMemberKey 相同, 另外检查转义
+  const char* skipString(const char* p);
+  const char* skipMemberKey(const char* p);
+
+  const char* begin_{nullptr};
+  const char* end_{nullptr};
+  const char* done_begin_{nullptr};
+  const char* done_end_{nullptr};
+  Result error_{Result::SUCCESS};
+  KeyNameCache key_names_;
+};  // class JsonPullReader
+
+// 节点只记录 value 在输入中的起始位置, 生命周期不能超过所属的 parser 和输入内容
+class JsonPullElementType {
+public:
+  JsonPullElementType() = default;
+  JsonPullElementType(JsonPullReader* reader, const char* value,
+      std::string_view raw_key = {}, bool key_escaped = false)
+      : reader_(reader), value_(value), raw_key_(raw_key), key_escaped_(key_escaped) {}
+
+  bool isValid() const {
+    return value_ != nullptr && *value_ != 'n';
+  }
+  std::optional<std::string> getValueText() const;
+  ValueKind getValueKind() const;
+  std::optional<int64_t> getInt64Value() const {
+    return getNumber<int64_t>();
+  }
+  std::optional<uint64_t> getUint64Value() const {
+    return getNumber<uint64_t>();
+  }
+  std::optional<double> getDoubleValue() const {
+    return getNumber<double>();
+  }
+  std::optional<bool> getBoolValue() const;
+  std::optional<std::string_view> getStringValue() const;
+  // 展开转义后保存在 reader 中, 在下一次 parse() 之前有效
+  const char* getKeyName() const;
+  std::string_view getKeyView() const;
+  JsonPullElementType toChildElem(std::string_view key) const;
+  template <typename F>
+  Result forEachElement(F&& f) const {
+    if (!isValid()) {
+      return Result::SUCCESS;
+    }
+    if (*value_ != '[' && *value_ != '{') {
+      return Result::ERR_TYPE;
+    }
+    const bool is_object = *value_ == '{';
+    const char close = is_object ? '}' : ']';
+    const char* p = reader_->skipWhitespace(value_ + 1);
+    if (p < reader_->end() && *p == close) {
+      reader_->complete(value_, p + 1);
+      return Result::SUCCESS;
+    }
+    while (true) {
+      std::string_view raw_key;
+      bool key_escaped{false};
+      const char* item = is_object ? reader_->scanMemberKey(p, raw_key, key_escaped) : p;
+      if (item == nullptr || item == reader_->end()) {
+        reader_->fail();
+        return Result::ERR_ILL_FORMED;
+      }
+      CHECK_SUCCESS_OR_RETURN(f(JsonPullElementType{reader_, item, raw_key, key_escaped}));
+      p = reader_->valueEnd(item);
+      if (p == nullptr) {
+        return Result::ERR_ILL_FORMED;
+      }
+      p = reader_->skipWhitespace(p);
+      if (p < reader_->end() && *p == ',') {
+        p = reader_->skipWhitespace(p + 1);
+      } else if (p < reader_->end() && *p == close) {
+        reader_->complete(value_, p + 1);
+        return Result::SUCCESS;
+      } else {
+        reader_->fail();
+        return Result::ERR_ILL_FORMED;
+      }
+    }
+  }
+  // value 在输入中的原始文本, 不展开转义
+  std::optional<std::string_view> getRawText() const;
+  std::string serializeToString() const;
+
+private:
+  bool isNumber() const {
+    return value_ != nullptr && (*value_ == '-' || (*value_ >= '0' && *value_ <= '9'));
+  }
+  template <typename Number>
+  std::optional<Number> getNumber() const {
+    if (!isNumber()) {
+      return std::nullopt;
+    }
+    const char* end = reader_->scanScalar(value_);
+    if (end == nullptr) {
+      return std::nullopt;
+    }
+    Number num{};
+    auto [ptr, ec] = std::from_chars(value_, end, num);
+    if (ec != std::errc{} || ptr != end) {
+      return std::nullopt;
+    }
+    reader_->complete(value_, end);
+    return num;
+  }
+
+  JsonPullReader* reader_{nullptr};
+  const char* value_{nullptr};
+  std::string_view raw_key_;
+  bool key_escaped_{false};
+};  // class JsonPullElementType
+
+// 单遍解析: parse() 只定位根节点, 反序列化时按需向前扫描输入, 不生成中间树
+// 没有被读取到的部分不会做完整的语法检查
+class JsonPullParser {
+public:
+  using ElemType = JsonPullElementType;
+  Result parse(std::string_view content);
+  ElemType toRootElemType() const;
+  // 反序列化结束后调用: 返回扫描过程中遇到的语法错误, 根节点读完时检查后面只剩空白
+  Result finish() const;
+private:
+  mutable JsonPullReader reader_;
+  const char* root_{nullptr};
+};  // class JsonPullParser
+
+}  // namespace parser
+
+namespace detail {
+template <>
+inline constexpr bool enable_member_walk<parser::JsonPullElementType> = true;
+}  // namespace detail
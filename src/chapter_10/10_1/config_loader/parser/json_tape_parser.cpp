@@ -0,0 +1,513 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:18:44
+# Desc   :
+########################################################################
+*/
+
+#include "json_tape_parser.h"
+
+#include <bit>
+#include <cstring>
+#include <limits>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include "json_lexer.h"
+
+namespace parser {
+
+namespace {
+
+// 一个 64 字节块中各类字符的位图, 第 i 位对应第 i 个字节
+struct BlockMasks {
+  uint64_t backslash;
+  uint64_t quote;
+  uint64_t structural;  // {}[]:,
+  uint64_t whitespace;
+  uint64_t control;  // 小于 0x20 的字符, 只能出现在字符串之外(作为空白)
+};  // struct BlockMasks
+
+BlockMasks scalarMasks(const char* p) {
+  BlockMasks masks{};
+  for (int i = 0; i < 64; ++i) {
+    const uint64_t bit = uint64_t{1} << i;
+    if (static_cast<unsigned char>(p[i]) < 0x20) {
+      masks.control |= bit;
+    }
+    switch (p[i]) {
+      case '\\': masks.backslash |= bit; break;
+      case '"': masks.quote |= bit; break;
+      case '{': case '}': case '[': case ']': case ':': case ',':
+        masks.structural |= bit;
+        break;
+      case ' ': case '\t': case '\n': case '\r':
+        masks.whitespace |= bit;
+        break;
+      default:
+        break;
+    }
+  }
+  return masks;
+}
+
+#if defined(__x86_64__)
+BlockMasks sseMasks(const char* p) {
+  BlockMasks masks{};
+  for (int i = 0; i < 4; ++i) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i * 16));
+    auto eq = [&v](char c) {
+      return _mm_cmpeq_epi8(v, _mm_set1_epi8(c));
+    };
+    auto bits = [](__m128i m) {
+      return static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(m)));
+    };
+    const int shift = i * 16;
+    masks.backslash |= bits(eq('\\')) << shift;
+    masks.quote |= bits(eq('"')) << shift;
+    masks.structural |= bits(_mm_or_si128(
+        _mm_or_si128(_mm_or_si128(eq('{'), eq('}')), _mm_or_si128(eq('['), eq(']'))),
+        _mm_or_si128(eq(':'), eq(',')))) << shift;
+    masks.whitespace |= bits(_mm_or_si128(
+        _mm_or_si128(eq(' '), eq('\t')), _mm_or_si128(eq('\n'), eq('\r')))) << shift;
+    // 无符号比较: max(v, 0x1f) == 0x1f 即 v <= 0x1f
+    const __m128i limit = _mm_set1_epi8(0x1f);
+    masks.control |= bits(_mm_cmpeq_epi8(_mm_max_epu8(v, limit), limit)) << shift;
+  }
+  return masks;
+}
+
+__attribute__((target("avx2")))
+BlockMasks avx2Masks(const char* p) {
+  BlockMasks masks{};
+  for (int i = 0; i < 2; ++i) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i * 32));
+    auto eq = [&v](char c) __attribute__((target("avx2"))) {
+      return _mm256_cmpeq_epi8(v, _mm256_set1_epi8(c));
+    };
+    auto bits = [](__m256i m) __attribute__((target("avx2"))) {
+      return static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(m)));
+    };
+    const int shift = i * 32;
+    masks.backslash |= bits(eq('\\')) << shift;
+    masks.quote |= bits(eq('"')) << shift;
+    masks.structural |= bits(_mm256_or_si256(
+        _mm256_or_si256(_mm256_or_si256(eq('{'), eq('}')), _mm256_or_si256(eq('['), eq(']'))),
+        _mm256_or_si256(eq(':'), eq(',')))) << shift;
+    masks.whitespace |= bits(_mm256_or_si256(
+        _mm256_or_si256(eq(' '), eq('\t')), _mm256_or_si256(eq('\n'), eq('\r')))) << shift;
+    const __m256i limit = _mm256_set1_epi8(0x1f);
+    masks.control |= bits(_mm256_cmpeq_epi8(_mm256_max_epu8(v, limit), limit)) << shift;
+  }
+  return masks;
+}
+#endif
+
+// 第 i 位为第 0..i 位的异或, 即引号之间(包含开引号、不包含闭引号)的区域
+uint64_t prefixXor(uint64_t x) {
+  x ^= x << 1;
+  x ^= x << 2;
+  x ^= x << 4;
+  x ^= x << 8;
+  x ^= x << 16;
+  x ^= x << 32;
+  return x;
+}
+
+// 跨块保存的状态
+class StructuralScanner {
+public:
+  // 返回本块中需要记录的位置: 结构字符、未转义的引号、标量起始
+  uint64_t next(const BlockMasks& masks) {
+    const uint64_t quote = masks.quote & ~escaped(masks.backslash);
+    const uint64_t in_string = prefixXor(quote) ^ prev_in_string_;
+    prev_in_string_ = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+    control_in_string_ |= masks.control & in_string;
+    const uint64_t scalar = ~(masks.structural | masks.whitespace | quote) & ~in_string;
+    const uint64_t scalar_start = scalar & ~((scalar << 1) | prev_scalar_);
+    prev_scalar_ = scalar >> 63;
+    return (masks.structural & ~in_string) | quote | scalar_start;
+  }
+  bool inString() const {
+    return prev_in_string_ != 0;
+  }
+  // json 字符串中的控制字符必须转义, 与 JsonPullParser 的检查一致
+  bool controlInString() const {
+    return control_in_string_ != 0;
+  }
+
+private:
+  // 被反斜杠转义的字符; 连续的反斜杠中只有奇数位置上的反斜杠起转义作用
+  uint64_t escaped(uint64_t backslash) {
+    constexpr uint64_t kOddBits = 0xAAAAAAAAAAAAAAAAULL;
+    if (backslash == 0) {
+      const uint64_t escaped = prev_escaped_;
+      prev_escaped_ = 0;
+      return escaped;
+    }
+    const uint64_t potential_escape = backslash & ~prev_escaped_;
+    const uint64_t maybe_escaped = potential_escape << 1;
+    const uint64_t maybe_escaped_and_odd_bits = maybe_escaped | kOddBits;
+    const uint64_t even_series_codes_and_odd_bits = maybe_escaped_and_odd_bits - potential_escape;
+    const uint64_t escape_and_terminal_code = even_series_codes_and_odd_bits ^ kOddBits;
+    const uint64_t escaped = escape_and_terminal_code ^ (backslash | prev_escaped_);
+    const uint64_t escape = escape_and_terminal_code & backslash;
+    prev_escaped_ = escape >> 63;
+    return escaped;
+  }
+
+  uint64_t prev_escaped_{0};
+  uint64_t prev_in_string_{0};
+  uint64_t prev_scalar_{0};
+  uint64_t control_in_string_{0};
+};  // class StructuralScanner
+
+template <typename MasksFn>
+inline bool scanBlocks(std::string_view content, StructuralIndexes& indexes, MasksFn masks_fn) {
+  indexes.clear();
+  // 结构字符一般不超过输入的 1/4, 不够时按块扩容; resize 不清零, 只有写入的前 count 个有意义
+  indexes.resize(content.size() / 4 + 64);
+  uint32_t* out = indexes.data();
+  size_t count{0};
+  StructuralScanner scanner;
+  auto flatten = [&](uint64_t bits, uint32_t base) {
+    if (count + 64 > indexes.size()) {
+      indexes.resize(indexes.size() * 2);
+      out = indexes.data();
+    }
+    while (bits != 0) {
+      out[count++] = base + static_cast<uint32_t>(std::countr_zero(bits));
+      bits &= bits - 1;
+    }
+  };
+  const size_t full = content.size() / 64 * 64;
+  for (size_t i = 0; i < full; i += 64) {
+    flatten(scanner.next(masks_fn(content.data() + i)), static_cast<uint32_t>(i));
+  }
+  if (full < content.size()) {
+    // 最后不足 64 字节的部分用空白补齐
+    char tail[64];
+    std::memset(tail, ' ', sizeof(tail));
+    std::memcpy(tail, content.data() + full, content.size() - full);
+    flatten(scanner.next(masks_fn(tail)), static_cast<uint32_t>(full));
+  }
+  indexes.resize(count);
+  return !scanner.inString() && !scanner.controlInString();
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx2")))
+bool scanBlocksAvx2(std::string_view content, StructuralIndexes& indexes) {
+  return scanBlocks(content, indexes, avx2Masks);
+}
+#endif
+
+}  // namespace
+
+SimdLevel detectSimdLevel() {
+#if defined(__x86_64__)
+  return __builtin_cpu_supports("avx2") ? SimdLevel::kAvx2 : SimdLevel::kSse;
+#else
+  return SimdLevel::kScalar;
+#endif
+}
+
+bool findStructuralIndexes(std::string_view content, StructuralIndexes& indexes, SimdLevel level) {
+  level = std::min(level, detectSimdLevel());
+#if defined(__x86_64__)
+  if (level == SimdLevel::kAvx2) {
+    return scanBlocksAvx2(content, indexes);
+  }
+  if (level == SimdLevel::kSse) {
+    return scanBlocks(content, indexes, sseMasks);
+  }
+#endif
+  return scanBlocks(content, indexes, scalarMasks);
+}
+
+Result JsonTapeParser::parse(std::string_view content) {
+  if (content.size() >= std::numeric_limits<uint32_t>::max()) {
+    return Result::ERR_ILL_FORMED;
+  }
+  content_ = content;
+  key_names_.clear();
+  if (!findStructuralIndexes(content_, indexes_, level_)) {
+    return Result::ERR_ILL_FORMED;
+  }
+  return buildTape();
+}
+
+Result JsonTapeParser::buildTape() {
+  enum class State {
+    kValue,
+    kArrayValueOrClose,
+    kObjectKeyOrClose,
+    kObjectKey,
+    kColon,
+    kCommaOrClose,
+    kDone,
+  };
+  tape_.clear();
+  tape_.reserve(indexes_.size());
+  std::vector<uint32_t> stack;  // 未闭合的括号在 tape 中的下标
+  State state{State::kValue};
+  const char* data = content_.data();
+  const size_t n = indexes_.size();
+
+  auto after_value = [&] {
+    state = stack.empty() ? State::kDone : State::kCommaOrClose;
+  };
+  auto close = [&](char c) {
+    const char open = c == '}' ? '{' : '[';
+    if (stack.empty() || data[tape_[stack.back()].offset] != open) {
+      return false;
+    }
+    tape_[stack.back()].aux = static_cast<uint32_t>(tape_.size() + 1);
+    stack.pop_back();
+    return true;
+  };
+  // 字符串的开引号之后一定是它的闭引号; 转义在这里检查, 之后 key 和 value 展开时不会再失败
+  auto push_string = [&](size_t& k) {
+    if (k + 1 >= n || data[indexes_[k + 1]] != '"') {
+      return false;
+    }
+    if (!json::validateEscapes(std::string_view(data + indexes_[k] + 1, indexes_[k + 1] - indexes_[k] - 1))) {
+      return false;
+    }
+    tape_.push_back({indexes_[k], indexes_[k + 1]});
+    ++k;
+    return true;
+  };
+
+  for (size_t k = 0; k < n; ++k) {
+    const uint32_t offset = indexes_[k];
+    const char c = data[offset];
+    switch (state) {
+      case State::kObjectKeyOrClose:
+      case State::kObjectKey:
+        if (c == '}' && state == State::kObjectKeyOrClose) {
+          if (!close(c)) return Result::ERR_ILL_FORMED;
+          tape_.push_back({offset, 0});
+          after_value();
+        } else if (c != '"' || !push_string(k)) {
+          return Result::ERR_ILL_FORMED;
+        } else {
+          state = State::kColon;
+        }
+        break;
+      case State::kColon:
+        if (c != ':') return Result::ERR_ILL_FORMED;
+        state = State::kValue;
+        break;
+      case State::kCommaOrClose:
+        if (c == ',') {
+          state = data[tape_[stack.back()].offset] == '{' ? State::kObjectKey : State::kValue;
+        } else if ((c == '}' || c == ']') && close(c)) {
+          tape_.push_back({offset, 0});
+          after_value();
+        } else {
+          return Result::ERR_ILL_FORMED;
+        }
+        break;
+      case State::kArrayValueOrClose:
+        if (c == ']') {
+          if (!close(c)) return Result::ERR_ILL_FORMED;
+          tape_.push_back({offset, 0});
+          after_value();
+          break;
+        }
+        [[fallthrough]];
+      case State::kValue:
+        switch (c) {
+          case '{': case '[':
+            stack.push_back(static_cast<uint32_t>(tape_.size()));
+            tape_.push_back({offset, 0});
+            state = c == '{' ? State::kObjectKeyOrClose : State::kArrayValueOrClose;
+            break;
+          case '"':
+            if (!push_string(k)) return Result::ERR_ILL_FORMED;
+            after_value();
+            break;
+          case '}': case ']': case ':': case ',':
+            return Result::ERR_ILL_FORMED;
+          default: {
+            // 标量一直到下一个结构字符(或输入结尾), 去掉末尾空白后必须是合法的数字或 true/false/null
+            size_t end = k + 1 < n ? indexes_[k + 1] : content_.size();
+            while (end > offset && json::isWhitespace(data[end - 1])) {
+              --end;
+            }
+            if (json::scanScalar(data + offset, data + end) != data + end) {
+              return Result::ERR_ILL_FORMED;
+            }
+            tape_.push_back({offset, static_cast<uint32_t>(end)});
+            after_value();
+            break;
+          }
+        }
+        break;
+      case State::kDone:
+        return Result::ERR_ILL_FORMED;
+    }
+  }
+  return state == State::kDone ? Result::SUCCESS : Result::ERR_ILL_FORMED;
+}
+
+JsonTapeParser::ElemType JsonTapeParser::toRootElemType() const {
+  return ElemType{this, 0};
+}
+
+std::string_view JsonTapeElementType::scalarText() const {
+  const auto& entry = doc_->tape_[index_];
+  return doc_->content_.substr(entry.offset, entry.aux - entry.offset);
+}
+
+std::string_view JsonTapeElementType::rawString(uint32_t index) const {
+  const auto& entry = doc_->tape_[index];
+  return doc_->content_.substr(entry.offset + 1, entry.aux - entry.offset - 1);
+}
+
+std::optional<std::string> JsonTapeElementType::getValueText() const {
+  if (!isValid()) {
+    return std::nullopt;
+  }
+  switch (type()) {
+    case '{': case '[':
+      return std::nullopt;
+    case '"': {
+      std::string text;
+      if (!json::unescape(rawString(index_), text)) {
+        return std::nullopt;
+      }
+      return text;
+    }
+    default:
+      return std::string(scalarText());
+  }
+}
+
+ValueKind JsonTapeElementType::getValueKind() const {
+  if (doc_ == nullptr) {
+    return ValueKind::kNull;
+  }
+  switch (type()) {
+    case 'n':
+      return ValueKind::kNull;
+    case 't': case 'f':
+      return ValueKind::kBool;
+    case '"':
+      return ValueKind::kString;
+    case '[':
+      return ValueKind::kArray;
+    case '{':
+      return ValueKind::kObject;
+    default:
+      return json::isIntegerToken(scalarText()) ? ValueKind::kInteger : ValueKind::kReal;
+  }
+}
+
+size_t JsonTapeElementType::getElementCount() const {
+  if (doc_ == nullptr) {
+    return 0;
+  }
+  size_t count{0};
+  if (type() == '[') {
+    for (uint32_t i = index_ + 1; typeAt(i) != ']'; i = next(i)) {
+      ++count;
+    }
+  } else if (type() == '{') {
+    for (uint32_t i = index_ + 1; typeAt(i) != '}'; i = next(i + 1)) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+std::optional<bool> JsonTapeElementType::getBoolValue() const {
+  if (doc_ == nullptr || (type() != 't' && type() != 'f')) {
+    return std::nullopt;
+  }
+  return type() == 't';
+}
+
+std::optional<std::string_view> JsonTapeElementType::getStringValue() const {
+  if (doc_ == nullptr || type() != '"') {
+    return std::nullopt;
+  }
+  auto raw = rawString(index_);
+  if (raw.find('\\') != std::string_view::npos) {
+    return std::nullopt;  // 含转义字符时由 getValueText() 展开
+  }
+  return raw;
+}
+
+const char* JsonTapeElementType::getKeyName() const {
+  if (key_index_ == kNoKey) {
+    return nullptr;
+  }
+  auto raw = rawString(key_index_);
+  const std::string* key = doc_->key_names_.get(raw.data(), [raw](std::string& out) {
+    return json::unescape(raw, out);
+  });
+  return key == nullptr ? nullptr : key->c_str();
+}
+
+std::string_view JsonTapeElementType::getKeyView() const {
+  if (key_index_ == kNoKey) {
+    return {};
+  }
+  auto raw = rawString(key_index_);
+  if (raw.find('\\') == std::string_view::npos) {
+    return raw;
+  }
+  const char* key = getKeyName();
+  return key == nullptr ? std::string_view{} : std::string_view(key);
+}
+
+JsonTapeElementType JsonTapeElementType::toChildElem(std::string_view key) const {
+  if (doc_ == nullptr || type() != '{') {
+    return JsonTapeElementType{};
+  }
+  for (uint32_t i = index_ + 1; typeAt(i) != '}'; i = next(i + 1)) {
+    JsonTapeElementType child{doc_, i + 1, i};
+    if (child.getKeyView() == key) {
+      return child;
+    }
+  }
+  return JsonTapeElementType{};
+}
+
+std::optional<std::string_view> JsonTapeElementType::getRawText() const {
+  if (doc_ == nullptr) {
+    return std::nullopt;
+  }
+  const auto& entry = doc_->tape_[index_];
+  size_t end{0};
+  switch (type()) {
+    case '{': case '[':
+      end = doc_->tape_[entry.aux - 1].offset + 1;
+      break;
+    case '"':
+      end = entry.aux + 1;
+      break;
+    default:
+      end = entry.aux;
+  }
+  return doc_->content_.substr(entry.offset, end - entry.offset);
+}
+
+std::string JsonTapeElementType::serializeToString() const {
+  if (doc_ == nullptr) {
+    return "null";
+  }
+  return std::string(*getRawText());
+}
+
+}  // namespace parser
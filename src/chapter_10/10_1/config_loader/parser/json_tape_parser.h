@@ -0,0 +1,194 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:21:27
+# Desc   : 两阶段 json 解析器: SIMD 扫描结构字符生成索引, 再由索引生成 tape 提供节点访问
+########################################################################
+*/
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../enable_parser.h"
+#include "../result.h"
+#include "../value_kind.h"
+#include "key_name_cache.h"
+
+namespace parser {
+
+enum class SimdLevel {
+  kScalar,
+  kSse,   // x86-64 的 SSE2 指令, 所有 x86-64 cpu 都支持
+  kAvx2,
+};
+
+// 当前 cpu 支持的最高级别
+SimdLevel detectSimdLevel();
+
+// resize() 时不做值初始化: 索引数组按上限预留后由第一阶段直接写入, 不需要先清零
+template <typename T>
+struct DefaultInitAllocator : std::allocator<T> {
+  template <typename U>
+  void construct(U* p) noexcept(std::is_nothrow_default_constructible_v<U>) {
+    ::new (static_cast<void*>(p)) U;
+  }
+  template <typename U, typename... Args>
+  void construct(U* p, Args&&... args) {
+    ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+  }
+};  // struct DefaultInitAllocator
+
+using StructuralIndexes = std::vector<uint32_t, DefaultInitAllocator<uint32_t>>;
+
+// 第一阶段: 每次处理 64 字节, 找出字符串外的结构字符 {}[]:, 、所有未被转义的引号以及标量的起始位置,
+// 按顺序写入 indexes; 字符串没有闭合或字符串中有未转义的控制字符时返回 false
+// level 高于 cpu 支持的级别时按 cpu 支持的级别处理
+bool findStructuralIndexes(std::string_view content, StructuralIndexes& indexes,
+    SimdLevel level = detectSimdLevel());
+
+struct TapeEntry {
+  uint32_t offset;  // 在输入中的位置
+  // '{' '[': 配对的闭括号之后的 tape 下标, 用于 O(1) 跳过整个子树
+  // 字符串: 闭合引号的位置; 标量: token 的结尾; 闭括号: 未使用
+  uint32_t aux;
+};  // struct TapeEntry
+
+class JsonTapeParser;
+
+// 节点只记录 tape 下标, 生命周期不能超过所属的 parser 和输入内容
+class JsonTapeElementType {
+public:
+  JsonTapeElementType() = default;
+  JsonTapeElementType(const JsonTapeParser* doc, uint32_t index, uint32_t key_index = kNoKey)
+      : doc_(doc), index_(index), key_index_(key_index) {}
+
+  bool isValid() const {
+    return doc_ != nullptr && type() != 'n';
+  }
+  std::optional<std::string> getValueText() const;
+  ValueKind getValueKind() const;
+  // 沿着 tape 跳过每个子节点的子树, 不解析元素
+  size_t getElementCount() const;
+  std::optional<int64_t> getInt64Value() const {
+    return getNumber<int64_t>();
+  }
+  std::optional<uint64_t> getUint64Value() const {
+    return getNumber<uint64_t>();
+  }
+  std::optional<double> getDoubleValue() const {
+    return getNumber<double>();
+  }
+  std::optional<bool> getBoolValue() const;
+  std::optional<std::string_view> getStringValue() const;
+  // 展开转义后保存在 parser 中, 在下一次 parse() 之前有效
+  const char* getKeyName() const;
+  std::string_view getKeyView() const;
+  JsonTapeElementType toChildElem(std::string_view key) const;
+  template <typename F>
+  Result forEachElement(F&& f) const {
+    if (!isValid()) {
+      return Result::SUCCESS;
+    }
+    const char c = type();
+    if (c == '[') {
+      for (uint32_t i = index_ + 1; typeAt(i) != ']'; i = next(i)) {
+        CHECK_SUCCESS_OR_RETURN(f(JsonTapeElementType{doc_, i}));
+      }
+      return Result::SUCCESS;
+    }
+    if (c == '{') {
+      for (uint32_t i = index_ + 1; typeAt(i) != '}'; i = next(i + 1)) {
+        CHECK_SUCCESS_OR_RETURN(f(JsonTapeElementType{doc_, i + 1, i}));
+      }
+      return Result::SUCCESS;
+    }
+    return Result::ERR_TYPE;
+  }
+  // value 在输入中的原始文本, 不展开转义
+  std::optional<std::string_view> getRawText() const;
+  std::string serializeToString() const;
+
+private:
+  static constexpr uint32_t kNoKey = UINT32_MAX;
+  char type() const {
+    return typeAt(index_);
+  }
+  char typeAt(uint32_t index) const;
+  // 下一个兄弟节点的 tape 下标
+  uint32_t next(uint32_t index) const;
+  std::string_view scalarText() const;
+  // 字符串引号之间的原始内容
+  std::string_view rawString(uint32_t index) const;
+  template <typename Number>
+  std::optional<Number> getNumber() const {
+    const char c = type();
+    if (c != '-' && (c < '0' || c > '9')) {
+      return std::nullopt;
+    }
+    auto text = scalarText();
+    Number num{};
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), num);
+    if (ec != std::errc{} || ptr != text.data() + text.size()) {
+      return std::nullopt;
+    }
+    return num;
+  }
+
+  const JsonTapeParser* doc_{nullptr};
+  uint32_t index_{0};
+  uint32_t key_index_{kNoKey};
+};  // class JsonTapeElementType
+
+// 适合以大数组为主的大文件: 第一阶段按 64 字节向量化扫描, 第二阶段只遍历结构字符的索引
+// 输入大小不能超过 4GB(偏移量使用 uint32_t)
+class JsonTapeParser {
+public:
+  using ElemType = JsonTapeElementType;
+  JsonTapeParser() = default;
+  explicit JsonTapeParser(SimdLevel level) : level_(level) {}
+  Result parse(std::string_view content);
+  ElemType toRootElemType() const;
+private:
+  friend class JsonTapeElementType;
+  // 第二阶段: 按语法检查结构字符的顺序, 生成 tape
+  Result buildTape();
+
+  SimdLevel level_{detectSimdLevel()};
+  std::string_view content_;
+  StructuralIndexes indexes_;
+  std::vector<TapeEntry> tape_;
+  mutable KeyNameCache key_names_;
+};  // class JsonTapeParser
+
+inline char JsonTapeElementType::typeAt(uint32_t index) const {
+  return doc_->content_[doc_->tape_[index].offset];
+}
+
+inline uint32_t JsonTapeElementType::next(uint32_t index) const {
+  const char c = typeAt(index);
+  return c == '{' || c == '[' ? doc_->tape_[index].aux : index + 1;
+}
+
+}  // namespace parser
+
+namespace detail {
+template <>
+inline constexpr bool enable_member_walk<parser::JsonTapeElementType> = true;
+template <>
+inline constexpr bool enable_parallel_deserialize<parser::JsonTapeElementType> = true;
+}  // namespace detail
@@ -0,0 +1,57 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/16 01:02:31
+# Desc   : 需要展开转义或补 '\0' 的 key, 每个 key 只展开一次, 结果保存到 parser 下一次 parse() 或析构
+########################################################################
+*/
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace parser {
+
+// 以 key 在输入中的起始位置区分不同的 key; 返回的指针在 clear() 之前一直有效(unordered_map 的节点不会移动)
+// 并行反序列化时多个线程会同时读取同一个文档, 用互斥锁保护; 只有转义的 key 和 getKeyName() 会走到这里
+class KeyNameCache {
+public:
+  KeyNameCache() = default;
+  // 只移动已经展开的 key, 互斥锁不移动; 移动时不能有其他线程在读取
+  KeyNameCache(KeyNameCache&& other) noexcept : keys_(std::move(other.keys_)) {}
+  KeyNameCache& operator=(KeyNameCache&& other) noexcept {
+    keys_ = std::move(other.keys_);
+    return *this;
+  }
+
+  // decode(std::string&) 展开 key, 失败时返回 false, 此时返回 nullptr
+  template <typename Decode>
+  const std::string* get(const char* raw, Decode&& decode) {
+    std::lock_guard lock{mutex_};
+    auto [it, inserted] = keys_.try_emplace(raw);
+    if (inserted && !decode(it->second)) {
+      keys_.erase(it);
+      return nullptr;
+    }
+    return &it->second;
+  }
+
+  void clear() {
+    std::lock_guard lock{mutex_};
+    keys_.clear();
+  }
+
+private:
+  std::mutex mutex_;
+  std::unordered_map<const char*, std::string> keys_;
+};  // class KeyNameCache
+
+}  // namespace parser
@@ -0,0 +1,491 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/16 00:23:19
+# Desc   :
+########################################################################
+*/
+
+#include "msgpack_parser.h"
+
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <limits>
+
+namespace parser {
+
+namespace {
+
+// 嵌套层数的上限, 避免恶意输入导致栈溢出
+constexpr int kMaxDepth = 512;
+
+void appendJsonString(std::string_view value, std::string& out) {
+  static constexpr char kHex[] = "0123456789abcdef";
+  out += '"';
+  for (char c : value) {
+    switch (c) {
+      case '"': out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\n': out += "\\n"; break;
+      case '\r': out += "\\r"; break;
+      case '\t': out += "\\t"; break;
+      case '\b': out += "\\b"; break;
+      case '\f': out += "\\f"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out += "\\u00";
+          out += kHex[(c >> 4) & 0xF];
+          out += kHex[c & 0xF];
+        } else {
+          out += c;
+        }
+    }
+  }
+  out += '"';
+}
+
+template <typename Number>
+void appendNumber(Number value, std::string& out) {
+  char buf[32];
+  auto [ptr, ec] = std::to_chars(buf, buf + sizeof(buf), value);
+  out.append(buf, ptr);
+}
+
+// 一遍扫描输入, 按先序生成节点; 出错时返回 false
+class MsgPackBuilder {
+public:
+  MsgPackBuilder(std::string_view content, std::vector<MsgPackNode>& nodes)
+      : begin_(reinterpret_cast<const uint8_t*>(content.data())), p_(begin_), end_(begin_ + content.size()),
+        nodes_(nodes) {}
+
+  Result build() {
+    if (!parseValue(0, nullptr)) {
+      return Result::ERR_ILL_FORMED;
+    }
+    return p_ == end_ ? Result::SUCCESS : Result::ERR_ILL_FORMED;
+  }
+
+private:
+  // 大端序的定长整数
+  template <typename U>
+  bool read(U& value) {
+    if (static_cast<size_t>(end_ - p_) < sizeof(U)) {
+      return false;
+    }
+    value = 0;
+    for (size_t i = 0; i < sizeof(U); ++i) {
+      value = static_cast<U>((value << 8) | p_[i]);
+    }
+    p_ += sizeof(U);
+    return true;
+  }
+
+  template <typename U>
+  bool readLength(uint32_t& length) {
+    U value{};
+    if (!read(value)) {
+      return false;
+    }
+    length = static_cast<uint32_t>(value);
+    return true;
+  }
+
+  // 跳过 size 字节的内容, 返回内容的偏移
+  bool skipBytes(uint32_t size, uint32_t& offset) {
+    if (static_cast<size_t>(end_ - p_) < size) {
+      return false;
+    }
+    offset = static_cast<uint32_t>(p_ - begin_);
+    p_ += size;
+    return true;
+  }
+
+  // 映射的 key: 只接受 str
+  bool parseKey(MsgPackNode& key) {
+    if (p_ == end_) {
+      return false;
+    }
+    const uint8_t tag = *p_++;
+    uint32_t size{0};
+    bool ok{true};
+    if (tag >= 0xa0 && tag <= 0xbf) {
+      size = tag & 0x1f;
+    } else if (tag == 0xd9) {
+      ok = readLength<uint8_t>(size);
+    } else if (tag == 0xda) {
+      ok = readLength<uint16_t>(size);
+    } else if (tag == 0xdb) {
+      ok = readLength<uint32_t>(size);
+    } else {
+      return false;
+    }
+    if (!ok) {
+      return false;
+    }
+    key.key_size = size;
+    key.has_key = true;
+    return skipBytes(size, key.key);
+  }
+
+  // key 不为空时是映射的成员, 把 key 记录到生成的节点上
+  bool parseValue(int depth, const MsgPackNode* key) {
+    if (depth >= kMaxDepth || p_ == end_) {
+      return false;
+    }
+    const uint32_t index = static_cast<uint32_t>(nodes_.size());
+    MsgPackNode node;
+    if (key != nullptr) {
+      node.key = key->key;
+      node.key_size = key->key_size;
+      node.has_key = true;
+    }
+    const uint8_t tag = *p_++;
+    bool ok{true};
+    uint32_t count{0};
+    if (tag <= 0x7f) {
+      node.kind = ValueKind::kInteger;
+      node.value = tag;
+    } else if (tag >= 0xe0) {
+      node.kind = ValueKind::kInteger;
+      node.value = static_cast<uint64_t>(static_cast<int64_t>(static_cast<int8_t>(tag)));
+      node.negative = true;
+    } else if (tag <= 0x8f) {
+      node.kind = ValueKind::kObject;
+      count = tag & 0x0f;
+    } else if (tag <= 0x9f) {
+      node.kind = ValueKind::kArray;
+      count = tag & 0x0f;
+    } else if (tag <= 0xbf) {
+      ok = parseString(node, tag & 0x1f);
+    } else {
+      switch (tag) {
+        case 0xc0:
+          break;
+        case 0xc2:
+        case 0xc3:
+          node.kind = ValueKind::kBool;
+          node.value = tag == 0xc3;
+          break;
+        case 0xc4:
+        case 0xd9:
+          ok = readLength<uint8_t>(count) && parseString(node, count);
+          break;
+        case 0xc5:
+        case 0xda:
+          ok = readLength<uint16_t>(count) && parseString(node, count);
+          break;
+        case 0xc6:
+        case 0xdb:
+          ok = readLength<uint32_t>(count) && parseString(node, count);
+          break;
+        case 0xca: {
+          uint32_t bits{0};
+          ok = read(bits);
+          node.kind = ValueKind::kReal;
+          node.value = std::bit_cast<uint64_t>(static_cast<double>(std::bit_cast<float>(bits)));
+          break;
+        }
+        case 0xcb:
+          ok = read(node.value);
+          node.kind = ValueKind::kReal;
+          break;
+        case 0xcc: ok = readUnsigned<uint8_t>(node); break;
+        case 0xcd: ok = readUnsigned<uint16_t>(node); break;
+        case 0xce: ok = readUnsigned<uint32_t>(node); break;
+        case 0xcf: ok = readUnsigned<uint64_t>(node); break;
+        case 0xd0: ok = readSigned<uint8_t, int8_t>(node); break;
+        case 0xd1: ok = readSigned<uint16_t, int16_t>(node); break;
+        case 0xd2: ok = readSigned<uint32_t, int32_t>(node); break;
+        case 0xd3: ok = readSigned<uint64_t, int64_t>(node); break;
+        case 0xdc:
+        case 0xdd:
+          node.kind = ValueKind::kArray;
+          ok = tag == 0xdc ? readLength<uint16_t>(count) : readLength<uint32_t>(count);
+          break;
+        case 0xde:
+        case 0xdf:
+          node.kind = ValueKind::kObject;
+          ok = tag == 0xde ? readLength<uint16_t>(count) : readLength<uint32_t>(count);
+          break;
+        default:
+          return false;  // 0xc1 和 ext 类型
+      }
+    }
+    if (!ok) {
+      return false;
+    }
+    if (node.kind == ValueKind::kArray || node.kind == ValueKind::kObject) {
+      // 每个元素至少占 1 字节, 提前拒绝声明了过多元素的输入
+      if (count > static_cast<size_t>(end_ - p_)) {
+        return false;
+      }
+      node.size = count;
+    }
+    nodes_.push_back(node);
+    if (node.kind == ValueKind::kArray) {
+      for (uint32_t i = 0; i < count; ++i) {
+        if (!parseValue(depth + 1, nullptr)) {
+          return false;
+        }
+      }
+    } else if (node.kind == ValueKind::kObject) {
+      for (uint32_t i = 0; i < count; ++i) {
+        MsgPackNode member_key;
+        if (!parseKey(member_key) || !parseValue(depth + 1, &member_key)) {
+          return false;
+        }
+      }
+    }
+    nodes_[index].next = static_cast<uint32_t>(nodes_.size());
+    return true;
+  }
+
+  bool parseString(MsgPackNode& node, uint32_t size) {
+    uint32_t offset{0};
+    if (!skipBytes(size, offset)) {
+      return false;
+    }
+    node.kind = ValueKind::kString;
+    node.value = offset;
+    node.size = size;
+    return true;
+  }
+
+  template <typename U>
+  bool readUnsigned(MsgPackNode& node) {
+    U value{};
+    if (!read(value)) {
+      return false;
+    }
+    node.kind = ValueKind::kInteger;
+    node.value = value;
+    return true;
+  }
+
+  template <typename U, typename S>
+  bool readSigned(MsgPackNode& node) {
+    U bits{};
+    if (!read(bits)) {
+      return false;
+    }
+    const auto value = static_cast<int64_t>(static_cast<S>(bits));
+    node.kind = ValueKind::kInteger;
+    node.value = static_cast<uint64_t>(value);
+    node.negative = value < 0;
+    return true;
+  }
+
+  const uint8_t* const begin_;
+  const uint8_t* p_;
+  const uint8_t* const end_;
+  std::vector<MsgPackNode>& nodes_;
+};  // class MsgPackBuilder
+
+void appendJson(const MsgPackElementType& elem, std::string& out);
+
+}  // namespace
+
+Result MsgPackParser::parse(std::string_view content) {
+  nodes_.clear();
+  key_names_.clear();
+  data_ = content.data();
+  if (content.size() >= UINT32_MAX) {
+    return Result::ERR_ILL_FORMED;
+  }
+  // 每个节点至少占 1 字节, 通常在 4 到 10 字节之间
+  nodes_.reserve(content.size() / 8 + 1);
+  auto res = MsgPackBuilder{content, nodes_}.build();
+  if (res != Result::SUCCESS) {
+    nodes_.clear();
+  }
+  return res;
+}
+
+MsgPackParser::ElemType MsgPackParser::toRootElemType() const {
+  return nodes_.empty() ? ElemType{} : ElemType{this, 0};
+}
+
+bool MsgPackElementType::isValid() const {
+  return doc_ != nullptr && node().kind != ValueKind::kNull;
+}
+
+std::optional<std::string> MsgPackElementType::getValueText() const {
+  if (!isValid()) {
+    return std::nullopt;
+  }
+  std::string text;
+  switch (node().kind) {
+    case ValueKind::kBool:
+      text = node().value != 0 ? "true" : "false";
+      break;
+    case ValueKind::kInteger:
+      if (node().negative) {
+        appendNumber(static_cast<int64_t>(node().value), text);
+      } else {
+        appendNumber(node().value, text);
+      }
+      break;
+    case ValueKind::kReal:
+      appendNumber(std::bit_cast<double>(node().value), text);
+      break;
+    case ValueKind::kString:
+      text.assign(*getStringValue());
+      break;
+    default:
+      return std::nullopt;
+  }
+  return text;
+}
+
+ValueKind MsgPackElementType::getValueKind() const {
+  return doc_ == nullptr ? ValueKind::kNull : node().kind;
+}
+
+size_t MsgPackElementType::getElementCount() const {
+  if (doc_ == nullptr || (node().kind != ValueKind::kArray && node().kind != ValueKind::kObject)) {
+    return 0;
+  }
+  return node().size;
+}
+
+std::optional<int64_t> MsgPackElementType::getInt64Value() const {
+  if (doc_ == nullptr || node().kind != ValueKind::kInteger) {
+    return std::nullopt;
+  }
+  if (!node().negative && node().value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+    return std::nullopt;
+  }
+  return static_cast<int64_t>(node().value);
+}
+
+std::optional<uint64_t> MsgPackElementType::getUint64Value() const {
+  if (doc_ == nullptr || node().kind != ValueKind::kInteger || node().negative) {
+    return std::nullopt;
+  }
+  return node().value;
+}
+
+std::optional<double> MsgPackElementType::getDoubleValue() const {
+  if (doc_ == nullptr) {
+    return std::nullopt;
+  }
+  const MsgPackNode& n = node();
+  if (n.kind == ValueKind::kInteger) {
+    return n.negative ? static_cast<double>(static_cast<int64_t>(n.value)) : static_cast<double>(n.value);
+  }
+  if (n.kind == ValueKind::kReal) {
+    return std::bit_cast<double>(n.value);
+  }
+  return std::nullopt;
+}
+
+std::optional<bool> MsgPackElementType::getBoolValue() const {
+  if (doc_ == nullptr || node().kind != ValueKind::kBool) {
+    return std::nullopt;
+  }
+  return node().value != 0;
+}
+
+std::optional<std::string_view> MsgPackElementType::getStringValue() const {
+  if (doc_ == nullptr || node().kind != ValueKind::kString) {
+    return std::nullopt;
+  }
+  return std::string_view(doc_->data_ + node().value, node().size);
+}
+
+const char* MsgPackElementType::getKeyName() const {
+  if (doc_ == nullptr || !node().has_key) {
+    return nullptr;
+  }
+  const std::string* key = doc_->key_names_.get(doc_->data_ + node().key, [this](std::string& out) {
+    out.assign(getKeyView());
+    return true;
+  });
+  return key->c_str();
+}
+
+std::string_view MsgPackElementType::getKeyView() const {
+  if (doc_ == nullptr || !node().has_key) {
+    return {};
+  }
+  return std::string_view(doc_->data_ + node().key, node().key_size);
+}
+
+MsgPackElementType MsgPackElementType::toChildElem(std::string_view key) const {
+  if (doc_ == nullptr || node().kind != ValueKind::kObject) {
+    return MsgPackElementType{};
+  }
+  for (uint32_t i = index_ + 1; i < node().next; i = nodeAt(i).next) {
+    MsgPackElementType child{doc_, i};
+    if (child.getKeyView() == key) {
+      return child;
+    }
+  }
+  return MsgPackElementType{};
+}
+
+std::string MsgPackElementType::serializeToString() const {
+  std::string out;
+  appendJson(*this, out);
+  return out;
+}
+
+namespace {
+
+void appendJson(const MsgPackElementType& elem, std::string& out) {
+  switch (elem.getValueKind()) {
+    case ValueKind::kNull:
+      out += "null";
+      return;
+    case ValueKind::kBool:
+      out += *elem.getBoolValue() ? "true" : "false";
+      return;
+    case ValueKind::kInteger:
+      if (auto value = elem.getInt64Value(); value.has_value()) {
+        appendNumber(*value, out);
+      } else {
+        appendNumber(*elem.getUint64Value(), out);
+      }
+      return;
+    case ValueKind::kReal:
+      if (double value = *elem.getDoubleValue(); std::isfinite(value)) {
+        appendNumber(value, out);
+      } else {
+        out += "null";
+      }
+      return;
+    case ValueKind::kString:
+      appendJsonString(*elem.getStringValue(), out);
+      return;
+    case ValueKind::kArray:
+    case ValueKind::kObject: {
+      const bool is_object = elem.getValueKind() == ValueKind::kObject;
+      out += is_object ? '{' : '[';
+      bool first{true};
+      elem.forEachElement([&out, &first, is_object](MsgPackElementType child) {
+        if (!first) {
+          out += ',';
+        }
+        first = false;
+        if (is_object) {
+          appendJsonString(child.getKeyView(), out);
+          out += ':';
+        }
+        appendJson(child, out);
+        return Result::SUCCESS;
+      });
+      out += is_object ? '}' : ']';
+      return;
+    }
+  }
+}
+
+}  // namespace
+
+}  // namespace parser
@@ -0,0 +1,115 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/16 00:26:02
+# Desc   : MessagePack 后端: 一遍扫描生成先序的节点数组, 数值在解析时解码, 字符串是指向输入的 string_view
+########################################################################
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../enable_parser.h"
+#include "../result.h"
+#include "../value_kind.h"
+#include "key_name_cache.h"
+
+namespace parser {
+
+struct MsgPackNode {
+  uint64_t value{0};     // 整数: 数值(negative 时按 int64_t 解释); 浮点数: double 的位; bool: 0/1; 字符串: 内容的偏移
+  uint32_t size{0};      // 字符串的字节数; 数组、映射的元素个数
+  uint32_t next{0};      // 下一个兄弟节点的下标(跳过整棵子树)
+  uint32_t key{0};       // 映射中的成员: key 的偏移
+  uint32_t key_size{0};
+  ValueKind kind{ValueKind::kNull};
+  bool negative{false};
+  bool has_key{false};
+};  // struct MsgPackNode
+
+class MsgPackParser;
+
+// 节点只记录下标, 生命周期不能超过所属的 parser 和输入内容
+class MsgPackElementType {
+public:
+  MsgPackElementType() = default;
+  MsgPackElementType(const MsgPackParser* doc, uint32_t index) : doc_(doc), index_(index) {}
+
+  // nil 视为不存在
+  bool isValid() const;
+  std::optional<std::string> getValueText() const;
+  ValueKind getValueKind() const;
+  size_t getElementCount() const;
+  std::optional<int64_t> getInt64Value() const;
+  std::optional<uint64_t> getUint64Value() const;
+  std::optional<double> getDoubleValue() const;
+  std::optional<bool> getBoolValue() const;
+  std::optional<std::string_view> getStringValue() const;
+  // 补上 '\0' 后保存在 parser 中, 在下一次 parse() 之前有效
+  const char* getKeyName() const;
+  std::string_view getKeyView() const;
+  MsgPackElementType toChildElem(std::string_view key) const;
+  template <typename F>
+  Result forEachElement(F&& f) const {
+    if (!isValid()) {
+      return Result::SUCCESS;
+    }
+    const MsgPackNode& n = node();
+    if (n.kind != ValueKind::kArray && n.kind != ValueKind::kObject) {
+      return Result::ERR_TYPE;
+    }
+    for (uint32_t i = index_ + 1; i < n.next; i = nodeAt(i).next) {
+      CHECK_SUCCESS_OR_RETURN(f(MsgPackElementType{doc_, i}));
+    }
+    return Result::SUCCESS;
+  }
+  // 输出为 json, 可以交给 json 后端重新解析(如 Lazy<T>)
+  std::string serializeToString() const;
+
+private:
+  const MsgPackNode& node() const {
+    return nodeAt(index_);
+  }
+  const MsgPackNode& nodeAt(uint32_t index) const;
+
+  const MsgPackParser* doc_{nullptr};
+  uint32_t index_{0};
+};  // class MsgPackElementType
+
+// 支持 nil、bool、整数、float32/64、str、bin(当作字符串)、array 和 map; map 的 key 只能是 str,
+// 遇到 ext 类型或其他类型的 key 时返回 ERR_ILL_FORMED; 输入必须恰好是一个值
+class MsgPackParser {
+public:
+  using ElemType = MsgPackElementType;
+  // 节点数组在多次 parse 之间复用
+  Result parse(std::string_view content);
+  ElemType toRootElemType() const;
+private:
+  friend class MsgPackElementType;
+  const char* data_{nullptr};
+  std::vector<MsgPackNode> nodes_;
+  mutable KeyNameCache key_names_;
+};  // class MsgPackParser
+
+inline const MsgPackNode& MsgPackElementType::nodeAt(uint32_t index) const {
+  return doc_->nodes_[index];
+}
+
+}  // namespace parser
+
+namespace detail {
+template <>
+inline constexpr bool enable_member_walk<parser::MsgPackElementType> = true;
+template <>
+inline constexpr bool enable_parallel_deserialize<parser::MsgPackElementType> = true;
+}  // namespace detail
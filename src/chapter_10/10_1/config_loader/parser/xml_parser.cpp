@@ -0,0 +1,669 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/16 00:21:37
+# Desc   :
+########################################################################
+*/
+
+#include "xml_parser.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <system_error>
+
+namespace parser {
+
+namespace {
+
+// 嵌套层数的上限, 避免恶意输入导致栈溢出
+constexpr int kMaxDepth = 512;
+
+bool isSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+bool isDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+// 名字中不能出现的字符之外都接受, 不检查 XML 规定的名字字符集
+bool isNameChar(char c) {
+  return !isSpace(c) && c != '/' && c != '>' && c != '<' && c != '=' && c != '"' && c != '\'' && c != '&';
+}
+
+std::string_view trim(std::string_view text) {
+  while (!text.empty() && isSpace(text.front())) {
+    text.remove_prefix(1);
+  }
+  while (!text.empty() && isSpace(text.back())) {
+    text.remove_suffix(1);
+  }
+  return text;
+}
+
+template <typename Number>
+std::optional<Number> parseNumber(std::string_view text) {
+  text = trim(text);
+  if (text.empty()) {
+    return std::nullopt;
+  }
+  Number value{};
+  auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+  if (ec != std::errc{} || ptr != text.data() + text.size()) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+std::optional<bool> parseBool(std::string_view text) {
+  text = trim(text);
+  if (text == "true" || text == "1") {
+    return true;
+  }
+  if (text == "false" || text == "0") {
+    return false;
+  }
+  return std::nullopt;
+}
+
+// 只把 json 写法的数字当作数字, 避免 inf、nan 之类的单词被识别为浮点数
+ValueKind resolveText(std::string_view text) {
+  text = trim(text);
+  if (text == "true" || text == "false") {
+    return ValueKind::kBool;
+  }
+  const std::string_view digits = text.starts_with('-') ? text.substr(1) : text;
+  if (digits.empty() || !isDigit(digits.front())) {
+    return ValueKind::kString;
+  }
+  if (std::ranges::all_of(digits, isDigit)) {
+    // 超出 64 位的整数按浮点数处理
+    const bool fits = parseNumber<int64_t>(text).has_value() || parseNumber<uint64_t>(text).has_value();
+    return fits ? ValueKind::kInteger : ValueKind::kReal;
+  }
+  return parseNumber<double>(text).has_value() ? ValueKind::kReal : ValueKind::kString;
+}
+
+// 字符引用的编码长度不会超过它本身的长度(&#x80; 6 个字符对应 2 字节), 可以原地写入
+char* writeUtf8(char* out, uint32_t code) {
+  if (code < 0x80) {
+    *out++ = static_cast<char>(code);
+  } else if (code < 0x800) {
+    *out++ = static_cast<char>(0xC0 | (code >> 6));
+    *out++ = static_cast<char>(0x80 | (code & 0x3F));
+  } else if (code < 0x10000) {
+    *out++ = static_cast<char>(0xE0 | (code >> 12));
+    *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+    *out++ = static_cast<char>(0x80 | (code & 0x3F));
+  } else {
+    *out++ = static_cast<char>(0xF0 | (code >> 18));
+    *out++ = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+    *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+    *out++ = static_cast<char>(0x80 | (code & 0x3F));
+  }
+  return out;
+}
+
+void appendJsonString(std::string_view value, std::string& out) {
+  static constexpr char kHex[] = "0123456789abcdef";
+  out += '"';
+  for (char c : value) {
+    switch (c) {
+      case '"': out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\n': out += "\\n"; break;
+      case '\r': out += "\\r"; break;
+      case '\t': out += "\\t"; break;
+      case '\b': out += "\\b"; break;
+      case '\f': out += "\\f"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out += "\\u00";
+          out += kHex[(c >> 4) & 0xF];
+          out += kHex[c & 0xF];
+        } else {
+          out += c;
+        }
+    }
+  }
+  out += '"';
+}
+
+template <typename Number>
+void appendNumber(Number value, std::string& out) {
+  char buf[32];
+  auto [ptr, ec] = std::to_chars(buf, buf + sizeof(buf), value);
+  out.append(buf, ptr);
+}
+
+// 一遍扫描缓冲区, 按先序生成节点; 反转义后的内容写回缓冲区中原来的位置(只会变短), 名字后面写入 '\0'
+class XmlBuilder {
+public:
+  XmlBuilder(std::span<char> data, std::vector<XmlNode>& nodes)
+      : begin_(data.data()), p_(data.data()), end_(data.data() + data.size()), nodes_(nodes) {}
+
+  Result build() {
+    if (startsWith("\xEF\xBB\xBF")) {
+      p_ += 3;
+    }
+    if (!skipMisc()) {
+      return Result::ERR_ILL_FORMED;
+    }
+    if (p_ == end_ || *p_ != '<') {
+      return Result::ERR_ILL_FORMED;
+    }
+    if (!parseElement(0)) {
+      return Result::ERR_ILL_FORMED;
+    }
+    // 根元素之后只能有注释、处理指令和空白
+    if (!skipMisc() || p_ != end_) {
+      return Result::ERR_ILL_FORMED;
+    }
+    return Result::SUCCESS;
+  }
+
+private:
+  bool startsWith(std::string_view prefix) const {
+    return static_cast<size_t>(end_ - p_) >= prefix.size() && std::memcmp(p_, prefix.data(), prefix.size()) == 0;
+  }
+
+  void skipSpace() {
+    while (p_ != end_ && isSpace(*p_)) {
+      ++p_;
+    }
+  }
+
+  // 跳过到 terminator 之后, 没有找到时返回 false
+  bool skipPast(std::string_view terminator) {
+    std::string_view rest(p_, end_ - p_);
+    size_t pos = rest.find(terminator);
+    if (pos == std::string_view::npos) {
+      return false;
+    }
+    p_ += pos + terminator.size();
+    return true;
+  }
+
+  // 根元素前后的空白、注释、处理指令(包括 <?xml ...?>)和 DOCTYPE
+  bool skipMisc() {
+    while (true) {
+      skipSpace();
+      if (startsWith("<!--")) {
+        p_ += 4;
+        if (!skipPast("-->")) {
+          return false;
+        }
+      } else if (startsWith("<?")) {
+        if (!skipPast("?>")) {
+          return false;
+        }
+      } else if (startsWith("<!DOCTYPE")) {
+        if (!skipDoctype()) {
+          return false;
+        }
+      } else {
+        return true;
+      }
+    }
+  }
+
+  // 内部子集 [...] 中的声明只跳过, 不生效
+  bool skipDoctype() {
+    int brackets{0};
+    for (char quote{0}; p_ != end_; ++p_) {
+      const char c = *p_;
+      if (quote != 0) {
+        quote = c == quote ? 0 : quote;
+      } else if (c == '"' || c == '\'') {
+        quote = c;
+      } else if (c == '[') {
+        ++brackets;
+      } else if (c == ']') {
+        --brackets;
+      } else if (c == '>' && brackets == 0) {
+        ++p_;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  char* scanName() {
+    while (p_ != end_ && isNameChar(*p_)) {
+      ++p_;
+    }
+    return p_;
+  }
+
+  uint32_t offset(const char* p) const {
+    return static_cast<uint32_t>(p - begin_);
+  }
+
+  // p_ 指向 '&', 把实体对应的字符写到 out, 返回写入后的位置; 不认识的实体返回 nullptr
+  char* decodeEntity(char* out) {
+    char* semicolon = static_cast<char*>(std::memchr(p_, ';', std::min<ptrdiff_t>(end_ - p_, 12)));
+    if (semicolon == nullptr) {
+      return nullptr;
+    }
+    std::string_view name(p_ + 1, semicolon - p_ - 1);
+    p_ = semicolon + 1;
+    if (name == "lt") {
+      *out++ = '<';
+    } else if (name == "gt") {
+      *out++ = '>';
+    } else if (name == "amp") {
+      *out++ = '&';
+    } else if (name == "quot") {
+      *out++ = '"';
+    } else if (name == "apos") {
+      *out++ = '\'';
+    } else if (name.starts_with('#')) {
+      name.remove_prefix(1);
+      int base{10};
+      if (name.starts_with('x')) {
+        base = 16;
+        name.remove_prefix(1);
+      }
+      uint32_t code{0};
+      auto [ptr, ec] = std::from_chars(name.data(), name.data() + name.size(), code, base);
+      if (name.empty() || ec != std::errc{} || ptr != name.data() + name.size() || code == 0 || code > 0x10FFFF ||
+          (code >= 0xD800 && code <= 0xDFFF)) {
+        return nullptr;
+      }
+      out = writeUtf8(out, code);
+    } else {
+      return nullptr;
+    }
+    return out;
+  }
+
+  // p_ 指向引号; 属性值中的空白字符规范化为空格
+  bool parseAttributeValue(uint32_t& text, uint32_t& text_size) {
+    const char quote = *p_++;
+    char* out = p_;
+    text = offset(out);
+    while (true) {
+      if (p_ == end_ || *p_ == '<') {
+        return false;
+      }
+      const char c = *p_;
+      if (c == quote) {
+        break;
+      }
+      if (c == '&') {
+        if (out = decodeEntity(out); out == nullptr) {
+          return false;
+        }
+        continue;
+      }
+      if (c == '\r' && p_ + 1 != end_ && p_[1] == '\n') {
+        ++p_;
+      }
+      *out++ = isSpace(c) ? ' ' : c;
+      ++p_;
+    }
+    ++p_;  // 引号
+    text_size = offset(out) - text;
+    *out = '\0';
+    return true;
+  }
+
+  // p_ 指向 '<', 解析整个元素直到结束标签之后
+  bool parseElement(int depth) {
+    if (depth >= kMaxDepth) {
+      return false;
+    }
+    ++p_;
+    char* name = p_;
+    char* name_end = scanName();
+    if (name == name_end || p_ == end_) {
+      return false;
+    }
+    const uint32_t index = static_cast<uint32_t>(nodes_.size());
+    nodes_.push_back(XmlNode{.name = offset(name), .name_size = offset(name_end) - offset(name)});
+    uint32_t count{0};
+
+    // 属性
+    while (true) {
+      char* before_space = p_;
+      skipSpace();
+      if (p_ == end_) {
+        return false;
+      }
+      if (*p_ == '>' || *p_ == '/') {
+        break;
+      }
+      if (p_ == before_space) {
+        return false;  // 名字和属性、属性和属性之间需要空白
+      }
+      char* attr_name = p_;
+      char* attr_name_end = scanName();
+      if (attr_name == attr_name_end) {
+        return false;
+      }
+      skipSpace();
+      if (p_ == end_ || *p_ != '=') {
+        return false;
+      }
+      ++p_;
+      *attr_name_end = '\0';
+      skipSpace();
+      if (p_ == end_ || (*p_ != '"' && *p_ != '\'')) {
+        return false;
+      }
+      XmlNode attr{.name = offset(attr_name), .name_size = offset(attr_name_end) - offset(attr_name),
+                   .is_attribute = true};
+      if (!parseAttributeValue(attr.text, attr.text_size)) {
+        return false;
+      }
+      attr.next = static_cast<uint32_t>(nodes_.size()) + 1;
+      nodes_.push_back(attr);
+      ++count;
+    }
+
+    if (*p_ == '/') {
+      ++p_;
+      if (p_ == end_ || *p_ != '>') {
+        return false;
+      }
+      ++p_;
+      *name_end = '\0';  // '>' 或 '/' 已经读过, 可以覆盖
+      finishElement(index, count, name, 0, false);
+      return true;
+    }
+    ++p_;  // '>'
+    *name_end = '\0';
+
+    // 内容: 只有文本时原地反转义, 出现子元素后不再写回, 避免覆盖子元素已经处理过的内容
+    char* text = p_;
+    char* out = p_;
+    bool has_children{false};
+    while (true) {
+      // 普通字符整段跳过, 前面有内容变短时整段前移
+      char* run = p_;
+      while (p_ != end_ && *p_ != '<' && *p_ != '&' && *p_ != '\r') {
+        ++p_;
+      }
+      if (!has_children) {
+        if (out != run) {
+          std::memmove(out, run, p_ - run);
+        }
+        out += p_ - run;
+      }
+      if (p_ == end_) {
+        return false;
+      }
+      const char c = *p_;
+      if (c == '<') {
+        if (startsWith("</")) {
+          p_ += 2;
+          if (!has_children) {
+            *out = '\0';
+          }
+          char* end_name = p_;
+          if (scanName() - end_name != name_end - name || std::memcmp(end_name, name, name_end - name) != 0) {
+            return false;
+          }
+          skipSpace();
+          if (p_ == end_ || *p_ != '>') {
+            return false;
+          }
+          ++p_;
+          finishElement(index, count, text, has_children ? 0 : offset(out) - offset(text), has_children);
+          return true;
+        }
+        if (startsWith("<!--")) {
+          p_ += 4;
+          if (!skipPast("-->")) {
+            return false;
+          }
+        } else if (startsWith("<![CDATA[")) {
+          p_ += 9;
+          char* cdata = p_;
+          if (!skipPast("]]>")) {
+            return false;
+          }
+          if (!has_children) {
+            const size_t size = p_ - 3 - cdata;
+            std::memmove(out, cdata, size);
+            out += size;
+          }
+        } else if (startsWith("<?")) {
+          if (!skipPast("?>")) {
+            return false;
+          }
+        } else if (startsWith("<!")) {
+          return false;
+        } else {
+          has_children = true;
+          if (!parseElement(depth + 1)) {
+            return false;
+          }
+          ++count;
+        }
+        continue;
+      }
+      if (c == '&') {
+        char discarded[4];
+        char* decoded = decodeEntity(has_children ? discarded : out);
+        if (decoded == nullptr) {
+          return false;
+        }
+        out = has_children ? out : decoded;
+        continue;
+      }
+      // 换行规范化: \r\n 和单独的 \r 都变为 \n
+      if (!has_children) {
+        *out++ = '\n';
+      }
+      if (p_ + 1 != end_ && p_[1] == '\n') {
+        ++p_;
+      }
+      ++p_;
+    }
+  }
+
+  void finishElement(uint32_t index, uint32_t count, const char* text, uint32_t text_size, bool has_children) {
+    XmlNode& node = nodes_[index];
+    node.text = offset(text);
+    node.text_size = text_size;
+    node.count = count;
+    node.has_children = has_children;
+    node.next = static_cast<uint32_t>(nodes_.size());
+  }
+
+  char* const begin_;
+  char* p_;
+  char* const end_;
+  std::vector<XmlNode>& nodes_;
+};  // class XmlBuilder
+
+void appendJson(const XmlElementType& elem, std::string& out);
+
+}  // namespace
+
+Result XmlParser::parse(std::string_view content) {
+  buffer_.assign(content);
+  return parseInSitu(buffer_);
+}
+
+Result XmlParser::parseInSitu(std::span<char> data) {
+  nodes_.clear();
+  data_ = data.data();
+  if (data.size() >= UINT32_MAX) {
+    return Result::ERR_ILL_FORMED;
+  }
+  // 元素和属性的个数大致与 '<' 的个数相当
+  nodes_.reserve(static_cast<size_t>(std::count(data.begin(), data.end(), '<')));
+  auto res = XmlBuilder{data, nodes_}.build();
+  if (res != Result::SUCCESS) {
+    nodes_.clear();
+  }
+  return res;
+}
+
+XmlParser::ElemType XmlParser::toRootElemType() const {
+  return nodes_.empty() ? ElemType{} : ElemType{this, 0};
+}
+
+std::string_view XmlElementType::text() const {
+  const XmlNode& n = node();
+  return std::string_view(doc_->data_ + n.text, n.text_size);
+}
+
+bool XmlElementType::isBlankText() const {
+  return trim(text()).empty();
+}
+
+bool XmlElementType::isValid() const {
+  return doc_ != nullptr;
+}
+
+std::optional<std::string> XmlElementType::getValueText() const {
+  if (auto view = getStringValue(); view.has_value()) {
+    return std::string(*view);
+  }
+  return std::nullopt;
+}
+
+ValueKind XmlElementType::getValueKind() const {
+  if (doc_ == nullptr) {
+    return ValueKind::kNull;
+  }
+  const XmlNode& n = node();
+  if (!n.is_attribute && (n.count != 0 || isBlankText())) {
+    return ValueKind::kObject;
+  }
+  return resolveText(text());
+}
+
+size_t XmlElementType::getElementCount() const {
+  return doc_ == nullptr ? 0 : node().count;
+}
+
+std::optional<int64_t> XmlElementType::getInt64Value() const {
+  if (doc_ == nullptr || node().has_children) {
+    return std::nullopt;
+  }
+  return parseNumber<int64_t>(text());
+}
+
+std::optional<uint64_t> XmlElementType::getUint64Value() const {
+  if (doc_ == nullptr || node().has_children) {
+    return std::nullopt;
+  }
+  return parseNumber<uint64_t>(text());
+}
+
+std::optional<double> XmlElementType::getDoubleValue() const {
+  if (doc_ == nullptr || node().has_children) {
+    return std::nullopt;
+  }
+  return parseNumber<double>(text());
+}
+
+std::optional<bool> XmlElementType::getBoolValue() const {
+  if (doc_ == nullptr || node().has_children) {
+    return std::nullopt;
+  }
+  return parseBool(text());
+}
+
+std::optional<std::string_view> XmlElementType::getStringValue() const {
+  if (doc_ == nullptr || node().has_children) {
+    return std::nullopt;
+  }
+  return text();
+}
+
+const char* XmlElementType::getKeyName() const {
+  return doc_ == nullptr ? nullptr : doc_->data_ + node().name;
+}
+
+std::string_view XmlElementType::getKeyView() const {
+  if (doc_ == nullptr) {
+    return {};
+  }
+  return std::string_view(doc_->data_ + node().name, node().name_size);
+}
+
+XmlElementType XmlElementType::toChildElem(std::string_view key) const {
+  if (doc_ == nullptr || node().is_attribute) {
+    return XmlElementType{};
+  }
+  for (uint32_t i = index_ + 1; i < node().next; i = nodeAt(i).next) {
+    XmlElementType child{doc_, i};
+    if (child.getKeyView() == key) {
+      return child;
+    }
+  }
+  return XmlElementType{};
+}
+
+std::string XmlElementType::serializeToString() const {
+  std::string out;
+  appendJson(*this, out);
+  return out;
+}
+
+namespace {
+
+void appendJson(const XmlElementType& elem, std::string& out) {
+  switch (elem.getValueKind()) {
+    case ValueKind::kNull:
+      out += "null";
+      return;
+    case ValueKind::kBool:
+      out += *elem.getBoolValue() ? "true" : "false";
+      return;
+    case ValueKind::kInteger:
+      if (auto value = elem.getInt64Value(); value.has_value()) {
+        appendNumber(*value, out);
+        return;
+      }
+      if (auto value = elem.getUint64Value(); value.has_value()) {
+        appendNumber(*value, out);
+        return;
+      }
+      [[fallthrough]];
+    case ValueKind::kReal:
+      if (auto value = elem.getDoubleValue(); value.has_value() && std::isfinite(*value)) {
+        appendNumber(*value, out);
+      } else {
+        out += "null";
+      }
+      return;
+    case ValueKind::kString:
+      appendJsonString(elem.getStringValue().value_or(std::string_view{}), out);
+      return;
+    case ValueKind::kArray:
+    case ValueKind::kObject: {
+      out += '{';
+      bool first{true};
+      elem.forEachElement([&out, &first](XmlElementType child) {
+        if (!first) {
+          out += ',';
+        }
+        first = false;
+        appendJsonString(child.getKeyView(), out);
+        out += ':';
+        appendJson(child, out);
+        return Result::SUCCESS;
+      });
+      out += '}';
+      return;
+    }
+  }
+}
+
+}  // namespace
+
+}  // namespace parser
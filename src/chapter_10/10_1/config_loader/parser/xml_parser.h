@@ -0,0 +1,125 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/16 00:24:20
+# Desc   : 不依赖第三方库的 XML 后端: 在输入缓冲区中原地解析(反转义、写入 '\0'), 节点按先序存放在一个数组中
+########################################################################
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../enable_parser.h"
+#include "../result.h"
+#include "../value_kind.h"
+
+namespace parser {
+
+// 元素和属性都是节点; 偏移都相对于被解析的缓冲区
+struct XmlNode {
+  uint32_t name{0};        // 名字以 '\0' 结尾
+  uint32_t name_size{0};
+  uint32_t text{0};        // 元素: 反转义后的文本(有子元素时为空); 属性: 反转义后的值
+  uint32_t text_size{0};
+  uint32_t next{0};        // 下一个兄弟节点的下标(跳过整棵子树)
+  uint32_t count{0};       // 元素的属性和子元素个数
+  bool is_attribute{false};
+  bool has_children{false};  // 有子元素, 文本被忽略
+};  // struct XmlNode
+
+class XmlParser;
+
+// 元素的成员是它的属性和子元素, 名字作为 key: <point x="1"><y>2</y></point> 与 {"x": 1, "y": 2} 等价;
+// 数组写成包装元素, 子元素的名字不限: <children><node/><node/></children>
+// 节点只记录下标, 生命周期不能超过所属的 parser 和被解析的缓冲区
+class XmlElementType {
+public:
+  XmlElementType() = default;
+  XmlElementType(const XmlParser* doc, uint32_t index) : doc_(doc), index_(index) {}
+
+  bool isValid() const;
+  // 有子元素时返回 std::nullopt
+  std::optional<std::string> getValueText() const;
+  // 有属性、子元素或者文本只有空白的元素是对象; 其他的按文本的写法推断: true/false、整数、浮点数, 否则为字符串
+  ValueKind getValueKind() const;
+  size_t getElementCount() const;
+  // 数值和 bool 忽略文本两端的空白
+  std::optional<int64_t> getInt64Value() const;
+  std::optional<uint64_t> getUint64Value() const;
+  std::optional<double> getDoubleValue() const;
+  std::optional<bool> getBoolValue() const;
+  std::optional<std::string_view> getStringValue() const;
+  // 名字在缓冲区中以 '\0' 结尾, 不需要拷贝, 在下一次 parse() 之前有效
+  const char* getKeyName() const;
+  std::string_view getKeyView() const;
+  // 先找属性, 再找子元素, 同名时取第一个
+  XmlElementType toChildElem(std::string_view key) const;
+  template <typename F>
+  Result forEachElement(F&& f) const {
+    if (!isValid()) {
+      return Result::SUCCESS;
+    }
+    const XmlNode& n = node();
+    if (n.is_attribute || (n.count == 0 && !isBlankText())) {
+      return Result::ERR_TYPE;
+    }
+    for (uint32_t i = index_ + 1; i < n.next; i = nodeAt(i).next) {
+      CHECK_SUCCESS_OR_RETURN(f(XmlElementType{doc_, i}));
+    }
+    return Result::SUCCESS;
+  }
+  // 输出为 json(属性和子元素都作为对象的成员), 可以交给 json 后端重新解析(如 Lazy<T>)
+  std::string serializeToString() const;
+
+private:
+  const XmlNode& node() const {
+    return nodeAt(index_);
+  }
+  const XmlNode& nodeAt(uint32_t index) const;
+  std::string_view text() const;
+  bool isBlankText() const;
+
+  const XmlParser* doc_{nullptr};
+  uint32_t index_{0};
+};  // class XmlElementType
+
+// 支持元素、属性、文本、CDATA、注释、处理指令、DOCTYPE(跳过)和预定义的实体(&lt; 等)以及字符引用(&#...;);
+// 不支持自定义实体和命名空间(前缀作为名字的一部分), 文本与子元素混排时忽略文本
+class XmlParser {
+public:
+  using ElemType = XmlElementType;
+  // 拷贝到内部的缓冲区后原地解析, 缓冲区和节点数组在多次 parse 之间复用
+  Result parse(std::string_view content);
+  // 直接在 data 中原地解析, 省掉拷贝: 会改写 data 的内容, 节点引用 data, 生命周期不能超过它
+  Result parseInSitu(std::span<char> data);
+  ElemType toRootElemType() const;
+private:
+  friend class XmlElementType;
+  std::string buffer_;
+  const char* data_{nullptr};
+  std::vector<XmlNode> nodes_;
+};  // class XmlParser
+
+inline const XmlNode& XmlElementType::nodeAt(uint32_t index) const {
+  return doc_->nodes_[index];
+}
+
+}  // namespace parser
+
+namespace detail {
+template <>
+inline constexpr bool enable_member_walk<parser::XmlElementType> = true;
+template <>
+inline constexpr bool enable_parallel_deserialize<parser::XmlElementType> = true;
+}  // namespace detail
@@ -13,4 +13,1145 @@
 
 #include "yaml_parser.h"
 
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <system_error>
 
+namespace parser {
+
+namespace {
+
+// 嵌套层数的上限, 避免恶意输入导致栈溢出
+constexpr int kMaxDepth = 512;
+
+bool isBlank(char c) {
+  return c == ' ' || c == '\t';
+}
+
+bool isBreak(char c) {
+  return c == '\n' || c == '\r';
+}
+
+bool isFlowIndicator(char c) {
+  return c == ',' || c == '[' || c == ']' || c == '{' || c == '}';
+}
+
+bool isDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+bool allOf(std::string_view text, bool (*pred)(char)) {
+  return !text.empty() && std::all_of(text.begin(), text.end(), pred);
+}
+
+bool isOctDigit(char c) {
+  return c >= '0' && c <= '7';
+}
+
+bool isHexDigit(char c) {
+  return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+bool isOneOf(std::string_view text, std::initializer_list<std::string_view> candidates) {
+  return std::find(candidates.begin(), candidates.end(), text) != candidates.end();
+}
+
+// [-+]?(\.[0-9]+|[0-9]+(\.[0-9]*)?)([eE][-+]?[0-9]+)?
+bool isFloatText(std::string_view text) {
+  size_t i{0};
+  if (i < text.size() && (text[i] == '-' || text[i] == '+')) {
+    ++i;
+  }
+  size_t int_digits{0};
+  while (i < text.size() && isDigit(text[i])) {
+    ++i;
+    ++int_digits;
+  }
+  size_t frac_digits{0};
+  if (i < text.size() && text[i] == '.') {
+    ++i;
+    while (i < text.size() && isDigit(text[i])) {
+      ++i;
+      ++frac_digits;
+    }
+  }
+  if (int_digits + frac_digits == 0) {
+    return false;
+  }
+  if (i < text.size() && (text[i] == 'e' || text[i] == 'E')) {
+    ++i;
+    if (i < text.size() && (text[i] == '-' || text[i] == '+')) {
+      ++i;
+    }
+    if (i == text.size() || !isDigit(text[i])) {
+      return false;
+    }
+    while (i < text.size() && isDigit(text[i])) {
+      ++i;
+    }
+  }
+  return i == text.size();
+}
+
+// 普通标量按 YAML 1.2 core schema 确定类型
+ValueKind resolvePlain(std::string_view text) {
+  if (text.empty() || isOneOf(text, {"~", "null", "Null", "NULL"})) {
+    return ValueKind::kNull;
+  }
+  if (isOneOf(text, {"true", "True", "TRUE", "false", "False", "FALSE"})) {
+    return ValueKind::kBool;
+  }
+  std::string_view digits = text;
+  if (digits[0] == '-' || digits[0] == '+') {
+    digits.remove_prefix(1);
+  }
+  if (allOf(digits, isDigit)
+      || (text.starts_with("0o") && allOf(text.substr(2), isOctDigit))
+      || (text.starts_with("0x") && allOf(text.substr(2), isHexDigit))) {
+    return ValueKind::kInteger;
+  }
+  if (isFloatText(text) || isOneOf(digits, {".inf", ".Inf", ".INF"}) || isOneOf(text, {".nan", ".NaN", ".NAN"})) {
+    return ValueKind::kReal;
+  }
+  return ValueKind::kString;
+}
+
+template <typename Integer>
+std::optional<Integer> parseInteger(std::string_view text) {
+  int base{10};
+  if (text.starts_with("0x")) {
+    base = 16;
+    text.remove_prefix(2);
+  } else if (text.starts_with("0o")) {
+    base = 8;
+    text.remove_prefix(2);
+  } else if (text.starts_with('+')) {
+    text.remove_prefix(1);
+  }
+  Integer value{};
+  auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value, base);
+  if (ec != std::errc{} || ptr != text.data() + text.size()) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+std::optional<double> parseReal(std::string_view text) {
+  const bool negative = text.starts_with('-');
+  if (text.starts_with('-') || text.starts_with('+')) {
+    text.remove_prefix(1);
+  }
+  double value{};
+  if (isOneOf(text, {".inf", ".Inf", ".INF"})) {
+    value = std::numeric_limits<double>::infinity();
+  } else if (isOneOf(text, {".nan", ".NaN", ".NAN"})) {
+    value = std::numeric_limits<double>::quiet_NaN();
+  } else {
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc{} || ptr != text.data() + text.size()) {
+      return std::nullopt;
+    }
+  }
+  return negative ? -value : value;
+}
+
+void appendUtf8(std::string& out, uint32_t code) {
+  if (code < 0x80) {
+    out += static_cast<char>(code);
+  } else if (code < 0x800) {
+    out += static_cast<char>(0xC0 | (code >> 6));
+    out += static_cast<char>(0x80 | (code & 0x3F));
+  } else if (code < 0x10000) {
+    out += static_cast<char>(0xE0 | (code >> 12));
+    out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (code & 0x3F));
+  } else {
+    out += static_cast<char>(0xF0 | (code >> 18));
+    out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+    out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (code & 0x3F));
+  }
+}
+
+// 引号中的换行: 换行两侧的空白去掉, 单个换行变为空格, 连续 n 个换行变为 n - 1 个 '\n'
+// i 指向换行符, 返回处理后下一行内容的位置
+size_t foldLineBreak(std::string_view raw, size_t i, std::string& out) {
+  while (!out.empty() && isBlank(out.back())) {
+    out.pop_back();
+  }
+  size_t breaks{0};
+  while (i < raw.size() && (isBreak(raw[i]) || isBlank(raw[i]))) {
+    if (raw[i] == '\n') {
+      ++breaks;
+    }
+    ++i;
+  }
+  if (breaks <= 1) {
+    out += ' ';
+  } else {
+    out.append(breaks - 1, '\n');
+  }
+  return i;
+}
+
+bool unescapeSingleQuoted(std::string_view raw, std::string& out) {
+  out.clear();
+  for (size_t i = 0; i < raw.size();) {
+    if (raw[i] == '\'') {
+      out += '\'';
+      i += 2;  // ''
+    } else if (isBreak(raw[i])) {
+      i = foldLineBreak(raw, i, out);
+    } else {
+      out += raw[i++];
+    }
+  }
+  return true;
+}
+
+bool unescapeDoubleQuoted(std::string_view raw, std::string& out) {
+  out.clear();
+  for (size_t i = 0; i < raw.size();) {
+    const char c = raw[i];
+    if (isBreak(c)) {
+      i = foldLineBreak(raw, i, out);
+      continue;
+    }
+    if (c != '\\') {
+      out += c;
+      ++i;
+      continue;
+    }
+    if (++i == raw.size()) {
+      return false;
+    }
+    const char e = raw[i++];
+    if (isBreak(e)) {
+      // 转义的换行: 直接连接下一行, 去掉下一行开头的空白
+      if (e == '\r' && i < raw.size() && raw[i] == '\n') {
+        ++i;
+      }
+      while (i < raw.size() && isBlank(raw[i])) {
+        ++i;
+      }
+      continue;
+    }
+    size_t hex_len{0};
+    switch (e) {
+      case '0': out += '\0'; break;
+      case 'a': out += '\a'; break;
+      case 'b': out += '\b'; break;
+      case 't': case '\t': out += '\t'; break;
+      case 'n': out += '\n'; break;
+      case 'v': out += '\v'; break;
+      case 'f': out += '\f'; break;
+      case 'r': out += '\r'; break;
+      case 'e': out += '\x1b'; break;
+      case ' ': out += ' '; break;
+      case '"': out += '"'; break;
+      case '/': out += '/'; break;
+      case '\\': out += '\\'; break;
+      case 'N': appendUtf8(out, 0x85); break;
+      case '_': appendUtf8(out, 0xA0); break;
+      case 'L': appendUtf8(out, 0x2028); break;
+      case 'P': appendUtf8(out, 0x2029); break;
+      case 'x': hex_len = 2; break;
+      case 'u': hex_len = 4; break;
+      case 'U': hex_len = 8; break;
+      default: return false;
+    }
+    if (hex_len > 0) {
+      if (raw.size() - i < hex_len || !std::all_of(raw.begin() + i, raw.begin() + i + hex_len, isHexDigit)) {
+        return false;
+      }
+      uint32_t code{0};
+      std::from_chars(raw.data() + i, raw.data() + i + hex_len, code, 16);
+      if (code > 0x10FFFF) {
+        return false;
+      }
+      appendUtf8(out, code);
+      i += hex_len;
+    }
+  }
+  return true;
+}
+
+// 块标量: 去掉每行的缩进, | 保留换行, > 把相邻的普通行用空格连接; 末尾的换行按 chomp 处理
+void foldBlockScalar(const YamlNode& node, std::string& out) {
+  out.clear();
+  const size_t indent = node.block_indent;
+  size_t pending_breaks{0};  // 尚未输出的空行数
+  bool first{true};
+  bool prev_more_indented{false};
+  std::string_view text = node.text;
+  while (!text.empty()) {
+    size_t eol = text.find('\n');
+    std::string_view line = text.substr(0, eol);
+    text = eol == std::string_view::npos ? std::string_view{} : text.substr(eol + 1);
+    if (line.ends_with('\r')) {
+      line.remove_suffix(1);
+    }
+    if (line.size() <= indent && line.find_first_not_of(' ') == std::string_view::npos) {
+      ++pending_breaks;
+      continue;
+    }
+    line.remove_prefix(std::min(indent, line.size()));
+    const bool more_indented = isBlank(line.front());
+    if (first) {
+      out.append(pending_breaks, '\n');
+    } else if (node.style == YamlStyle::kLiteral || more_indented || prev_more_indented) {
+      out.append(pending_breaks + 1, '\n');
+    } else if (pending_breaks == 0) {
+      out += ' ';
+    } else {
+      out.append(pending_breaks, '\n');
+    }
+    out += line;
+    pending_breaks = 0;
+    first = false;
+    prev_more_indented = more_indented;
+  }
+  if (node.chomp == '-') {
+    return;
+  }
+  if (!first) {
+    out += '\n';
+  }
+  if (node.chomp == '+') {
+    out.append(pending_breaks, '\n');
+  }
+}
+
+void appendJsonString(std::string_view value, std::string& out) {
+  static constexpr char kHex[] = "0123456789abcdef";
+  out += '"';
+  for (char c : value) {
+    switch (c) {
+      case '"': out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\n': out += "\\n"; break;
+      case '\r': out += "\\r"; break;
+      case '\t': out += "\\t"; break;
+      case '\b': out += "\\b"; break;
+      case '\f': out += "\\f"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out += "\\u00";
+          out += kHex[(c >> 4) & 0xF];
+          out += kHex[c & 0xF];
+        } else {
+          out += c;
+        }
+    }
+  }
+  out += '"';
+}
+
+template <typename Number>
+void appendNumber(Number value, std::string& out) {
+  char buf[32];
+  auto [ptr, ec] = std::to_chars(buf, buf + sizeof(buf), value);
+  out.append(buf, ptr);
+}
+
+struct ScalarToken {
+  std::string_view text;
+  YamlStyle style{YamlStyle::kPlain};
+  bool simple{true};
+};  // struct ScalarToken
+
+// 一遍扫描输入, 按先序生成节点; 出错时返回 false, 错误记录在 error_ 中
+class YamlBuilder {
+public:
+  YamlBuilder(std::string_view content, std::vector<YamlNode>& nodes)
+      : p_(content.data()), end_(content.data() + content.size()), line_start_(p_), nodes_(nodes) {}
+
+  Result build() {
+    if (end_ - p_ >= 3 && std::string_view(p_, 3) == "\xEF\xBB\xBF") {
+      p_ += 3;
+      line_start_ = p_;
+    }
+    // 指令(%YAML、%TAG)和文档开始标记
+    bool has_content{false};
+    while ((has_content = skipToContent()) && column() == 0 && *p_ == '%') {
+      skipLine();
+    }
+    if (error_ != Result::SUCCESS) {
+      return error_;
+    }
+    if (has_content && isDocumentMarker("---")) {
+      p_ += 3;
+      skipBlanks();
+      if (!atLineEnd()) {
+        // --- 之后同一行的节点(如 --- {a: 1}), 不能是块映射
+        if (!parseNodeHere(-1, false)) {
+          return error_;
+        }
+        return finishDocument();
+      }
+    }
+    if (!skipToContent() || isDocumentMarker("...") || isDocumentMarker("---")) {
+      pushScalar({}, ValueKind::kNull);  // 空文档
+      return error_;
+    }
+    if (!parseNodeHere(-1, true)) {
+      return error_;
+    }
+    return finishDocument();
+  }
+
+private:
+  // 根节点之后只能有空白、注释和文档标记(之后的内容忽略)
+  Result finishDocument() {
+    if (skipToContent() && !isDocumentMarker("...") && !isDocumentMarker("---")) {
+      return Result::ERR_ILL_FORMED;
+    }
+    return error_;
+  }
+
+  bool fail() {
+    error_ = Result::ERR_ILL_FORMED;
+    return false;
+  }
+
+  int column() const {
+    return static_cast<int>(p_ - line_start_);
+  }
+
+  void newLine() {
+    if (*p_ == '\r' && p_ + 1 < end_ && p_[1] == '\n') {
+      ++p_;
+    }
+    ++p_;
+    line_start_ = p_;
+  }
+
+  void skipBlanks() {
+    while (p_ < end_ && isBlank(*p_)) {
+      ++p_;
+    }
+  }
+
+  void skipLine() {
+    while (p_ < end_ && !isBreak(*p_)) {
+      ++p_;
+    }
+    if (p_ < end_) {
+      newLine();
+    }
+  }
+
+  // 行尾或注释(# 前面必须是空白或行首)
+  bool atLineEnd() const {
+    return p_ == end_ || isBreak(*p_) || (*p_ == '#' && (p_ == line_start_ || isBlank(p_[-1])));
+  }
+
+  // 跳过空白、空行和注释, 停在下一个有内容的字符; 没有内容时返回 false
+  // 缩进中不能有 tab
+  bool skipToContent() {
+    while (p_ < end_) {
+      bool tab_in_indent{false};
+      while (p_ < end_ && isBlank(*p_)) {
+        tab_in_indent |= *p_ == '\t' && std::all_of(line_start_, p_, isBlank);
+        ++p_;
+      }
+      if (p_ == end_) {
+        return false;
+      }
+      if (atLineEnd()) {
+        skipLine();
+        continue;
+      }
+      if (tab_in_indent) {
+        return fail();
+      }
+      return true;
+    }
+    return false;
+  }
+
+  bool isDocumentMarker(std::string_view marker) const {
+    return column() == 0 && end_ - p_ >= 3 && std::string_view(p_, 3) == marker
+        && (p_ + 3 == end_ || isBlank(p_[3]) || isBreak(p_[3]));
+  }
+
+  // "- " 或行尾的 "-"
+  bool atSequenceEntry() const {
+    return *p_ == '-' && (p_ + 1 == end_ || isBlank(p_[1]) || isBreak(p_[1]));
+  }
+
+  // 块上下文中 key 之后的 ':'
+  bool atMappingColon() const {
+    return p_ < end_ && *p_ == ':' && (p_ + 1 == end_ || isBlank(p_[1]) || isBreak(p_[1]));
+  }
+
+  uint32_t pushNode(ValueKind kind) {
+    auto& node = nodes_.emplace_back();
+    node.kind = kind;
+    return static_cast<uint32_t>(nodes_.size() - 1);
+  }
+
+  void pushScalar(const ScalarToken& token, ValueKind kind) {
+    auto& node = nodes_[pushNode(kind)];
+    node.text = token.text;
+    node.style = token.style;
+    node.simple = token.simple;
+    node.next = static_cast<uint32_t>(nodes_.size());
+  }
+
+  void setKey(uint32_t index, const ScalarToken& key) {
+    auto& node = nodes_[index];
+    node.key = key.text;
+    node.key_style = key.style;
+    node.key_simple = key.simple;
+    node.has_key = true;
+  }
+
+  // 映射的值、序列的元素: 同一行没有内容时在后面的行中, 缩进必须大于 parent_indent;
+  // 映射的值可以是与 key 缩进相同的块序列
+  bool parseValue(int parent_indent, bool is_mapping_value) {
+    skipBlanks();
+    if (!atLineEnd()) {
+      // 映射的值与 key 在同一行时不能是块映射和块序列
+      return parseNodeHere(parent_indent, !is_mapping_value);
+    }
+    if (!skipToContent()) {
+      if (error_ != Result::SUCCESS) {
+        return false;
+      }
+      pushScalar({}, ValueKind::kNull);
+      return true;
+    }
+    if (isDocumentMarker("---") || isDocumentMarker("...")) {
+      pushScalar({}, ValueKind::kNull);
+      return true;
+    }
+    if (column() > parent_indent) {
+      return parseNodeHere(parent_indent, true);
+    }
+    if (is_mapping_value && column() == parent_indent && atSequenceEntry()) {
+      return parseBlockSequence();
+    }
+    pushScalar({}, ValueKind::kNull);
+    return true;
+  }
+
+  // p_ 指向节点的第一个字符
+  bool parseNodeHere(int parent_indent, bool allow_block_collection) {
+    if (++depth_ > kMaxDepth) {
+      return fail();
+    }
+    bool ok = parseNodeImpl(parent_indent, allow_block_collection);
+    --depth_;
+    return ok;
+  }
+
+  bool parseNodeImpl(int parent_indent, bool allow_block_collection) {
+    const char c = *p_;
+    if (atSequenceEntry()) {
+      return allow_block_collection ? parseBlockSequence() : fail();
+    }
+    if (c == '[' || c == '{') {
+      if (!parseFlowNode()) {
+        return false;
+      }
+      return endOfLine();
+    }
+    if (c == '|' || c == '>') {
+      return parseBlockScalar(parent_indent);
+    }
+    const int indent = column();
+    ScalarToken token;
+    if (!scanScalar(false, token)) {
+      return false;
+    }
+    skipBlanks();
+    if (atMappingColon()) {
+      return allow_block_collection ? parseBlockMapping(indent, token) : fail();
+    }
+    pushScalar(token, token.style == YamlStyle::kPlain ? resolvePlain(token.text) : ValueKind::kString);
+    return endOfLine();
+  }
+
+  // 节点之后到行尾只能有空白和注释
+  bool endOfLine() {
+    skipBlanks();
+    return atLineEnd() ? true : fail();
+  }
+
+  bool parseBlockMapping(int indent, ScalarToken key) {
+    const uint32_t index = pushNode(ValueKind::kObject);
+    uint32_t count{0};
+    while (true) {
+      ++p_;  // ':'
+      const uint32_t value_index = static_cast<uint32_t>(nodes_.size());
+      if (!parseValue(indent, true)) {
+        return false;
+      }
+      setKey(value_index, key);
+      ++count;
+      if (!skipToContent()) {
+        if (error_ != Result::SUCCESS) {
+          return false;
+        }
+        break;
+      }
+      if (isDocumentMarker("---") || isDocumentMarker("...") || column() < indent) {
+        break;
+      }
+      if (column() > indent || atSequenceEntry()) {
+        return fail();
+      }
+      if (!scanScalar(false, key)) {
+        return false;
+      }
+      skipBlanks();
+      if (!atMappingColon()) {
+        return fail();
+      }
+    }
+    nodes_[index].count = count;
+    nodes_[index].next = static_cast<uint32_t>(nodes_.size());
+    return true;
+  }
+
+  // p_ 指向第一个 '-'
+  bool parseBlockSequence() {
+    const int indent = column();
+    const uint32_t index = pushNode(ValueKind::kArray);
+    uint32_t count{0};
+    while (true) {
+      ++p_;  // '-'
+      if (!parseValue(indent, false)) {
+        return false;
+      }
+      ++count;
+      if (!skipToContent()) {
+        if (error_ != Result::SUCCESS) {
+          return false;
+        }
+        break;
+      }
+      if (isDocumentMarker("---") || isDocumentMarker("...") || column() < indent) {
+        break;
+      }
+      if (column() > indent) {
+        return fail();
+      }
+      if (!atSequenceEntry()) {
+        break;  // 与序列缩进相同的下一个 key, 由外层的映射处理
+      }
+    }
+    nodes_[index].count = count;
+    nodes_[index].next = static_cast<uint32_t>(nodes_.size());
+    return true;
+  }
+
+  // 流式集合中可以换行, 跳过空白、换行和注释
+  bool skipFlowSpace() {
+    while (p_ < end_) {
+      if (isBlank(*p_)) {
+        ++p_;
+      } else if (isBreak(*p_)) {
+        newLine();
+      } else if (*p_ == '#' && (p_ == line_start_ || isBlank(p_[-1]))) {
+        skipLine();
+      } else {
+        return true;
+      }
+    }
+    return fail();  // 集合没有结束
+  }
+
+  bool parseFlowNode() {
+    if (++depth_ > kMaxDepth) {
+      return fail();
+    }
+    bool ok = *p_ == '[' ? parseFlowSequence() : parseFlowMapping();
+    --depth_;
+    return ok;
+  }
+
+  bool parseFlowValue() {
+    if (*p_ == '[' || *p_ == '{') {
+      return parseFlowNode();
+    }
+    ScalarToken token;
+    if (!scanScalar(true, token)) {
+      return false;
+    }
+    pushScalar(token, token.style == YamlStyle::kPlain ? resolvePlain(token.text) : ValueKind::kString);
+    return true;
+  }
+
+  // 元素之后是 ',' 或结束符; 允许末尾多一个 ','
+  bool parseFlowSeparator(char close, bool& closed) {
+    if (!skipFlowSpace()) {
+      return false;
+    }
+    if (*p_ == ',') {
+      ++p_;
+      closed = false;
+      return true;
+    }
+    if (*p_ == close) {
+      ++p_;
+      closed = true;
+      return true;
+    }
+    return fail();
+  }
+
+  bool parseFlowSequence() {
+    const uint32_t index = pushNode(ValueKind::kArray);
+    uint32_t count{0};
+    ++p_;  // '['
+    while (true) {
+      if (!skipFlowSpace()) {
+        return false;
+      }
+      if (*p_ == ']') {
+        ++p_;
+        break;
+      }
+      if (!parseFlowValue()) {
+        return false;
+      }
+      ++count;
+      bool closed{false};
+      if (!parseFlowSeparator(']', closed)) {
+        return false;
+      }
+      if (closed) {
+        break;
+      }
+    }
+    nodes_[index].count = count;
+    nodes_[index].next = static_cast<uint32_t>(nodes_.size());
+    return true;
+  }
+
+  bool parseFlowMapping() {
+    const uint32_t index = pushNode(ValueKind::kObject);
+    uint32_t count{0};
+    ++p_;  // '{'
+    while (true) {
+      if (!skipFlowSpace()) {
+        return false;
+      }
+      if (*p_ == '}') {
+        ++p_;
+        break;
+      }
+      ScalarToken key;
+      if (!scanScalar(true, key) || !skipFlowSpace()) {
+        return false;
+      }
+      const uint32_t value_index = static_cast<uint32_t>(nodes_.size());
+      if (*p_ == ':') {
+        ++p_;
+        if (!skipFlowSpace()) {
+          return false;
+        }
+        if (*p_ == ',' || *p_ == '}') {
+          pushScalar({}, ValueKind::kNull);
+        } else if (!parseFlowValue()) {
+          return false;
+        }
+      } else {
+        pushScalar({}, ValueKind::kNull);  // {a, b: 1} 中的 a
+      }
+      setKey(value_index, key);
+      ++count;
+      bool closed{false};
+      if (!parseFlowSeparator('}', closed)) {
+        return false;
+      }
+      if (closed) {
+        break;
+      }
+    }
+    nodes_[index].count = count;
+    nodes_[index].next = static_cast<uint32_t>(nodes_.size());
+    return true;
+  }
+
+  bool scanScalar(bool in_flow, ScalarToken& token) {
+    if (*p_ == '\'' || *p_ == '"') {
+      return scanQuoted(token);
+    }
+    return scanPlain(in_flow, token);
+  }
+
+  bool scanQuoted(ScalarToken& token) {
+    const char quote = *p_++;
+    token.style = quote == '"' ? YamlStyle::kDoubleQuoted : YamlStyle::kSingleQuoted;
+    token.simple = true;
+    const char* begin = p_;
+    while (p_ < end_) {
+      const char c = *p_;
+      if (c == quote) {
+        if (quote == '\'' && p_ + 1 < end_ && p_[1] == '\'') {
+          token.simple = false;
+          p_ += 2;
+          continue;
+        }
+        token.text = std::string_view(begin, p_ - begin);
+        ++p_;
+        return true;
+      }
+      if (isBreak(c)) {
+        token.simple = false;
+        newLine();
+        continue;
+      }
+      if (c == '\\' && quote == '"') {
+        token.simple = false;
+        if (++p_ == end_) {
+          break;
+        }
+        if (isBreak(*p_)) {
+          newLine();
+          continue;
+        }
+      }
+      ++p_;
+    }
+    return fail();
+  }
+
+  // 普通标量到行尾、": "、" #" 为止, 流式集合中还要在 ,[]{} 处结束; 不支持跨行
+  bool scanPlain(bool in_flow, ScalarToken& token) {
+    const char first = *p_;
+    const bool indicator_start = first == '-' || first == '?' || first == ':';
+    const bool next_is_safe = p_ + 1 < end_ && !isBlank(p_[1]) && !isBreak(p_[1])
+        && !(in_flow && isFlowIndicator(p_[1]));
+    if (isFlowIndicator(first) || std::string_view("#&*!|>'\"%@`").find(first) != std::string_view::npos
+        || (indicator_start && !next_is_safe)) {
+      return fail();
+    }
+    const char* begin = p_;
+    const char* last = p_;  // 最后一个非空白字符之后
+    while (p_ < end_ && !isBreak(*p_)) {
+      const char c = *p_;
+      if (c == ':') {
+        const char* next = p_ + 1;
+        if (next == end_ || isBlank(*next) || isBreak(*next) || (in_flow && isFlowIndicator(*next))) {
+          break;
+        }
+      } else if (c == '#' && isBlank(p_[-1])) {
+        break;
+      } else if (in_flow && isFlowIndicator(c)) {
+        break;
+      }
+      ++p_;
+      if (!isBlank(c)) {
+        last = p_;
+      }
+    }
+    p_ = last;
+    token.text = std::string_view(begin, last - begin);
+    token.style = YamlStyle::kPlain;
+    token.simple = true;
+    return true;
+  }
+
+  // p_ 指向 '|' 或 '>'; 内容的缩进由首个非空行确定, 或者由头部的数字指定(相对 parent_indent)
+  bool parseBlockScalar(int parent_indent) {
+    ScalarToken token;
+    token.style = *p_ == '|' ? YamlStyle::kLiteral : YamlStyle::kFolded;
+    token.simple = false;
+    ++p_;
+    char chomp{0};
+    int explicit_indent{0};
+    for (int i = 0; i < 2 && p_ < end_; ++i) {
+      if ((*p_ == '-' || *p_ == '+') && chomp == 0) {
+        chomp = *p_++;
+      } else if (*p_ >= '1' && *p_ <= '9' && explicit_indent == 0) {
+        explicit_indent = *p_++ - '0';
+      }
+    }
+    skipBlanks();
+    if (!atLineEnd()) {
+      return fail();
+    }
+    skipLine();
+
+    int indent = parent_indent + explicit_indent;
+    if (explicit_indent == 0) {
+      indent = -1;
+      // 首个非空行的缩进
+      for (const char* q = p_; q < end_;) {
+        const char* s = q;
+        while (q < end_ && *q == ' ') {
+          ++q;
+        }
+        if (q < end_ && !isBreak(*q)) {
+          indent = static_cast<int>(q - s);
+          break;
+        }
+        while (q < end_ && !isBreak(*q)) {
+          ++q;
+        }
+        if (q < end_) {
+          q += (*q == '\r' && q + 1 < end_ && q[1] == '\n') ? 2 : 1;
+        }
+      }
+    }
+    const char* begin = p_;
+    const char* content_end = p_;
+    if (indent > parent_indent) {
+      // 缩进不小于 indent 的行和空行都属于块标量
+      while (p_ < end_) {
+        const char* q = p_;
+        while (q < end_ && *q == ' ' && q - p_ < indent) {
+          ++q;
+        }
+        const bool blank_line = std::all_of(q, std::find_if(q, end_, isBreak), [](char ch) { return ch == ' '; })
+            && (q - p_ < indent);
+        if (q - p_ < indent && !blank_line) {
+          break;
+        }
+        skipLine();
+        content_end = p_;
+      }
+    }
+    p_ = content_end;
+    line_start_ = p_;
+    token.text = std::string_view(begin, content_end - begin);
+    pushScalar(token, ValueKind::kString);
+    auto& node = nodes_.back();
+    node.block_indent = static_cast<uint16_t>(std::max(indent, 0));
+    node.chomp = chomp;
+    return true;
+  }
+
+  const char* p_;
+  const char* end_;
+  const char* line_start_;
+  std::vector<YamlNode>& nodes_;
+  Result error_{Result::SUCCESS};
+  int depth_{0};
+};  // class YamlBuilder
+
+// 引号和块标量的内容
+bool decodeText(std::string_view text, YamlStyle style, const YamlNode* block, std::string& out) {
+  switch (style) {
+    case YamlStyle::kSingleQuoted:
+      return unescapeSingleQuoted(text, out);
+    case YamlStyle::kDoubleQuoted:
+      return unescapeDoubleQuoted(text, out);
+    case YamlStyle::kLiteral:
+    case YamlStyle::kFolded:
+      foldBlockScalar(*block, out);
+      return true;
+    default:
+      out.assign(text);
+      return true;
+  }
+}
+
+void appendJson(const YamlElementType& elem, std::string& out);
+
+}  // namespace
+
+Result YamlParser::parse(std::string_view content) {
+  nodes_.clear();
+  key_names_.clear();
+  if (content.size() >= UINT32_MAX) {
+    return Result::ERR_ILL_FORMED;
+  }
+  // 块格式的文档大致每行一个节点
+  nodes_.reserve(static_cast<size_t>(std::count(content.begin(), content.end(), '\n')) + 1);
+  return YamlBuilder{content, nodes_}.build();
+}
+
+YamlParser::ElemType YamlParser::toRootElemType() const {
+  return nodes_.empty() ? ElemType{} : ElemType{this, 0};
+}
+
+bool YamlElementType::isValid() const {
+  return doc_ != nullptr && node().kind != ValueKind::kNull;
+}
+
+std::optional<std::string> YamlElementType::getValueText() const {
+  if (!isValid()) {
+    return std::nullopt;
+  }
+  const YamlNode& n = node();
+  if (n.kind == ValueKind::kArray || n.kind == ValueKind::kObject) {
+    return std::nullopt;
+  }
+  if (n.simple) {
+    return std::string(n.text);
+  }
+  std::string text;
+  if (!decodeText(n.text, n.style, &n, text)) {
+    return std::nullopt;
+  }
+  return text;
+}
+
+ValueKind YamlElementType::getValueKind() const {
+  return doc_ == nullptr ? ValueKind::kNull : node().kind;
+}
+
+size_t YamlElementType::getElementCount() const {
+  return doc_ == nullptr ? 0 : node().count;
+}
+
+std::optional<int64_t> YamlElementType::getInt64Value() const {
+  if (doc_ == nullptr || node().kind != ValueKind::kInteger) {
+    return std::nullopt;
+  }
+  return parseInteger<int64_t>(node().text);
+}
+
+std::optional<uint64_t> YamlElementType::getUint64Value() const {
+  if (doc_ == nullptr || node().kind != ValueKind::kInteger) {
+    return std::nullopt;
+  }
+  return parseInteger<uint64_t>(node().text);
+}
+
+std::optional<double> YamlElementType::getDoubleValue() const {
+  if (doc_ == nullptr) {
+    return std::nullopt;
+  }
+  const YamlNode& n = node();
+  if (n.kind == ValueKind::kInteger) {
+    if (auto value = parseInteger<int64_t>(n.text); value.has_value()) {
+      return static_cast<double>(*value);
+    }
+    if (auto value = parseInteger<uint64_t>(n.text); value.has_value()) {
+      return static_cast<double>(*value);
+    }
+    return parseReal(n.text);  // 超出 64 位的十进制整数
+  }
+  if (n.kind == ValueKind::kReal) {
+    return parseReal(n.text);
+  }
+  return std::nullopt;
+}
+
+std::optional<bool> YamlElementType::getBoolValue() const {
+  if (doc_ == nullptr || node().kind != ValueKind::kBool) {
+    return std::nullopt;
+  }
+  return node().text.front() != 'f' && node().text.front() != 'F';
+}
+
+std::optional<std::string_view> YamlElementType::getStringValue() const {
+  if (doc_ == nullptr || node().kind != ValueKind::kString || !node().simple) {
+    return std::nullopt;
+  }
+  return node().text;
+}
+
+const char* YamlElementType::getKeyName() const {
+  if (doc_ == nullptr || !node().has_key) {
+    return nullptr;
+  }
+  const YamlNode& n = node();
+  const std::string* key = doc_->key_names_.get(n.key.data(), [&n](std::string& out) {
+    if (n.key_simple) {
+      out.assign(n.key);
+      return true;
+    }
+    return decodeText(n.key, n.key_style, nullptr, out);
+  });
+  return key == nullptr ? nullptr : key->c_str();
+}
+
+std::string_view YamlElementType::getKeyView() const {
+  if (doc_ == nullptr || !node().has_key) {
+    return {};
+  }
+  if (node().key_simple) {
+    return node().key;
+  }
+  const char* key = getKeyName();
+  return key == nullptr ? std::string_view{} : std::string_view(key);
+}
+
+YamlElementType YamlElementType::toChildElem(std::string_view key) const {
+  if (doc_ == nullptr || node().kind != ValueKind::kObject) {
+    return YamlElementType{};
+  }
+  for (uint32_t i = index_ + 1; i < node().next; i = nodeAt(i).next) {
+    YamlElementType child{doc_, i};
+    if (child.getKeyView() == key) {
+      return child;
+    }
+  }
+  return YamlElementType{};
+}
+
+std::string YamlElementType::serializeToString() const {
+  std::string out;
+  appendJson(*this, out);
+  return out;
+}
+
+namespace {
+
+void appendJson(const YamlElementType& elem, std::string& out) {
+  switch (elem.getValueKind()) {
+    case ValueKind::kNull:
+      out += "null";
+      return;
+    case ValueKind::kBool:
+      out += *elem.getBoolValue() ? "true" : "false";
+      return;
+    case ValueKind::kInteger:
+      if (auto value = elem.getInt64Value(); value.has_value()) {
+        appendNumber(*value, out);
+        return;
+      }
+      if (auto value = elem.getUint64Value(); value.has_value()) {
+        appendNumber(*value, out);
+        return;
+      }
+      [[fallthrough]];
+    case ValueKind::kReal:
+      if (auto value = elem.getDoubleValue(); value.has_value() && std::isfinite(*value)) {
+        appendNumber(*value, out);
+      } else {
+        out += "null";
+      }
+      return;
+    case ValueKind::kString:
+      if (auto view = elem.getStringValue(); view.has_value()) {
+        appendJsonString(*view, out);
+      } else {
+        appendJsonString(elem.getValueText().value_or(std::string{}), out);
+      }
+      return;
+    case ValueKind::kArray:
+    case ValueKind::kObject: {
+      const bool is_object = elem.getValueKind() == ValueKind::kObject;
+      out += is_object ? '{' : '[';
+      bool first{true};
+      elem.forEachElement([&out, &first, is_object](YamlElementType child) {
+        if (!first) {
+          out += ',';
+        }
+        first = false;
+        if (is_object) {
+          appendJsonString(child.getKeyView(), out);
+          out += ':';
+        }
+        appendJson(child, out);
+        return Result::SUCCESS;
+      });
+      out += is_object ? '}' : ']';
+      return;
+    }
+  }
+}
+
+}  // namespace
+
+}  // namespace parser
@@ -7,17 +7,124 @@
 # Author : xuechengyun
 # E-mail : xuechengyunxue@gmail.com
 # Date   : 2026/03/24 00:04:24
-# Desc   :
+# Desc   : 不依赖第三方库的 YAML 后端: 节点按先序存放在一个数组中, 文本都是指向输入的 string_view
 ########################################################################
 */
 #pragma once
 
-
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
+#include "../enable_parser.h"
 #include "../result.h"
+#include "../value_kind.h"
+#include "key_name_cache.h"
 
 namespace parser {
 
+// 标量的写法, 决定取值时是否需要处理转义和折行
+enum class YamlStyle : uint8_t {
+  kPlain,
+  kSingleQuoted,
+  kDoubleQuoted,
+  kLiteral,  // |
+  kFolded,   // >
+};  // enum class YamlStyle
+
+struct YamlNode {
+  std::string_view text;  // 标量: 去掉引号的原始文本; 块标量: 内容所在的各行
+  std::string_view key;   // 映射中的成员: key 去掉引号的原始文本
+  uint32_t next{0};       // 下一个兄弟节点的下标(跳过整棵子树)
+  uint32_t count{0};      // 序列、映射的元素个数
+  uint16_t block_indent{0};  // 块标量内容的缩进
+  ValueKind kind{ValueKind::kNull};
+  YamlStyle style{YamlStyle::kPlain};
+  YamlStyle key_style{YamlStyle::kPlain};
+  bool simple{true};      // text 不需要处理(没有转义、折行), 可以直接返回
+  bool key_simple{true};
+  bool has_key{false};
+  char chomp{0};          // 块标量末尾换行的处理: '-' 删除, '+' 保留, 0 只保留一个
+};  // struct YamlNode
+
+class YamlParser;
+
+// 节点只记录下标, 生命周期不能超过所属的 parser 和输入内容
+class YamlElementType {
+public:
+  YamlElementType() = default;
+  YamlElementType(const YamlParser* doc, uint32_t index) : doc_(doc), index_(index) {}
+
+  // null(~、null、空值)视为不存在
+  bool isValid() const;
+  std::optional<std::string> getValueText() const;
+  ValueKind getValueKind() const;
+  size_t getElementCount() const;
+  std::optional<int64_t> getInt64Value() const;
+  std::optional<uint64_t> getUint64Value() const;
+  std::optional<double> getDoubleValue() const;
+  std::optional<bool> getBoolValue() const;
+  // 只有不需要处理转义、折行的字符串直接返回输入中的文本
+  std::optional<std::string_view> getStringValue() const;
+  // 展开后保存在 parser 中, 在下一次 parse() 之前有效
+  const char* getKeyName() const;
+  std::string_view getKeyView() const;
+  YamlElementType toChildElem(std::string_view key) const;
+  template <typename F>
+  Result forEachElement(F&& f) const {
+    if (!isValid()) {
+      return Result::SUCCESS;
+    }
+    const YamlNode& n = node();
+    if (n.kind != ValueKind::kArray && n.kind != ValueKind::kObject) {
+      return Result::ERR_TYPE;
+    }
+    for (uint32_t i = index_ + 1; i < n.next; i = nodeAt(i).next) {
+      CHECK_SUCCESS_OR_RETURN(f(YamlElementType{doc_, i}));
+    }
+    return Result::SUCCESS;
+  }
+  // 输出为 json, 可以交给 json 后端重新解析(如 Lazy<T>)
+  std::string serializeToString() const;
+
+private:
+  const YamlNode& node() const {
+    return nodeAt(index_);
+  }
+  const YamlNode& nodeAt(uint32_t index) const;
+
+  const YamlParser* doc_{nullptr};
+  uint32_t index_{0};
+};  // class YamlElementType
+
+// 支持块映射、块序列、流式集合([...]、{...})、普通/单引号/双引号标量、块标量(|、>)和注释;
+// 标量按 YAML 1.2 core schema 识别 null、bool、整数和浮点数
+// 不支持锚点和别名(&、*)、标签(!)、复杂 key(?)和跨行的普通标量, 遇到时返回 ERR_ILL_FORMED;
+// 多个文档时只读取第一个
+class YamlParser {
+public:
+  using ElemType = YamlElementType;
+  // 节点数组在多次 parse 之间复用
+  Result parse(std::string_view content);
+  ElemType toRootElemType() const;
+private:
+  friend class YamlElementType;
+  std::vector<YamlNode> nodes_;
+  mutable KeyNameCache key_names_;
+};  // class YamlParser
+
+inline const YamlNode& YamlElementType::nodeAt(uint32_t index) const {
+  return doc_->nodes_[index];
+}
+
 }  // namespace parser
+
+namespace detail {
+template <>
+inline constexpr bool enable_member_walk<parser::YamlElementType> = true;
+template <>
+inline constexpr bool enable_parallel_deserialize<parser::YamlElementType> = true;
+}  // namespace detail
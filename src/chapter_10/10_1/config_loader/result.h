@@ -21,6 +21,7 @@ enum class Result {
   ERR_EXTRACTING_FIELD, // 解析值失败
   ERR_TYPE,             // 类型错误
   ERR_UNSUPPORTED_PARSER, // 不支持的解析器
+  ERR_READ_FILE,        // 打开或读取文件失败(loadMany 等返回这个错误码, 不抛出 FileReadError)
 };
 
 #define CHECK_SUCCESS_OR_RETURN(call) \
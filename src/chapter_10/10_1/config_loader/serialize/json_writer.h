@@ -0,0 +1,147 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:29:57
+# Desc   : 直接把 json 文本写入 std::string, 不构建 DOM
+########################################################################
+*/
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "../concepts.h"
+
+namespace detail {
+
+// 紧凑格式(没有空白), 数字由 std::to_chars 生成, 浮点数输出能精确还原的最短表示
+class JsonWriter {
+public:
+  explicit JsonWriter(std::string& out) : out_(out) {}
+
+  void beginObject(size_t) {
+    separate();
+    out_ += '{';
+    need_comma_ = false;
+  }
+  void key(std::string_view name) {
+    separate();
+    appendString(name);
+    out_ += ':';
+    need_comma_ = false;
+  }
+  void endObject() {
+    out_ += '}';
+    need_comma_ = true;
+  }
+  void beginArray(size_t) {
+    separate();
+    out_ += '[';
+    need_comma_ = false;
+  }
+  void endArray() {
+    out_ += ']';
+    need_comma_ = true;
+  }
+  void writeNull() {
+    separate();
+    out_ += "null";
+  }
+  void writeBool(bool value) {
+    separate();
+    out_ += value ? "true" : "false";
+  }
+  void writeInt64(int64_t value) {
+    separate();
+    appendNumber(value);
+  }
+  void writeUint64(uint64_t value) {
+    separate();
+    appendNumber(value);
+  }
+  // json 不能表示 nan 和 inf, 输出 null
+  void writeDouble(double value) {
+    separate();
+    appendReal(value);
+  }
+  // 按 float 的精度取最短表示, 0.1f 输出 0.1 而不是 0.10000000149011612
+  void writeFloat(float value) {
+    separate();
+    appendReal(value);
+  }
+  void writeString(std::string_view value) {
+    separate();
+    appendString(value);
+  }
+
+private:
+  void separate() {
+    if (need_comma_) {
+      out_ += ',';
+    }
+    need_comma_ = true;
+  }
+  template <typename Number>
+  void appendNumber(Number value) {
+    char buffer[32];
+    auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out_.append(buffer, end);
+  }
+  // 整数值的浮点数补上 ".0"(2.0 不输出为 2), 重新加载时仍然是浮点数, 如 std::variant<..., int, double> 选回 double
+  template <typename Real>
+  void appendReal(Real value) {
+    if (!std::isfinite(value)) {
+      out_ += "null";
+      return;
+    }
+    char buffer[32];
+    auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out_.append(buffer, end);
+    if (std::string_view(buffer, end).find_first_of(".e") == std::string_view::npos) {
+      out_ += ".0";
+    }
+  }
+  // 不需要转义的连续字符一次追加
+  void appendString(std::string_view value) {
+    out_ += '"';
+    size_t begin{0};
+    for (size_t i = 0; i < value.size(); ++i) {
+      const auto c = static_cast<unsigned char>(value[i]);
+      if (c >= 0x20 && c != '"' && c != '\\') {
+        continue;
+      }
+      out_.append(value.data() + begin, i - begin);
+      begin = i + 1;
+      switch (c) {
+        case '"': out_ += "\\\""; break;
+        case '\\': out_ += "\\\\"; break;
+        case '\b': out_ += "\\b"; break;
+        case '\f': out_ += "\\f"; break;
+        case '\n': out_ += "\\n"; break;
+        case '\r': out_ += "\\r"; break;
+        case '\t': out_ += "\\t"; break;
+        default: {
+          constexpr char kHex[] = "0123456789abcdef";
+          const char escaped[] = {'\\', 'u', '0', '0', kHex[c >> 4], kHex[c & 0xf]};
+          out_.append(escaped, sizeof(escaped));
+        }
+      }
+    }
+    out_.append(value.data() + begin, value.size() - begin);
+    out_ += '"';
+  }
+
+  std::string& out_;
+  bool need_comma_{false};
+};  // class JsonWriter
+static_assert(concepts::Writer<JsonWriter>);
+
+}  // namespace detail
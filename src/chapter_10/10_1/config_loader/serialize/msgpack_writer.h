@@ -0,0 +1,139 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/16 00:28:45
+# Desc   : 把 MessagePack 编码写入 std::string, 可以由 MsgPackParser 重新加载
+########################################################################
+*/
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include "../concepts.h"
+
+namespace detail {
+
+// 整数和长度选用最短的编码; double 能用 float32 精确表示时(如 0.5)写成 float32, 读回后的值不变
+// 对象和数组的元素个数在开始时写入, 不超过 2^32 - 1
+class MsgPackWriter {
+public:
+  explicit MsgPackWriter(std::string& out) : out_(out) {}
+
+  void beginObject(size_t size) {
+    writeHeader(size, 0x80, 0xde, 0xdf);
+  }
+  void key(std::string_view name) {
+    writeString(name);
+  }
+  void endObject() {}
+  void beginArray(size_t size) {
+    writeHeader(size, 0x90, 0xdc, 0xdd);
+  }
+  void endArray() {}
+  void writeNull() {
+    putByte(0xc0);
+  }
+  void writeBool(bool value) {
+    putByte(value ? 0xc3 : 0xc2);
+  }
+  void writeInt64(int64_t value) {
+    if (value >= 0) {
+      writeUint64(static_cast<uint64_t>(value));
+    } else if (value >= -32) {
+      putByte(static_cast<uint8_t>(value));  // negative fixint
+    } else if (value >= std::numeric_limits<int8_t>::min()) {
+      putByte(0xd0);
+      putBigEndian(static_cast<uint8_t>(value));
+    } else if (value >= std::numeric_limits<int16_t>::min()) {
+      putByte(0xd1);
+      putBigEndian(static_cast<uint16_t>(value));
+    } else if (value >= std::numeric_limits<int32_t>::min()) {
+      putByte(0xd2);
+      putBigEndian(static_cast<uint32_t>(value));
+    } else {
+      putByte(0xd3);
+      putBigEndian(static_cast<uint64_t>(value));
+    }
+  }
+  void writeUint64(uint64_t value) {
+    if (value < 0x80) {
+      putByte(static_cast<uint8_t>(value));  // positive fixint
+    } else if (value <= std::numeric_limits<uint8_t>::max()) {
+      putByte(0xcc);
+      putBigEndian(static_cast<uint8_t>(value));
+    } else if (value <= std::numeric_limits<uint16_t>::max()) {
+      putByte(0xcd);
+      putBigEndian(static_cast<uint16_t>(value));
+    } else if (value <= std::numeric_limits<uint32_t>::max()) {
+      putByte(0xce);
+      putBigEndian(static_cast<uint32_t>(value));
+    } else {
+      putByte(0xcf);
+      putBigEndian(value);
+    }
+  }
+  void writeDouble(double value) {
+    // 超出 float 范围的有限值转换为 float 是未定义行为, 先排除
+    if (!std::isfinite(value) ||
+        (std::fabs(value) <= std::numeric_limits<float>::max() &&
+         static_cast<double>(static_cast<float>(value)) == value)) {
+      putByte(0xca);
+      putBigEndian(std::bit_cast<uint32_t>(static_cast<float>(value)));
+    } else {
+      putByte(0xcb);
+      putBigEndian(std::bit_cast<uint64_t>(value));
+    }
+  }
+  void writeString(std::string_view value) {
+    if (value.size() < 32) {
+      putByte(static_cast<uint8_t>(0xa0 | value.size()));  // fixstr
+    } else if (value.size() <= std::numeric_limits<uint8_t>::max()) {
+      putByte(0xd9);
+      putBigEndian(static_cast<uint8_t>(value.size()));
+    } else {
+      writeHeader(value.size(), 0xff, 0xda, 0xdb);
+    }
+    out_.append(value);
+  }
+
+private:
+  void putByte(uint8_t byte) {
+    out_ += static_cast<char>(byte);
+  }
+  template <std::unsigned_integral U>
+  void putBigEndian(U value) {
+    char bytes[sizeof(U)];
+    for (size_t i = sizeof(U); i-- > 0; value >>= 8) {
+      bytes[i] = static_cast<char>(value & 0xff);
+    }
+    out_.append(bytes, sizeof(U));
+  }
+  // 长度小于 16 时写成 fix_tag | size(字符串另外处理, fix_tag 传 0xff 表示没有), 否则为 16 位或 32 位的长度
+  void writeHeader(size_t size, uint8_t fix_tag, uint8_t tag16, uint8_t tag32) {
+    if (fix_tag != 0xff && size < 16) {
+      putByte(static_cast<uint8_t>(fix_tag | size));
+    } else if (size <= std::numeric_limits<uint16_t>::max()) {
+      putByte(tag16);
+      putBigEndian(static_cast<uint16_t>(size));
+    } else {
+      putByte(tag32);
+      putBigEndian(static_cast<uint32_t>(size));
+    }
+  }
+
+  std::string& out_;
+};  // class MsgPackWriter
+static_assert(concepts::Writer<MsgPackWriter>);
+
+}  // namespace detail
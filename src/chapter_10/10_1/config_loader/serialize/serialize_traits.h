@@ -0,0 +1,208 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:27:14
+# Desc   : 对象序列化, 按类型分发的方式与 CompoundDeserializeTraits 相同, 输出格式由 Writer 决定
+########################################################################
+*/
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+#include <version>
+
+#if __cpp_lib_flat_map
+#include <flat_map>
+#endif
+#if __cpp_lib_flat_set
+#include <flat_set>
+#endif
+
+#include "../concepts.h"
+#include "../define_schema.h"
+#include "../interned_string.h"
+
+namespace detail {
+
+template <typename T>
+struct SerializeTraits;
+
+template <concepts::Arithmetic T>
+struct SerializeTraits<T> {
+  template <concepts::Writer W>
+  static void serialize(const T& value, W& writer) {
+    if constexpr (std::same_as<T, bool>) {
+      writer.writeBool(value);
+    } else if constexpr (std::same_as<T, float> && requires { writer.writeFloat(value); }) {
+      // 以 float 的精度输出的后端(如 JsonWriter), 转换为 double 后会多出 float 本身没有的位数
+      writer.writeFloat(value);
+    } else if constexpr (std::floating_point<T>) {
+      writer.writeDouble(static_cast<double>(value));
+    } else if constexpr (std::signed_integral<T>) {
+      writer.writeInt64(static_cast<int64_t>(value));
+    } else {
+      writer.writeUint64(static_cast<uint64_t>(value));
+    }
+  }
+};  // struct SerializeTraits<T>
+
+template <typename Alloc>
+struct SerializeTraits<std::basic_string<char, std::char_traits<char>, Alloc>> {
+  template <concepts::Writer W>
+  static void serialize(std::string_view value, W& writer) {
+    writer.writeString(value);
+  }
+};  // struct SerializeTraits<std::basic_string<char, std::char_traits<char>, Alloc>>
+
+template <>
+struct SerializeTraits<InternedString> {
+  template <concepts::Writer W>
+  static void serialize(const InternedString& value, W& writer) {
+    writer.writeString(value.view());
+  }
+};  // struct SerializeTraits<InternedString>
+
+// 没有值时输出 null, 反序列化时 null 与字段缺失一样得到空的 optional
+template <typename T>
+struct SerializeTraits<std::optional<T>> {
+  template <concepts::Writer W>
+  static void serialize(const std::optional<T>& value, W& writer) {
+    if (value.has_value()) {
+      SerializeTraits<T>::serialize(*value, writer);
+    } else {
+      writer.writeNull();
+    }
+  }
+};  // struct SerializeTraits<std::optional<T>>
+
+template <typename Container, typename ValueType = Container::value_type>
+struct SeqContainerSerialize {
+  template <concepts::Writer W>
+  static void serialize(const Container& container, W& writer) {
+    writer.beginArray(container.size());
+    for (const auto& value : container) {
+      SerializeTraits<ValueType>::serialize(value, writer);
+    }
+    writer.endArray();
+  }
+};  // struct SeqContainerSerialize
+
+template <typename T, typename Alloc>
+struct SerializeTraits<std::vector<T, Alloc>> : SeqContainerSerialize<std::vector<T, Alloc>> {
+};  // struct SerializeTraits<std::vector<T, Alloc>>
+
+template <typename T, typename Alloc>
+struct SerializeTraits<std::list<T, Alloc>> : SeqContainerSerialize<std::list<T, Alloc>> {
+};  // struct SerializeTraits<std::list<T, Alloc>>
+
+template <typename T, typename Alloc>
+struct SerializeTraits<std::deque<T, Alloc>> : SeqContainerSerialize<std::deque<T, Alloc>> {
+};  // struct SerializeTraits<std::deque<T, Alloc>>
+
+template <typename T, size_t N>
+struct SerializeTraits<std::array<T, N>> : SeqContainerSerialize<std::array<T, N>> {
+};  // struct SerializeTraits<std::array<T, N>>
+
+#if __cpp_lib_flat_set
+template <typename Key, typename Compare, typename KeyContainer>
+struct SerializeTraits<std::flat_set<Key, Compare, KeyContainer>>
+    : SeqContainerSerialize<std::flat_set<Key, Compare, KeyContainer>> {
+};  // struct SerializeTraits<std::flat_set<Key, Compare, KeyContainer>>
+#endif
+
+// 以字符串为 key 的关联容器输出为对象
+template <typename Map, typename T = Map::mapped_type>
+struct MapSerialize {
+  template <concepts::Writer W>
+  static void serialize(const Map& map, W& writer) {
+    writer.beginObject(map.size());
+    for (const auto& [key, value] : map) {
+      writer.key(key);
+      SerializeTraits<T>::serialize(value, writer);
+    }
+    writer.endObject();
+  }
+};  // struct MapSerialize
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+struct SerializeTraits<std::map<Key, T, Compare, Alloc>> : MapSerialize<std::map<Key, T, Compare, Alloc>> {
+};  // struct SerializeTraits<std::map<Key, T, Compare, Alloc>>
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
+struct SerializeTraits<std::unordered_map<Key, T, Hash, KeyEqual, Alloc>>
+    : MapSerialize<std::unordered_map<Key, T, Hash, KeyEqual, Alloc>> {
+};  // struct SerializeTraits<std::unordered_map<Key, T, Hash, KeyEqual, Alloc>>
+
+#if __cpp_lib_flat_map
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+struct SerializeTraits<std::flat_map<Key, T, Compare, KeyContainer, MappedContainer>>
+    : MapSerialize<std::flat_map<Key, T, Compare, KeyContainer, MappedContainer>> {
+};  // struct SerializeTraits<std::flat_map<Key, T, Compare, KeyContainer, MappedContainer>>
+#endif
+
+template <typename SP>
+struct SmartPointerSerialize {
+  template <concepts::Writer W>
+  static void serialize(const SP& sp, W& writer) {
+    if (sp != nullptr) {
+      SerializeTraits<typename SP::element_type>::serialize(*sp, writer);
+    } else {
+      writer.writeNull();
+    }
+  }
+};  // struct SmartPointerSerialize
+
+template <typename T>
+struct SerializeTraits<std::unique_ptr<T>> : SmartPointerSerialize<std::unique_ptr<T>> {
+};  // struct SerializeTraits<std::unique_ptr<T>>
+template <typename T>
+struct SerializeTraits<std::shared_ptr<T>> : SmartPointerSerialize<std::shared_ptr<T>> {
+};  // struct SerializeTraits<std::shared_ptr<T>>
+
+// 只输出当前的值, 不记录是哪个备选类型, 反序列化时按节点的类型选择备选类型
+template <typename... Ts>
+struct SerializeTraits<std::variant<Ts...>> {
+  template <concepts::Writer W>
+  static void serialize(const std::variant<Ts...>& value, W& writer) {
+    if (value.valueless_by_exception()) {
+      writer.writeNull();
+      return;
+    }
+    std::visit([&writer]<typename T>(const T& alternative) {
+      SerializeTraits<T>::serialize(alternative, writer);
+    }, value);
+  }
+};  // struct SerializeTraits<std::variant<Ts...>>
+
+template <concepts::Reflected T>
+struct SerializeTraits<T> {
+  template <concepts::Writer W>
+  static void serialize(const T& obj, W& writer) {
+    writer.beginObject(T::_field_count_);
+    forEachField(obj, [&writer](auto&& field_info) {
+      writer.key(field_info.name());
+      decltype(auto) value = field_info.value();
+      SerializeTraits<std::remove_cvref_t<decltype(value)>>::serialize(value, writer);
+    });
+    writer.endObject();
+  }
+};  // struct SerializeTraits<T>
+
+}  // namespace detail
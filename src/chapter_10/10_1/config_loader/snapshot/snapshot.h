@@ -0,0 +1,155 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:31:24
+# Desc   : 二进制快照缓存: 解析成功后保存快照, 下次加载时源文件和 schema 都没有变化则直接读取快照
+########################################################################
+*/
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "snapshot_traits.h"
+#include "../file_content.h"
+#include "../load_to_obj.h"
+
+namespace detail {
+
+// 快照文件格式: SnapshotStamp + SnapshotTraits<T> 保存的内容 + 内容的哈希(uint64_t)
+struct SnapshotStamp {
+  static constexpr char kMagic[8] = {'C', 'L', 'S', 'N', 'A', 'P', '0', '1'};
+  char magic[8];
+  uint64_t schema_fingerprint;  // 类型结构
+  uint64_t source_size;         // 源文件大小
+  int64_t source_mtime;         // 源文件修改时间
+  uint64_t source_hash;         // 源文件内容的哈希
+
+  bool operator==(const SnapshotStamp&) const = default;
+};  // struct SnapshotStamp
+
+template <typename T>
+constexpr uint64_t schemaFingerprint() {
+  uint64_t h = mixFingerprint(0xcbf29ce484222325ULL, "config_loader snapshot");
+  // 数值按本机字节序保存, 字节序不同的机器之间不能共用快照
+  h = mixFingerprint(h, std::endian::native == std::endian::little ? "little" : "big");
+  return SnapshotTraits<T>::fingerprint(h, 0);
+}
+
+// 每次处理 8 字节的非加密哈希, 只用于判断源文件内容是否变化
+inline uint64_t hashContent(std::string_view content) {
+  constexpr uint64_t kMul = 0x9e3779b97f4a7c15ULL;
+  uint64_t h = content.size() * kMul;
+  size_t i{0};
+  for (; i + 8 <= content.size(); i += 8) {
+    uint64_t word{0};
+    std::memcpy(&word, content.data() + i, 8);
+    h = (std::rotl(h, 23) ^ word) * kMul;
+  }
+  uint64_t tail{0};
+  std::memcpy(&tail, content.data() + i, content.size() - i);
+  h = (std::rotl(h, 23) ^ tail) * kMul;
+  return h ^ (h >> 29);
+}
+
+template <typename T>
+SnapshotStamp makeSnapshotStamp(std::string_view source_path, std::string_view content) {
+  SnapshotStamp stamp{};
+  std::memcpy(stamp.magic, SnapshotStamp::kMagic, sizeof(stamp.magic));
+  stamp.schema_fingerprint = schemaFingerprint<T>();
+  stamp.source_size = content.size();
+  std::error_code ec;
+  auto mtime = std::filesystem::last_write_time(std::filesystem::path(source_path), ec);
+  stamp.source_mtime = ec ? 0 : static_cast<int64_t>(mtime.time_since_epoch().count());
+  stamp.source_hash = hashContent(content);
+  return stamp;
+}
+
+// 快照不存在、标记不匹配或内容损坏时返回 false, obj 不变
+template <typename T>
+bool loadSnapshot(T& obj, std::string_view snapshot_path, const SnapshotStamp& stamp) {
+  std::error_code ec;
+  if (!std::filesystem::is_regular_file(std::filesystem::path(snapshot_path), ec)) {
+    return false;
+  }
+  try {
+    // saveSnapshot 写临时文件后 rename, 从不原地改写快照, 映射期间文件不会被截断, 可以直接 mmap
+    FileContent snapshot{snapshot_path, 0};
+    auto data = snapshot.view();
+    SnapshotStamp saved{};
+    uint64_t payload_hash{0};
+    if (data.size() < sizeof(saved) + sizeof(payload_hash)) {
+      return false;
+    }
+    std::memcpy(&saved, data.data(), sizeof(saved));
+    std::memcpy(&payload_hash, data.data() + data.size() - sizeof(payload_hash), sizeof(payload_hash));
+    auto payload = data.substr(sizeof(saved), data.size() - sizeof(saved) - sizeof(payload_hash));
+    if (!(saved == stamp) || hashContent(payload) != payload_hash) {
+      return false;
+    }
+    SnapshotReader reader{payload};
+    T loaded{};
+    if (SnapshotTraits<T>::load(loaded, reader) != Result::SUCCESS || reader.remaining() != 0) {
+      return false;
+    }
+    obj = std::move(loaded);
+    return true;
+  } catch (const std::runtime_error&) {
+    return false;
+  }
+}
+
+// 先写临时文件再 rename, 并发加载的进程不会读到写了一半的快照; 写入失败不影响加载结果
+template <typename T>
+void saveSnapshot(const T& obj, std::string_view snapshot_path, const SnapshotStamp& stamp) {
+  std::string data;
+  SnapshotWriter writer{data};
+  writer.write(stamp);
+  SnapshotTraits<T>::save(obj, writer);
+  writer.write(hashContent(std::string_view(data).substr(sizeof(stamp))));
+
+  const std::filesystem::path path{snapshot_path};
+  auto tmp_path = path;
+  tmp_path += ".tmp";
+  {
+    std::ofstream file{tmp_path, std::ios::binary | std::ios::trunc};
+    if (!file.write(data.data(), static_cast<std::streamsize>(data.size())).flush()) {
+      return;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmp_path, path, ec);
+  if (ec) {
+    std::filesystem::remove(tmp_path, ec);
+  }
+}
+
+template <concepts::Parser P, typename T>
+Result loadWithSnapshot(T& obj, std::string_view path, std::string_view snapshot_path) {
+  // 计算内容哈希需要读一遍源文件, 快照不可用时解析的也是这份内容
+  FileContent content = get_file_content(path);
+  const auto stamp = makeSnapshotStamp<T>(path, content.view());
+  if (!content.empty() && loadSnapshot(obj, snapshot_path, stamp)) {
+    return Result::SUCCESS;
+  }
+  auto res = load_to_obj<P>(obj, [&content] {
+    return content.view();
+  });
+  if (res == Result::SUCCESS) {
+    saveSnapshot(obj, snapshot_path, stamp);
+  }
+  return res;
+}
+
+}  // namespace detail
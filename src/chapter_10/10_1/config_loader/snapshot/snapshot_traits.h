@@ -0,0 +1,442 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:28:41
+# Desc   : 对象与二进制快照之间的转换, 按类型分发的方式与 CompoundDeserializeTraits 相同
+########################################################################
+*/
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+#include <version>
+
+#if __cpp_lib_flat_map
+#include <flat_map>
+#endif
+#if __cpp_lib_flat_set
+#include <flat_set>
+#endif
+
+#include "../concepts.h"
+#include "../define_schema.h"
+#include "../interned_string.h"
+#include "../memory_resource.h"
+#include "../result.h"
+
+namespace detail {
+
+// 快照只在同一台机器上读写, 数值按本机字节序原样保存, 字节序和类型大小计入 schema 指纹
+class SnapshotWriter {
+public:
+  explicit SnapshotWriter(std::string& out) : out_(out) {}
+  void write(const void* data, size_t size) {
+    out_.append(static_cast<const char*>(data), size);
+  }
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  void write(const T& value) {
+    write(&value, sizeof(value));
+  }
+private:
+  std::string& out_;
+};  // class SnapshotWriter
+
+// 读到末尾之后的内容时失败, 不会越界
+class SnapshotReader {
+public:
+  explicit SnapshotReader(std::string_view data) : data_(data) {}
+  bool read(void* data, size_t size) {
+    if (size > data_.size()) {
+      return false;
+    }
+    std::memcpy(data, data_.data(), size);
+    data_.remove_prefix(size);
+    return true;
+  }
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  bool read(T& value) {
+    return read(&value, sizeof(value));
+  }
+  // 直接引用快照中的内容
+  bool readView(std::string_view& view, size_t size) {
+    if (size > data_.size()) {
+      return false;
+    }
+    view = data_.substr(0, size);
+    data_.remove_prefix(size);
+    return true;
+  }
+  size_t remaining() const {
+    return data_.size();
+  }
+private:
+  std::string_view data_;
+};  // class SnapshotReader
+
+// schema 指纹: 类型结构(字段名、字段顺序、字段类型)变化后指纹随之变化
+constexpr uint64_t mixFingerprint(uint64_t h, uint64_t value) {
+  h ^= value + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+  return h;
+}
+constexpr uint64_t mixFingerprint(uint64_t h, std::string_view text) {
+  for (char c : text) {
+    h = (h ^ static_cast<unsigned char>(c)) * 0x100000001b3ULL;
+  }
+  return mixFingerprint(h, text.size());
+}
+
+template <typename T>
+struct SnapshotTraits;
+
+// 递归类型(如 TestTree 中的 children)展开到一定深度后只记录字段数
+inline constexpr int kMaxFingerprintDepth = 8;
+
+template <concepts::Arithmetic T>
+struct SnapshotTraits<T> {
+  static constexpr uint64_t fingerprint(uint64_t h, int) {
+    return mixFingerprint(mixFingerprint(h, std::is_floating_point_v<T> ? "float" : std::is_signed_v<T> ? "int" : "uint"),
+        sizeof(T));
+  }
+  static void save(const T& value, SnapshotWriter& writer) {
+    writer.write(value);
+  }
+  static Result load(T& value, SnapshotReader& reader) {
+    return reader.read(value) ? Result::SUCCESS : Result::ERR_ILL_FORMED;
+  }
+};  // struct SnapshotTraits<T>
+
+template <>
+struct SnapshotTraits<bool> {
+  static constexpr uint64_t fingerprint(uint64_t h, int) {
+    return mixFingerprint(h, "bool");
+  }
+  static void save(bool value, SnapshotWriter& writer) {
+    writer.write(static_cast<uint8_t>(value));
+  }
+  static Result load(bool& value, SnapshotReader& reader) {
+    uint8_t byte{0};
+    if (!reader.read(byte) || byte > 1) {
+      return Result::ERR_ILL_FORMED;
+    }
+    value = byte == 1;
+    return Result::SUCCESS;
+  }
+};  // struct SnapshotTraits<bool>
+
+template <typename Alloc>
+struct SnapshotTraits<std::basic_string<char, std::char_traits<char>, Alloc>> {
+  using String = std::basic_string<char, std::char_traits<char>, Alloc>;
+  static constexpr uint64_t fingerprint(uint64_t h, int) {
+    return mixFingerprint(h, "string");
+  }
+  static void save(const String& value, SnapshotWriter& writer) {
+    writer.write(static_cast<uint64_t>(value.size()));
+    writer.write(value.data(), value.size());
+  }
+  static Result load(String& value, SnapshotReader& reader) {
+    uint64_t size{0};
+    std::string_view view;
+    if (!reader.read(size) || !reader.readView(view, size)) {
+      return Result::ERR_ILL_FORMED;
+    }
+    value.assign(view);
+    return Result::SUCCESS;
+  }
+};  // struct SnapshotTraits<String>
+
+// 与字符串的格式相同, 加载时重新驻留到当前线程的表中
+template <>
+struct SnapshotTraits<InternedString> {
+  static constexpr uint64_t fingerprint(uint64_t h, int) {
+    return mixFingerprint(h, "string");
+  }
+  static void save(const InternedString& value, SnapshotWriter& writer) {
+    writer.write(static_cast<uint64_t>(value.size()));
+    writer.write(value.view().data(), value.size());
+  }
+  static Result load(InternedString& value, SnapshotReader& reader) {
+    uint64_t size{0};
+    std::string_view view;
+    if (!reader.read(size) || !reader.readView(view, size)) {
+      return Result::ERR_ILL_FORMED;
+    }
+    value = currentInternTable().intern(view);
+    return Result::SUCCESS;
+  }
+};  // struct SnapshotTraits<InternedString>
+
+template <typename T>
+struct SnapshotTraits<std::optional<T>> {
+  static constexpr uint64_t fingerprint(uint64_t h, int depth) {
+    return SnapshotTraits<T>::fingerprint(mixFingerprint(h, "optional"), depth);
+  }
+  static void save(const std::optional<T>& value, SnapshotWriter& writer) {
+    writer.write(static_cast<uint8_t>(value.has_value()));
+    if (value.has_value()) {
+      SnapshotTraits<T>::save(*value, writer);
+    }
+  }
+  static Result load(std::optional<T>& value, SnapshotReader& reader) {
+    uint8_t has_value{0};
+    if (!reader.read(has_value)) {
+      return Result::ERR_ILL_FORMED;
+    }
+    if (has_value == 0) {
+      value.reset();
+      return Result::SUCCESS;
+    }
+    return SnapshotTraits<T>::load(value.emplace(), reader);
+  }
+};  // struct SnapshotTraits<std::optional<T>>
+
+template <typename Container, typename ValueType = Container::value_type>
+struct SeqContainerSnapshot {
+  static constexpr uint64_t fingerprint(uint64_t h, int depth) {
+    return SnapshotTraits<ValueType>::fingerprint(mixFingerprint(h, "sequence"), depth);
+  }
+  static void save(const Container& container, SnapshotWriter& writer) {
+    writer.write(static_cast<uint64_t>(container.size()));
+    for (const auto& value : container) {
+      SnapshotTraits<ValueType>::save(value, writer);
+    }
+  }
+  static Result load(Container& container, SnapshotReader& reader) {
+    uint64_t size{0};
+    if (!reader.read(size)) {
+      return Result::ERR_ILL_FORMED;
+    }
+    container.clear();
+    if constexpr (requires { container.reserve(size); }) {
+      // 损坏的快照中 size 可能很大, 预留的空间不超过剩余的字节数
+      container.reserve(std::min<uint64_t>(size, reader.remaining()));
+    }
+    for (uint64_t i = 0; i < size; ++i) {
+      CHECK_SUCCESS_OR_RETURN(SnapshotTraits<ValueType>::load(container.emplace_back(), reader));
+    }
+    return Result::SUCCESS;
+  }
+};  // struct SeqContainerSnapshot
+
+template <typename T, typename Alloc>
+struct SnapshotTraits<std::vector<T, Alloc>> : SeqContainerSnapshot<std::vector<T, Alloc>> {
+};  // struct SnapshotTraits<std::vector<T, Alloc>>
+
+template <typename T, typename Alloc>
+struct SnapshotTraits<std::list<T, Alloc>> : SeqContainerSnapshot<std::list<T, Alloc>> {
+};  // struct SnapshotTraits<std::list<T, Alloc>>
+
+template <typename T, typename Alloc>
+struct SnapshotTraits<std::deque<T, Alloc>> : SeqContainerSnapshot<std::deque<T, Alloc>> {
+};  // struct SnapshotTraits<std::deque<T, Alloc>>
+
+template <typename T, size_t N>
+struct SnapshotTraits<std::array<T, N>> {
+  static constexpr uint64_t fingerprint(uint64_t h, int depth) {
+    return SnapshotTraits<T>::fingerprint(mixFingerprint(mixFingerprint(h, "array"), N), depth);
+  }
+  static void save(const std::array<T, N>& arr, SnapshotWriter& writer) {
+    for (const auto& value : arr) {
+      SnapshotTraits<T>::save(value, writer);
+    }
+  }
+  static Result load(std::array<T, N>& arr, SnapshotReader& reader) {
+    for (auto& value : arr) {
+      CHECK_SUCCESS_OR_RETURN(SnapshotTraits<T>::load(value, reader));
+    }
+    return Result::SUCCESS;
+  }
+};  // struct SnapshotTraits<std::array<T, N>>
+
+// 关联容器按遍历顺序保存, 加载时逐个插入(flat_map、flat_set 按排好的顺序插入, 每次都在末尾)
+template <typename Container, typename Key = Container::key_type>
+struct AssociativeSnapshot {
+  static constexpr bool kIsMap = requires { typename Container::mapped_type; };
+
+  static constexpr uint64_t fingerprint(uint64_t h, int depth) {
+    h = SnapshotTraits<Key>::fingerprint(mixFingerprint(h, kIsMap ? "map" : "set"), depth);
+    if constexpr (kIsMap) {
+      h = SnapshotTraits<typename Container::mapped_type>::fingerprint(h, depth);
+    }
+    return h;
+  }
+  static void save(const Container& container, SnapshotWriter& writer) {
+    writer.write(static_cast<uint64_t>(container.size()));
+    for (const auto& element : container) {
+      if constexpr (kIsMap) {
+        SnapshotTraits<Key>::save(element.first, writer);
+        SnapshotTraits<typename Container::mapped_type>::save(element.second, writer);
+      } else {
+        SnapshotTraits<Key>::save(element, writer);
+      }
+    }
+  }
+  static Result load(Container& container, SnapshotReader& reader) {
+    uint64_t size{0};
+    if (!reader.read(size)) {
+      return Result::ERR_ILL_FORMED;
+    }
+    container.clear();
+    for (uint64_t i = 0; i < size; ++i) {
+      Key key = makeValue<Key>();
+      CHECK_SUCCESS_OR_RETURN(SnapshotTraits<Key>::load(key, reader));
+      if constexpr (kIsMap) {
+        auto [it, inserted] = container.try_emplace(std::move(key));
+        if (!inserted) {
+          return Result::ERR_ILL_FORMED;
+        }
+        CHECK_SUCCESS_OR_RETURN(SnapshotTraits<typename Container::mapped_type>::load(it->second, reader));
+      } else if (!container.insert(std::move(key)).second) {
+        return Result::ERR_ILL_FORMED;
+      }
+    }
+    return Result::SUCCESS;
+  }
+};  // struct AssociativeSnapshot
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+struct SnapshotTraits<std::map<Key, T, Compare, Alloc>> : AssociativeSnapshot<std::map<Key, T, Compare, Alloc>> {
+};  // struct SnapshotTraits<std::map<Key, T, Compare, Alloc>>
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
+struct SnapshotTraits<std::unordered_map<Key, T, Hash, KeyEqual, Alloc>>
+    : AssociativeSnapshot<std::unordered_map<Key, T, Hash, KeyEqual, Alloc>> {
+};  // struct SnapshotTraits<std::unordered_map<Key, T, Hash, KeyEqual, Alloc>>
+
+#if __cpp_lib_flat_map
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+struct SnapshotTraits<std::flat_map<Key, T, Compare, KeyContainer, MappedContainer>>
+    : AssociativeSnapshot<std::flat_map<Key, T, Compare, KeyContainer, MappedContainer>> {
+};  // struct SnapshotTraits<std::flat_map<Key, T, Compare, KeyContainer, MappedContainer>>
+#endif
+
+#if __cpp_lib_flat_set
+template <typename Key, typename Compare, typename KeyContainer>
+struct SnapshotTraits<std::flat_set<Key, Compare, KeyContainer>>
+    : AssociativeSnapshot<std::flat_set<Key, Compare, KeyContainer>> {
+};  // struct SnapshotTraits<std::flat_set<Key, Compare, KeyContainer>>
+#endif
+
+template <typename SP>
+struct SmartPointerSnapshot {
+  using ElementType = typename SP::element_type;
+  static constexpr uint64_t fingerprint(uint64_t h, int depth) {
+    return SnapshotTraits<ElementType>::fingerprint(mixFingerprint(h, "pointer"), depth);
+  }
+  static void save(const SP& sp, SnapshotWriter& writer) {
+    writer.write(static_cast<uint8_t>(sp != nullptr));
+    if (sp != nullptr) {
+      SnapshotTraits<ElementType>::save(*sp, writer);
+    }
+  }
+  static Result load(SP& sp, SnapshotReader& reader) {
+    uint8_t has_value{0};
+    if (!reader.read(has_value)) {
+      return Result::ERR_ILL_FORMED;
+    }
+    if (has_value == 0) {
+      sp.reset();
+      return Result::SUCCESS;
+    }
+    sp.reset(new ElementType());
+    return SnapshotTraits<ElementType>::load(*sp, reader);
+  }
+};  // struct SmartPointerSnapshot
+
+template <typename T>
+struct SnapshotTraits<std::unique_ptr<T>> : SmartPointerSnapshot<std::unique_ptr<T>> {
+};  // struct SnapshotTraits<std::unique_ptr<T>>
+template <typename T>
+struct SnapshotTraits<std::shared_ptr<T>> : SmartPointerSnapshot<std::shared_ptr<T>> {
+};  // struct SnapshotTraits<std::shared_ptr<T>>
+
+template <typename... Ts>
+struct SnapshotTraits<std::variant<Ts...>> {
+  static constexpr uint64_t fingerprint(uint64_t h, int depth) {
+    h = mixFingerprint(h, "variant");
+    ((h = SnapshotTraits<Ts>::fingerprint(h, depth)), ...);
+    return h;
+  }
+  static void save(const std::variant<Ts...>& value, SnapshotWriter& writer) {
+    writer.write(static_cast<uint32_t>(value.index()));
+    std::visit([&writer]<typename T>(const T& alternative) {
+      SnapshotTraits<T>::save(alternative, writer);
+    }, value);
+  }
+  static Result load(std::variant<Ts...>& value, SnapshotReader& reader) {
+    uint32_t index{0};
+    if (!reader.read(index) || index >= sizeof...(Ts)) {
+      return Result::ERR_ILL_FORMED;
+    }
+    return loadAlternative(value, reader, index, std::index_sequence_for<Ts...>{});
+  }
+private:
+  template <size_t... Is>
+  static Result loadAlternative(std::variant<Ts...>& value, SnapshotReader& reader, uint32_t index,
+      std::index_sequence<Is...>) {
+    Result res{Result::ERR_ILL_FORMED};
+    ((Is == index
+        && (res = SnapshotTraits<std::variant_alternative_t<Is, std::variant<Ts...>>>
+            ::load(value.template emplace<Is>(), reader), true)) || ...);
+    return res;
+  }
+};  // struct SnapshotTraits<std::variant<Ts...>>
+
+// 字段按定义顺序保存, 不保存字段名(字段名计入 schema 指纹)
+template <concepts::Reflected T>
+struct SnapshotTraits<T> {
+  static constexpr uint64_t fingerprint(uint64_t h, int depth) {
+    h = mixFingerprint(mixFingerprint(h, "struct"), T::_field_count_);
+    if (depth >= kMaxFingerprintDepth) {
+      return h;
+    }
+    return fingerprintFields(h, depth + 1, std::make_index_sequence<T::_field_count_>{});
+  }
+  static void save(const T& obj, SnapshotWriter& writer) {
+    forEachField(obj, [&writer](auto&& field_info) {
+      decltype(auto) value = field_info.value();
+      SnapshotTraits<std::remove_cvref_t<decltype(value)>>::save(value, writer);
+    });
+  }
+  static Result load(T& obj, SnapshotReader& reader) {
+    return forEachField(obj, [&reader](auto&& field_info) {
+      decltype(auto) value = field_info.value();
+      return SnapshotTraits<std::remove_cvref_t<decltype(value)>>::load(value, reader);
+    });
+  }
+private:
+  template <size_t... Is>
+  static constexpr uint64_t fingerprintFields(uint64_t h, int depth, std::index_sequence<Is...>) {
+    ((h = fingerprintField<Is>(h, depth)), ...);
+    return h;
+  }
+  template <size_t I>
+  static constexpr uint64_t fingerprintField(uint64_t h, int depth) {
+    using Field = typename T::template FIELD<T&, I>;
+    using Value = std::remove_cvref_t<decltype(std::declval<Field&>().value())>;
+    return SnapshotTraits<Value>::fingerprint(mixFingerprint(h, std::string_view(Field::name())), depth);
+  }
+};  // struct SnapshotTraits<T>
+
+}  // namespace detail
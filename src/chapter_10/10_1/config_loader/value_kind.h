@@ -0,0 +1,23 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/15 23:46:05
+# Desc   : 节点值的类型, 由后端的 getValueKind() 给出
+########################################################################
+*/
+#pragma once
+
+enum class ValueKind {
+  kNull,
+  kBool,
+  kInteger,  // 没有小数点和指数的数字
+  kReal,
+  kString,
+  kArray,
+  kObject,
+};
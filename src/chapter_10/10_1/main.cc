@@ -12,12 +12,64 @@
 */
 
 #include <print>
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstdlib>
+#include <filesystem>
+#include <iterator>
+#include <fstream>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
 
+#include "config_loader/config_cache.h"
+#include "config_loader/config_handle.h"
+#include "config_loader/columns.h"
+#include "config_loader/dumper.h"
+#include "config_loader/lazy.h"
+#include "config_loader/load_many.h"
 #include "config_loader/loader.h"
+#include "config_loader/ndjson_reader.h"
 #include "config_loader/result.h"
 #include "schema.h"
 
+// 统计 operator new 的调用次数, 检查原地构造和重新加载时没有多余的分配
+std::atomic<size_t> g_allocation_count{0};
+
+void* operator new(size_t size) {
+  g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc{};
+}
+// pmr 的默认资源使用带对齐参数的版本
+void* operator new(size_t size, std::align_val_t align) {
+  g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+  const auto alignment = static_cast<size_t>(align);
+  if (void* p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)) {
+    return p;
+  }
+  throw std::bad_alloc{};
+}
+// 不内联, 否则编译器在调用处看到 new 与 free 配对会误报 -Wmismatched-new-delete
+[[gnu::noinline]] void freeAllocation(void* p) noexcept {
+  std::free(p);
+}
+void operator delete(void* p) noexcept {
+  freeAllocation(p);
+}
+void operator delete(void* p, size_t) noexcept {
+  freeAllocation(p);
+}
+void operator delete(void* p, std::align_val_t) noexcept {
+  freeAllocation(p);
+}
+void operator delete(void* p, size_t, std::align_val_t) noexcept {
+  freeAllocation(p);
+}
+
 void run_point() {
   Point point;
   static_assert(4 == Point::_field_count_);
@@ -42,9 +94,10 @@ void run_point() {
     1. schema 中定义的类型一定是由 Primitive 类型组成的，而 concept_primitive.h 中调用了 getValueText() 导致
     原文件中primitive数据都变成了std::string, 将类型信息丢弃
     2. 对于 std::variant中的类型没有考虑优先级，只要转换成功就算
+    现在 json 后端提供了 getValueKind(), std::variant 按节点的类型选择备选类型, 2.4 匹配到 double
     */
-    assert(0 == point.other.index());
-    std::println("std::variant value: {}", std::get<std::string>(point.other));
+    assert(2 == point.other.index());
+    std::println("std::variant value: {}", std::get<double>(point.other));
   }
   {
     Point point;
@@ -73,17 +126,757 @@ void run_point() {
     TestTree test_tree;
     assert(Result::ERR_TYPE == loadJSON2Obj(test_tree, "../conf/test_tree2.json"));
   }
+  {
+    // json 的写法也是合法的 YAML(流式集合)
+    TestTree test_tree;
+    assert(Result::ERR_TYPE == loadYAML2Obj(test_tree, "../conf/test_tree2.json"));
+  }
   {
     TestTree test_tree;
-    assert(Result::ERR_UNSUPPORTED_PARSER == loadYAML2Obj(test_tree, "../conf/test_tree2.json"));
+    assert(Result::SUCCESS == loadYAML2Obj(test_tree, "../conf/test_tree.yaml"));
+    assert("root" == test_tree.name);
+    assert(3 == test_tree.children.size());
+    assert("mid_right" == test_tree.children[1]->children[1]->name);
+  }
+  {
+    Point point;
+    assert(Result::SUCCESS == loadXML2Obj(point, "../conf/point.xml"));
+    assert(1 == point.x);
+    assert(2 == point.y);
+    assert(std::nullopt == point.z);
+    assert(2 == point.other.index());
+  }
+  {
+    TestTree test_tree;
+    assert(Result::SUCCESS == loadXML2Obj(test_tree, "../conf/test_tree.xml"));
+    assert("root" == test_tree.name);
+    assert(3 == test_tree.children.size());
+    assert("mid_right" == test_tree.children[1]->children[1]->name);
+  }
+  {
+    Point point;
+    assert(Result::ERR_ILL_FORMED == loadXML2Obj(point, "../conf/point.json"));
   }
   //assert(Result::SUCCESS == 1);
   //assert(Result::ERR_ILL_FORMED == 2);
   //assert(Result::ERR_ILL_FORMED == 2);
 }
 
+// 不构建 DOM 的 json 解析器, 结果需要与 JsonCppParser 一致(point6.json 末尾多余的逗号除外)
+template <typename Parser>
+void run_json_parser() {
+  {
+    Point point;
+    assert(Result::SUCCESS == loadJSON2Obj<Parser>(point, "../conf/point.json"));
+    assert(1 == point.x);
+    assert(2 == point.y);
+    assert(std::nullopt == point.z);
+    assert(2 == point.other.index());
+  }
+  {
+    Point point;
+    assert(Result::ERR_ILL_FORMED == loadJSON2Obj<Parser>(point, "../conf/point3.json"));
+  }
+  {
+    Point point;
+    assert(Result::ERR_MISSING_FIELD == loadJSON2Obj<Parser>(point, "../conf/point4.json"));
+  }
+  {
+    Point point;
+    assert(Result::ERR_EXTRACTING_FIELD == loadJSON2Obj<Parser>(point, "../conf/point5.json"));
+  }
+  {
+    TestTree test_tree;
+    assert(Result::SUCCESS == loadJSON2Obj<Parser>(test_tree, "../conf/test_tree.json"));
+    assert("mid_right" == test_tree.children[1]->children[1]->name);
+  }
+  {
+    TestTree test_tree;
+    assert(Result::ERR_TYPE == loadJSON2Obj<Parser>(test_tree, "../conf/test_tree2.json"));
+  }
+  {
+    // 字符串中的控制字符必须转义
+    Point point;
+    assert(Result::ERR_ILL_FORMED
+        == loadJSON2Obj<Parser>(point, [] { return std::string("{\"x\": 1, \"y\": 2, \"other\": \"a\tb\"}"); }));
+  }
+  // 跳过的未知字段也做完整的语法检查, 与 JsonCppParser 一样认为是格式错误
+  for (auto unknown : {R"([1, 2})", R"([1 2 3])", R"({"a" 1})", R"([tru])", R"("a\qb")"}) {
+    Point point;
+    const std::string json = std::string(R"({"unknown": )") + unknown + R"(, "x": 1, "y": 2, "other": 1})";
+    auto content = [&json] { return json; };
+    assert(Result::ERR_ILL_FORMED == loadJSON2Obj<Parser>(point, content));
+    assert(Result::ERR_ILL_FORMED == loadJSON2Obj<detail::JsonCppParser>(point, content));
+  }
+  // key 和 value 中不合法的转义
+  for (auto json : {R"({"x": 1, "y": 2, "other": 1, "unk\q": 5})", R"({"x": 1, "y": 2, "other": "a\qb"})",
+                    R"({"x": 1, "y": 2, "other": "\ud800"})"}) {
+    Point point;
+    auto content = [json] { return std::string(json); };
+    assert(Result::ERR_ILL_FORMED == loadJSON2Obj<Parser>(point, content));
+    assert(Result::ERR_ILL_FORMED == loadJSON2Obj<detail::JsonCppParser>(point, content));
+  }
+  {
+    // 溢出的浮点数不能再按十六进制读成 0x1e400
+    Point point;
+    assert(Result::ERR_EXTRACTING_FIELD
+        == loadJSON2Obj<Parser>(point, [] { return std::string(R"({"x": 1e400, "y": 2, "other": 1})"); }));
+  }
+}
+
+DEFINE_SCHEMA(FloatValue, (float)f);
+
+// dumpObj2JSON 的输出可以重新加载
+void run_dump() {
+  {
+    Point point;
+    assert(Result::SUCCESS == loadJSON2Obj(point, "../conf/point.json"));
+    std::string json;
+    dumpObj2JSON(point, json);
+    Point reloaded;
+    assert(Result::SUCCESS == loadJSON2Obj(reloaded, [&json] { return json; }));
+    assert(point.x == reloaded.x && point.y == reloaded.y && point.z == reloaded.z);
+    assert(point.other == reloaded.other);
+  }
+  {
+    TestTree test_tree;
+    assert(Result::SUCCESS == loadJSON2Obj(test_tree, "../conf/test_tree.json"));
+    std::string json;
+    dumpObj2JSON(test_tree, json);
+    TestTree reloaded;
+    assert(Result::SUCCESS == loadJSON2Obj(reloaded, [&json] { return json; }));
+    assert("mid_right" == reloaded.children[1]->children[1]->name);
+    std::string json2;
+    dumpObj2JSON(reloaded, json2);
+    assert(json == json2);
+  }
+  {
+    // 整数值的 double 输出为 2.0, 重新加载后 variant 仍然是 double
+    Point point{.x = 1, .y = 2, .other = 2.0};
+    std::string json;
+    dumpObj2JSON(point, json);
+    assert(json.find(R"("other":2.0)") != std::string::npos);
+    Point reloaded;
+    assert(Result::SUCCESS == loadJSON2Obj(reloaded, [&json] { return json; }));
+    assert(2 == reloaded.other.index() && 2.0 == std::get<double>(reloaded.other));
+    assert(Result::SUCCESS == loadJSON2Obj<detail::JsonPullParser>(reloaded, [&json] { return json; }));
+    assert(2 == reloaded.other.index());
+  }
+  {
+    FloatValue value{.f = 0.1f};
+    std::string json;
+    dumpObj2JSON(value, json);
+    assert(R"({"f":0.1})" == json);
+  }
+}
+
+// dumpObj2MsgPack 的输出可以被 loadMsgPack2Obj 重新加载, 数值保持原来的类型
+void run_msgpack() {
+  {
+    Point point;
+    assert(Result::SUCCESS == loadJSON2Obj(point, "../conf/point.json"));
+    std::string msgpack;
+    dumpObj2MsgPack(point, msgpack);
+    Point reloaded;
+    assert(Result::SUCCESS == loadMsgPack2Obj(reloaded, [&msgpack] { return std::string_view(msgpack); }));
+    assert(point.x == reloaded.x && point.y == reloaded.y && point.z == reloaded.z);
+    assert(point.other == reloaded.other);
+  }
+  {
+    TestTree test_tree;
+    assert(Result::SUCCESS == loadJSON2Obj(test_tree, "../conf/test_tree.json"));
+    std::string msgpack;
+    dumpObj2MsgPack(test_tree, msgpack);
+    TestTree reloaded;
+    assert(Result::SUCCESS == loadMsgPack2Obj(reloaded, [&msgpack] { return std::string_view(msgpack); }));
+    assert("mid_right" == reloaded.children[1]->children[1]->name);
+    std::string msgpack2;
+    dumpObj2MsgPack(reloaded, msgpack2);
+    assert(msgpack == msgpack2);
+  }
+  {
+    Point point;
+    assert(Result::ERR_ILL_FORMED == loadMsgPack2Obj(point, [] { return std::string_view("\x82\xa1x", 3); }));
+  }
+}
+
+// 数值写成字符串时与原来的 stringstream 一样接受首尾空白和开头的 '+'
+void run_numeric_text() {
+  Point point;
+  assert(Result::SUCCESS == loadJSON2Obj(point, [] { return std::string(R"({"x": "+5", "y": " 2.5 ", "other": 1})"); }));
+  assert(5 == point.x && 2.5 == point.y);
+  assert(Result::ERR_EXTRACTING_FIELD
+      == loadJSON2Obj(point, [] { return std::string(R"({"x": "+-5", "y": 1, "other": 1})"); }));
+  // 浮点数只按十进制解析
+  for (auto json : {R"({"x": "1e400", "y": 1, "other": 1})", R"({"x": "ff", "y": 1, "other": 1})"}) {
+    assert(Result::ERR_EXTRACTING_FIELD == loadJSON2Obj(point, [json] { return std::string(json); }));
+  }
+}
+
+// 字段数不少于 member_walk_min_fields 的类型遍历成员反序列化, 其余的逐字段查找; 两种方式的错误码需要一致
+DEFINE_SCHEMA(Narrow, (int)f0, (std::optional<int>)f1);
+DEFINE_SCHEMA(Wide,
+  (int)f0, (std::optional<int>)f1, (std::optional<int>)f2, (std::optional<int>)f3,
+  (std::optional<int>)f4, (std::optional<int>)f5, (std::optional<int>)f6, (std::optional<int>)f7,
+  (std::optional<int>)f8, (std::optional<int>)f9, (std::optional<int>)f10, (std::optional<int>)f11,
+  (std::optional<int>)f12, (std::optional<int>)f13, (std::optional<int>)f14, (std::optional<int>)f15);
+DEFINE_SCHEMA(HasNarrow, (Narrow)s);
+DEFINE_SCHEMA(HasWide, (Wide)s);
+
+template <typename Parser>
+void run_field_dispatch() {
+  static_assert(Wide::_field_count_ >= detail::member_walk_min_fields<Wide>);
+  static_assert(Narrow::_field_count_ < detail::member_walk_min_fields<Narrow>);
+  HasNarrow narrow;
+  HasWide wide;
+  for (auto json : {R"({"s": 3})", R"({"s": [1]})", R"({"s": "x"})"}) {
+    auto content = [json] { return std::string(json); };
+    assert(Result::ERR_TYPE == loadJSON2Obj<Parser>(narrow, content));
+    assert(Result::ERR_TYPE == loadJSON2Obj<Parser>(wide, content));
+  }
+  auto missing = [] { return std::string(R"({"s": {"f1": 1}})"); };
+  assert(Result::ERR_MISSING_FIELD == loadJSON2Obj<Parser>(narrow, missing));
+  assert(Result::ERR_MISSING_FIELD == loadJSON2Obj<Parser>(wide, missing));
+  auto ok = [] { return std::string(R"({"s": {"f0": 1, "f15": 2}})"); };
+  assert(Result::SUCCESS == loadJSON2Obj<Parser>(wide, ok));
+  assert(1 == wide.s.f0 && 2 == wide.s.f15);
+  // 重复的 key 与字段数无关: jsoncpp 的 DOM 只保留最后一个, 其他后端取第一个
+  constexpr int expected = std::same_as<Parser, detail::JsonCppParser> ? 3 : 1;
+  auto duplicate = [] { return std::string(R"({"s": {"f0": 1, "f1": 2, "f0": 3}})"); };
+  assert(Result::SUCCESS == loadJSON2Obj<Parser>(narrow, duplicate));
+  assert(Result::SUCCESS == loadJSON2Obj<Parser>(wide, duplicate));
+  assert(expected == narrow.s.f0 && expected == wide.s.f0);
+  assert(2 == narrow.s.f1 && 2 == wide.s.f1);
+}
+
+// 默认 read() 读入内存, 只有显式指定阈值时才 mmap; read() 出错时抛出异常, 不当作文件结尾
+void run_file_content() {
+  assert(!detail::get_file_content("../conf/point.json").isMapped());
+  auto mapped = detail::get_file_content("../conf/point.json", 0);
+  assert(mapped.isMapped());
+  assert(mapped.view() == detail::get_file_content("../conf/point.json").view());
+  // 按路径加载时也可以指定阈值
+  Point point;
+  assert(Result::SUCCESS == loadJSON2Obj(point, "../conf/point.json", FileReadOptions{.mmap_min_size = 0}));
+  assert(1 == point.x && 2 == point.y);
+  assert(Result::SUCCESS == loadJSON2Obj<detail::JsonPullParser>(point, "../conf/point.json", FileReadOptions{}));
+  bool thrown{false};
+  try {
+    detail::get_file_content("../conf");  // 目录可以打开, read() 返回 EISDIR
+  } catch (const std::runtime_error&) {
+    thrown = true;
+  }
+  assert(thrown);
+}
+
+#if __cpp_lib_flat_map
+DEFINE_SCHEMA(FlatLimits, (std::flat_map<std::string, int>)limits);
+
+// 重复的 key 与 std::map 一样只取第一个, 后面的不反序列化; jsoncpp 的 DOM 只保留最后一个, 不在这里检查
+template <typename Parser>
+void run_flat_map() {
+  FlatLimits limits;
+  auto content = [] { return std::string(R"({"limits": {"b": 1, "a": 2, "b": "zz", "c": 3, "a": 4}})"); };
+  assert(Result::SUCCESS == loadJSON2Obj<Parser>(limits, content));
+  assert(3 == limits.limits.size() && 2 == limits.limits.at("a") && 1 == limits.limits.at("b"));
+  assert(std::ranges::is_sorted(limits.limits.keys()));
+}
+#endif
+
+DEFINE_SCHEMA(ReloadDoc,
+  (std::string)name,
+  (std::optional<int>)port,
+  (std::vector<Point>)points,
+  (std::vector<bool>)flags,
+  (std::map<std::string, int>)limits,
+  (std::unique_ptr<TestTree>)tree,
+  (std::shared_ptr<Point>)origin,
+  (std::variant<std::string, int, double>)mode);
+
+// 同一个对象依次加载不同的文档(原地覆盖), 结果与加载到新对象的一样; 没有出现的字段恢复为空
+template <typename Parser>
+void run_reload_in_place() {
+  const std::string docs[] = {
+    R"({"name": "a", "port": 80, "points": [{"x": 1, "y": 2, "other": 1}, {"x": 3, "y": 4, "z": 5, "other": "s"}],
+        "flags": [true, false, true], "limits": {"a": 1, "b": 2}, "tree": {"name": "t", "children": [{"name": "c"}]},
+        "origin": {"x": 0, "y": 0, "other": 1.5}, "mode": "fast"})",
+    R"({"name": "bb", "points": [{"x": 9, "y": 8, "other": 2.5}], "flags": [false],
+        "limits": {"b": 3, "c": 4}, "tree": {"name": "u"}, "mode": 3})",
+    R"({"name": "", "points": [{"x": 1, "y": 1, "other": 1}, {"x": 2, "y": 2, "other": 2}, {"x": 3, "y": 3, "z": 3, "other": 3}],
+        "port": 8080, "origin": {"x": 1, "y": 1, "other": "o"}, "mode": 1.5})",
+    R"({"name": "d", "mode": 2})",
+  };
+  ReloadDoc reused;
+  for (int round = 0; round < 2; ++round) {
+    for (const auto& doc : docs) {
+      auto content = [&doc] { return doc; };
+      ReloadDoc fresh;
+      assert(Result::SUCCESS == loadJSON2Obj<Parser>(fresh, content));
+      assert(Result::SUCCESS == loadJSON2Obj<Parser>(reused, content));
+      std::string fresh_json, reused_json;
+      dumpObj2JSON(fresh, fresh_json);
+      dumpObj2JSON(reused, reused_json);
+      assert(fresh_json == reused_json);
+    }
+  }
+  // 最后一个文档只有必选的字段, 其他字段都恢复为空
+  assert(std::nullopt == reused.port && reused.points.empty() && reused.flags.empty() && reused.limits.empty());
+  assert(nullptr == reused.tree && nullptr == reused.origin);
+}
+
+DEFINE_SCHEMA(SharedPoint, (std::shared_ptr<Point>)p);
+DEFINE_SCHEMA(UniquePoint, (std::unique_ptr<Point>)p);
+DEFINE_SCHEMA(PlainString, (std::string)s);
+DEFINE_SCHEMA(OptionalString, (std::optional<std::string>)s);
+DEFINE_SCHEMA(VariantString, (std::variant<int64_t, double, std::string>)s);
+DEFINE_SCHEMA(PointList, (std::vector<Point>)points);
+
+// JsonPullParser 解析本身不分配内存, 分配次数只来自反序列化的结果
+template <typename T>
+size_t countAllocations(T& obj, std::string_view json) {
+  const size_t before = g_allocation_count.load(std::memory_order_relaxed);
+  assert(Result::SUCCESS == loadJSON2Obj<detail::JsonPullParser>(obj, [json] { return json; }));
+  return g_allocation_count.load(std::memory_order_relaxed) - before;
+}
+
+void run_allocation_count() {
+  constexpr std::string_view point_json = R"({"p": {"x": 1, "y": 2, "other": 1}})";
+  // shared_ptr 的对象和控制块一次分配; 其他持有者可能还在读旧的对象, 每次都分配新的
+  SharedPoint shared;
+  assert(1 == countAllocations(shared, point_json));
+  assert(1 == countAllocations(shared, point_json));
+  // unique_ptr 重新加载时复用原来的对象
+  UniquePoint unique;
+  assert(1 == countAllocations(unique, point_json));
+  assert(0 == countAllocations(unique, point_json));
+
+  // 超出 SSO 的字符串: optional 和 variant 直接在自身的存储中构造, 与普通字段一样只分配字符串本身
+  constexpr std::string_view string_json = R"({"s": "a string that does not fit into the small string buffer"})";
+  PlainString plain;
+  OptionalString optional;
+  VariantString variant;
+  assert(1 == countAllocations(plain, string_json));
+  assert(1 == countAllocations(optional, string_json));
+  assert(1 == countAllocations(variant, string_json));
+  assert(2 == variant.s.index());
+  assert(0 == countAllocations(plain, string_json));
+  assert(0 == countAllocations(optional, string_json));
+  assert(0 == countAllocations(variant, string_json));
+
+  // 重新加载相同规模的数组: 元素和其中的字符串都原地覆盖, 不再分配
+  std::string points_json = R"({"points": [)";
+  for (int i = 0; i < 100; ++i) {
+    points_json += i == 0 ? "" : ", ";
+    points_json += R"({"x": 1, "y": 2, "other": "a string that does not fit into the small string buffer"})";
+  }
+  points_json += "]}";
+  PointList points;
+  assert(100 < countAllocations(points, points_json));
+  assert(0 == countAllocations(points, points_json));
+}
+
+DEFINE_SCHEMA(LazyPoint, (std::string)name, (Lazy<Point>)point);
+
+// 加载时只保存子文档的原始文本, 子文档的错误在第一次访问时由 result() 给出
+template <typename Parser>
+void run_lazy() {
+  LazyPoint lazy;
+  assert(Result::SUCCESS == loadJSON2Obj<Parser>(lazy, [] {
+    return std::string(R"({"name": "a", "point": {"x": "zzz", "y": 2, "other": 1}})");
+  }));
+  assert("a" == lazy.name && !lazy.point.parsed());
+  assert(Result::ERR_EXTRACTING_FIELD == lazy.point.result());
+  assert(lazy.point.parsed());
+
+  assert(Result::SUCCESS == loadJSON2Obj<Parser>(lazy, [] {
+    return std::string(R"({"name": "b", "point": {"y": 2, "other": 1}})");
+  }));
+  assert(Result::ERR_MISSING_FIELD == lazy.point.result());
+
+  assert(Result::SUCCESS == loadJSON2Obj<Parser>(lazy, [] {
+    return std::string(R"({"name": "c", "point": {"x": 1, "y": 2, "other": 1}})");
+  }));
+  assert(!lazy.point.parsed());
+  assert(Result::SUCCESS == lazy.point.result() && 1 == lazy.point->x);
+}
+
+// 配置写入临时文件, 析构时删除; 构造时删除上一次异常退出时留下的文件
+class TempFile {
+public:
+  explicit TempFile(std::string_view name)
+      : path_((std::filesystem::temp_directory_path() / name).string()) {
+    std::filesystem::remove(path_);
+  }
+  TempFile(const TempFile&) = delete;
+  TempFile& operator=(const TempFile&) = delete;
+  ~TempFile() {
+    std::filesystem::remove(path_);
+  }
+  void write(std::string_view content) const {
+    std::ofstream{path_, std::ios::binary | std::ios::trunc} << content;
+  }
+  const std::string& path() const {
+    return path_;
+  }
+private:
+  std::string path_;
+};  // class TempFile
+
+// 首次加载后版本为 1; 失败的 reload() 保留原来的快照; Reader 在新版本发布后拿到新的快照
+void run_config_handle() {
+  TempFile file{"config_loader_main_handle.json"};
+  ConfigHandle<Point> handle{file.path()};
+  assert(nullptr == handle.get() && 0 == handle.version());
+  assert(Result::ERR_READ_FILE == handle.reload());
+  assert(Result::ERR_READ_FILE == handle.lastReloadResult());
+  assert(nullptr == handle.get() && 0 == handle.version());
+
+  file.write(R"({"x": 1, "y": 2, "other": 1})");
+  assert(Result::SUCCESS == handle.reload());
+  assert(1 == handle.version() && Result::SUCCESS == handle.lastReloadResult());
+  auto reader = handle.reader();
+  assert(1 == reader.get().x);
+  const auto first = handle.get();
+
+  file.write(R"({"x": 3, "y": )");
+  assert(Result::ERR_ILL_FORMED == handle.reload());
+  assert(Result::ERR_ILL_FORMED == handle.lastReloadResult());
+  assert(1 == handle.version() && first == handle.get());
+  assert(1 == reader.get().x);
+
+  file.write(R"({"x": 5, "y": 6, "other": 1})");
+  assert(Result::SUCCESS == handle.reload());
+  assert(2 == handle.version() && Result::SUCCESS == handle.lastReloadResult());
+  assert(5 == reader.get().x && 6 == reader.get().y);
+  // 旧快照仍被持有, 不能原地覆盖
+  assert(1 == first->x);
+
+  // 后台线程在文件变化后重新加载
+  handle.watch();
+  file.write(R"({"x": 7, "y": 8, "other": 1})");
+  for (int i = 0; i < 500 && handle.version() < 3; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+  }
+  assert(3 == handle.version() && 7 == reader.get().x);
+}
+
+// 空行跳过, 最后一行可以没有换行符, 比缓冲区长的行扩大缓冲区; 出错时停在出错的那一行
+void run_ndjson() {
+  TempFile file{"config_loader_main_records.ndjson"};
+  const std::string long_name(100, 'n');
+  file.write("{\"name\": \"a\"}\n\n  \t\r\n{\"name\": \"" + long_name + "\"}\r\n{\"name\": \"c\"}");
+  {
+    // 缓冲区只有 8 字节, 每一行都比它长
+    NdjsonReader<TestTree> reader{file.path(), 8};
+    std::vector<std::string> names;
+    for (const TestTree& record : reader) {
+      names.push_back(record.name);
+    }
+    assert((std::vector<std::string>{"a", long_name, "c"}) == names);
+    assert(Result::SUCCESS == reader.status() && 5 == reader.lineNumber());
+  }
+
+  file.write("{\"name\": \"a\"}\n\n{\"name\": \"b\", \"children\": 5}\n{\"name\": \"d\"}\n");
+  {
+    NdjsonReader<TestTree> reader{file.path()};
+    size_t count{0};
+    for (const TestTree& record : reader) {
+      assert("a" == record.name);
+      ++count;
+    }
+    assert(1 == count);
+    assert(Result::ERR_TYPE == reader.status() && 3 == reader.lineNumber());
+    assert(!reader.next());
+  }
+  file.write("{\"name\": \"a\"}\n{\"name\": \n");
+  {
+    NdjsonReader<TestTree> reader{file.path()};
+    assert(reader.next() && !reader.next());
+    assert(Result::ERR_ILL_FORMED == reader.status() && 2 == reader.lineNumber());
+  }
+
+  {
+    NdjsonReader<TestTree> reader{"../conf/no_such_file.ndjson"};
+    assert(reader.begin() == reader.end());
+    assert(Result::ERR_READ_FILE == reader.status());
+  }
+  {
+    // 目录可以打开, read() 出错
+    NdjsonReader<TestTree> reader{"../conf"};
+    assert(!reader.next());
+    assert(Result::ERR_READ_FILE == reader.status());
+  }
+}
+
+DEFINE_SCHEMA(PointX, (double)x);
+
+// 命中时返回同一个对象; 类型、后端或文件标识不同时不命中; 超出容量时淘汰最久没有使用的条目
+void run_config_cache() {
+  TempFile file_a{"config_loader_main_cache_a.json"};
+  TempFile file_b{"config_loader_main_cache_b.json"};
+  TempFile file_c{"config_loader_main_cache_c.json"};
+  for (const auto* file : {&file_a, &file_b, &file_c}) {
+    file->write(R"({"x": 1, "y": 2, "other": 1})");
+  }
+  clearConfigCache();
+  std::shared_ptr<const Point> first, second;
+  assert(Result::SUCCESS == loadJSON2ObjCached(first, file_a.path()));
+  assert(Result::SUCCESS == loadJSON2ObjCached(second, file_a.path()));
+  assert(first == second && 1 == first->x);
+  assert(1 == configCacheStats().hits && 1 == configCacheStats().misses);
+
+  // 同一个文件, 不同的类型或后端
+  std::shared_ptr<const PointX> point_x;
+  assert(Result::SUCCESS == loadJSON2ObjCached(point_x, file_a.path()));
+  assert(Result::SUCCESS == loadJSON2ObjCached<detail::JsonPullParser>(second, file_a.path()));
+  assert(first != second);
+  assert(1 == configCacheStats().hits && 3 == configCacheStats().misses && 3 == configCacheStats().size);
+
+  // 修改时间变化
+  const auto mtime = std::filesystem::last_write_time(file_a.path());
+  std::filesystem::last_write_time(file_a.path(), mtime + std::chrono::seconds{1});
+  assert(Result::SUCCESS == loadJSON2ObjCached(second, file_a.path()));
+  assert(first != second && 4 == configCacheStats().misses);
+  first = second;
+  assert(Result::SUCCESS == loadJSON2ObjCached(second, file_a.path()));
+  assert(first == second);
+
+  assert(Result::ERR_READ_FILE == loadJSON2ObjCached(second, "../conf/no_such_file.json"));
+
+  // 容量为 2: a、b 之后访问 a, 再加载 c 时淘汰 b
+  clearConfigCache();
+  setConfigCacheCapacity(2);
+  std::shared_ptr<const Point> a, b, c, again;
+  assert(Result::SUCCESS == loadJSON2ObjCached(a, file_a.path()));
+  assert(Result::SUCCESS == loadJSON2ObjCached(b, file_b.path()));
+  assert(Result::SUCCESS == loadJSON2ObjCached(again, file_a.path()) && a == again);
+  assert(Result::SUCCESS == loadJSON2ObjCached(c, file_c.path()));
+  assert(1 == configCacheStats().evictions && 2 == configCacheStats().size);
+  assert(Result::SUCCESS == loadJSON2ObjCached(again, file_a.path()) && a == again);
+  assert(Result::SUCCESS == loadJSON2ObjCached(again, file_c.path()) && c == again);
+  assert(Result::SUCCESS == loadJSON2ObjCached(again, file_b.path()) && b != again);
+  // 被淘汰的对象仍然可以使用
+  assert(1 == b->x);
+
+  // 容量为 0 时不缓存
+  setConfigCacheCapacity(0);
+  assert(0 == configCacheStats().size);
+  assert(Result::SUCCESS == loadJSON2ObjCached(a, file_a.path()));
+  assert(Result::SUCCESS == loadJSON2ObjCached(again, file_a.path()));
+  assert(a != again && 0 == configCacheStats().size);
+
+  setConfigCacheCapacity(detail::ConfigCache::kDefaultCapacity);
+  clearConfigCache();
+}
+
+DEFINE_SCHEMA(InternedRecord, (InternedString)region, (std::optional<std::pmr::string>)owner);
+
+// loadMany 的任务在线程池中执行, 仍然使用调用线程设置的驻留表和 memory_resource
+void run_load_many() {
+  TempFile file_a{"config_loader_main_many_a.json"};
+  TempFile file_b{"config_loader_main_many_b.json"};
+  // 每个文件的解析要花一些时间, 否则调用线程会在线程池中的线程醒来之前做完所有的任务(单核时尤其如此)
+  const std::string padding(R"(, "padding": ")" + std::string(256 << 10, 'p') + "\"}");
+  file_a.write(R"({"region": "region-load-many-a", "owner": "an owner name longer than the sso buffer")" + padding);
+  file_b.write(R"({"region": "region-load-many-b", "owner": "another owner name longer than the sso buffer")" + padding);
+  constexpr size_t kRequestCount = 64;
+  auto make_requests = [&file_a, &file_b](std::vector<InternedRecord>& records) {
+    std::vector<LoadRequest<>> requests;
+    for (size_t i = 0; i < records.size(); ++i) {
+      requests.emplace_back(records[i], i % 2 == 0 ? file_a.path() : file_b.path());
+    }
+    return requests;
+  };
+  {
+    InternTable table;
+    ScopedInternTable scope{&table};
+    std::vector<InternedRecord> records(kRequestCount);
+    const auto results = loadMany(make_requests(records), 4);
+    assert(std::ranges::count(results, Result::SUCCESS) == kRequestCount);
+    assert(2 == table.stats().strings);
+    const InternedString a = table.intern("region-load-many-a");
+    for (size_t i = 0; i < kRequestCount; i += 2) {
+      assert(a.c_str() == records[i].region.c_str());
+    }
+  }
+  {
+    // optional 中的字符串在反序列化时才构造, 使用当时线程的 memory_resource
+    std::vector<InternedRecord> records(kRequestCount);
+    std::pmr::monotonic_buffer_resource resource;
+    ScopedMemoryResource scope{&resource};
+    const auto results = loadMany(make_requests(records), 4);
+    assert(std::ranges::count(results, Result::SUCCESS) == kRequestCount);
+    for (const auto& record : records) {
+      assert(&resource == record.owner->get_allocator().resource());
+    }
+    assert("another owner name longer than the sso buffer" == *records[1].owner);
+  }
+  std::vector<InternedRecord> records(1);
+  std::vector<LoadRequest<>> missing{{records[0], "../conf/no_such_file.json"}};
+  assert(Result::ERR_READ_FILE == loadMany(missing)[0]);
+}
+
+// 反序列化到负数时抛出异常
+struct ThrowingInt {
+  int value{0};
+};  // struct ThrowingInt
+
+namespace detail {
+template <>
+struct CompoundDeserializeTraits<ThrowingInt> {
+  static Result deserialize(ThrowingInt& obj, concepts::ParserElem auto node) {
+    CHECK_SUCCESS_OR_RETURN(CompoundDeserializeTraits<int>::deserialize(obj.value, node));
+    if (obj.value < 0) {
+      throw std::invalid_argument("negative value");
+    }
+    return Result::SUCCESS;
+  }
+};  // struct CompoundDeserializeTraits<ThrowingInt>
+}  // namespace detail
+
+// 并行反序列化时元素抛出的异常在所有段结束后传回调用线程; 与逐个反序列化一样, 下标更小的错误码或异常优先
+template <typename Parser>
+void run_parallel_exception() {
+  setParallelDeserializeOptions({.min_elements = 2, .max_threads = 4});
+  // 第 bad 个元素是 bad_value, 第 thrown 个元素抛出异常, 其余为 1
+  auto make_json = [](size_t bad, std::string_view bad_value, size_t thrown) {
+    std::string json{"["};
+    for (size_t i = 0; i < 1000; ++i) {
+      json += i == 0 ? "" : ", ";
+      json += i == bad ? bad_value : (i == thrown ? "-1" : "1");
+    }
+    return json + "]";
+  };
+  std::vector<ThrowingInt> values;
+  auto load = [&values](const std::string& json) {
+    return loadJSON2Obj<Parser>(values, [&json] { return json; });
+  };
+  auto throws = [&load](const std::string& json) {
+    try {
+      load(json);
+    } catch (const std::invalid_argument&) {
+      return true;
+    }
+    return false;
+  };
+  assert(throws(make_json(1000, "", 700)));
+  assert(throws(make_json(700, R"("x")", 100)));
+  assert(Result::ERR_EXTRACTING_FIELD == load(make_json(100, R"("x")", 700)));
+  // 之后的加载不受影响
+  assert(Result::SUCCESS == load(make_json(1000, "", 1000)));
+  assert(1000 == values.size() && 1 == values[999].value);
+  setParallelDeserializeOptions({});
+}
+
+// loadMany 只把读文件失败当作 ERR_READ_FILE, 反序列化抛出的异常在所有文件加载完之后抛给调用者
+void run_load_many_exception() {
+  TempFile file{"config_loader_main_many_throw.json"};
+  file.write("[1, -1, 1]");
+  Point missing, point;
+  std::vector<ThrowingInt> values;
+  std::vector<LoadRequest<>> requests{
+      {missing, "../conf/no_such_file.json"}, {values, file.path()}, {point, "../conf/point.json"}};
+  bool thrown{false};
+  try {
+    loadMany(requests, 2);
+  } catch (const std::invalid_argument&) {
+    thrown = true;
+  }
+  assert(thrown);
+  assert(1 == point.x && 2 == point.y);
+  requests.erase(requests.begin() + 1);
+  const auto results = loadMany(requests, 2);
+  assert(Result::ERR_READ_FILE == results[0] && Result::SUCCESS == results[1]);
+}
+
+DEFINE_SCHEMA(Flagged, (std::string)name, (bool)on, (std::optional<int>)n);
+
+// 同一个文档分别加载到 Columns<T> 和 std::vector<T>, 错误码和输出都相同
+template <typename Parser, typename T>
+void checkColumnsLikeVector(Columns<T>& columns, const std::string& json) {
+  std::vector<T> rows;
+  auto content = [&json] { return json; };
+  const Result res = loadJSON2Obj<Parser>(rows, content);
+  assert(res == loadJSON2Obj<Parser>(columns, content));
+  if (res == Result::SUCCESS) {
+    std::string rows_json, columns_json;
+    dumpObj2JSON(rows, rows_json);
+    dumpObj2JSON(columns, columns_json);
+    assert(rows_json == columns_json);
+  }
+}
+
+// Columns<T> 与 std::vector<T> 加载的结果相同; 重新加载时复用已有的行, 多余的行被删除
+template <typename Parser>
+void run_columns() {
+  static_assert(std::forward_iterator<decltype(std::declval<Columns<Point>&>().begin())>);
+  Columns<Point> points;
+  Columns<Flagged> flagged;
+  Columns<Wide> wide;  // 遍历成员反序列化
+  for (const std::string json : {
+           R"([{"x": 1, "y": 2, "other": 1}, {"x": 3, "y": 4, "z": 5, "other": "s"}, {"x": 5, "y": 6, "other": 1.5}])",
+           R"([{"x": 9, "y": 8, "other": 2.5}])", R"([])", R"([{"x": 1, "y": 2, "other": 1}, 3])",
+           R"([{"x": 1, "other": 1}])", R"({})"}) {
+    checkColumnsLikeVector<Parser>(points, json);
+  }
+  for (const std::string json : {R"([{"name": "a", "on": true, "n": 1}, {"name": "b", "on": false}])",
+                                 R"([{"name": "c", "on": "yes"}])", R"([[1]])"}) {
+    checkColumnsLikeVector<Parser>(flagged, json);
+  }
+  for (const std::string json : {R"([{"f0": 1, "f15": 2}, {"f3": 3, "f0": 4, "f0": 5}])", R"([{"f1": 1}])",
+                                 R"(["x"])"}) {
+    checkColumnsLikeVector<Parser>(wide, json);
+  }
+
+  auto three = [] { return std::string(R"([{"x": 1, "y": 2, "other": 1}, {"x": 3, "y": 4, "other": 2},
+                                           {"x": 5, "y": 6, "z": 7, "other": 3}])"); };
+  auto two = [] { return std::string(R"([{"x": 10, "y": 20, "other": 1}, {"x": 30, "y": 40, "other": "b"}])"); };
+  assert(Result::SUCCESS == loadJSON2Obj<Parser>(points, three));
+  assert(3 == points.size() && 7 == points[2].template get<"z">());
+  const double* xs = points.template column<"x">().data();
+  assert(Result::SUCCESS == loadJSON2Obj<Parser>(points, two));
+  assert(2 == points.size() && xs == points.template column<"x">().data());
+  assert(10 == points[0].template get<"x">() && 40 == points[1].template get<"y">());
+  assert(std::nullopt == points[0].template get<"z">() && std::nullopt == points[1].template get<"z">());
+  assert("b" == std::get<std::string>(points[1].template get<"other">()));
+  for (const auto& column_size : {points.template column<"y">().size(), points.template column<"z">().size(),
+                                  points.template column<"other">().size()}) {
+    assert(2 == column_size);
+  }
+}
+
 int main() {
   run_point();
+  run_numeric_text();
+  run_file_content();
+#if __cpp_lib_flat_map
+  run_flat_map<detail::JsonPullParser>();
+  run_flat_map<detail::JsonTapeParser>();
+#endif
+  run_field_dispatch<detail::JsonCppParser>();
+  run_field_dispatch<detail::JsonPullParser>();
+  run_field_dispatch<detail::JsonTapeParser>();
+  run_json_parser<detail::JsonPullParser>();
+  run_json_parser<detail::JsonTapeParser>();
+  run_dump();
+  run_config_handle();
+  run_ndjson();
+  run_config_cache();
+  run_load_many();
+  run_parallel_exception<detail::JsonCppParser>();
+  run_parallel_exception<detail::JsonTapeParser>();
+  run_load_many_exception();
+  run_reload_in_place<detail::JsonCppParser>();
+  run_reload_in_place<detail::JsonPullParser>();
+  run_reload_in_place<detail::JsonTapeParser>();
+  run_columns<detail::JsonCppParser>();
+  run_columns<detail::JsonPullParser>();
+  run_columns<detail::JsonTapeParser>();
+  run_allocation_count();
+  run_lazy<detail::JsonPullParser>();
+  run_lazy<detail::JsonTapeParser>();
+  run_lazy<detail::JsonCppParser>();
+  run_msgpack();
   return 0;
 }
 